@@ -1,13 +1,13 @@
 #include "bif.h"
 
 const char* mmAddrStr(mm_addr_type addr) {
-  static char buf[32];
+  BIF_STRBUF char buf[32];
   sprintf(buf, "0x%08" PRIx64, addr);
   return buf;
 }
 
 const char* to_bin(size_t const size, void const *const ptr, char *buf) {
-  static char static_buf[256];
+  BIF_STRBUF char static_buf[256];
   if (!buf)
     buf = static_buf;
   uint64_t v = *(uint64_t *)ptr;
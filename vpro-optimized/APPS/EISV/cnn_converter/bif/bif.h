@@ -25,6 +25,13 @@
 
 #define RF_DISCARD_ADDR (VPRO_CFG::RF_SIZE-1)
 
+// buffers of the to_char() helpers: per thread on the host (netgen generates layers concurrently), EISV is single-threaded
+#ifdef __riscv
+#define BIF_STRBUF static
+#else
+#define BIF_STRBUF static thread_local
+#endif
+
 typedef uint64_t mm_addr_type; // FIXME why 64?
 typedef uint32_t mm_size_type;
 typedef int16_t weight_t;
@@ -176,7 +183,7 @@ namespace BIF {
     int32_t value{};
 
     const char* to_char(const char *prefix = "") const {
-      static char buf[1024];
+      BIF_STRBUF char buf[1024];
       sprintf(buf, "%stop    %" PRId32 "" "%sleft   %" PRId32 "" "%sbottom %" PRId32 "" "%sright  %" PRId32 "" "%svalue  %" PRId32 "",
               prefix, top,
               prefix, left,
@@ -222,7 +229,7 @@ namespace BIF {
 //    uint8_t filler[6]{};    // to match 32-byte [6]
 
     const char* to_char() const {
-      static char buf[1024];
+      BIF_STRBUF char buf[1024];
 
 #if 0 // cluster IS NOT one-hot in general -> only useful notation is a binary bit mask
       // sometimes cluster is an index, sometimes a one-hot bit mask; no way to distinguish here
@@ -254,7 +261,7 @@ namespace BIF {
       return buf;
     }
     const char* unit_mask_to_char() const {
-      static char buf[32];
+      BIF_STRBUF char buf[32];
       sprintf(buf, "%d",
       		  unit_mask);
       return buf;
@@ -299,7 +306,7 @@ namespace BIF {
         COMMAND_SEGMENT_TYPE type{DMA_CMD};
 
         const char *to_char() const {
-            static char buf[1024];
+            BIF_STRBUF char buf[1024];
             sprintf(buf, " DMA LOOP, " "cluster_loop_len %d, " "cluster_loop_shift_incr %d, " "unit_loop_len %d, "
                          "unit_loop_shift_incr %d, " "inter_unit_loop_len %d, " "lm_incr 0x%04" PRIx32 ", " "mm_incr 0x%08" PRIx32 ", "
                          "dma_cmd_count %d",
@@ -384,7 +391,7 @@ namespace BIF {
     COMMAND_SEGMENT_TYPE type{COMMAND_SEGMENT_TYPE::VPRO_CMD};
 
     const char* to_char() const {
-      static char buf[1024];
+      BIF_STRBUF char buf[1024];
       if (
           command == VPRO_TYPE::maxpool2x2_fused ||
           command == VPRO_TYPE::activation_fused ||
@@ -454,7 +461,7 @@ struct  COMMAND_SCATTER {
   COMMAND_SEGMENT_TYPE type{COMMAND_SEGMENT_TYPE::SCATTER_CMD};
 
     const char* to_char() const {
-      static char buf[1024];
+      BIF_STRBUF char buf[1024];
       sprintf(buf, "index_shift %i, " "xmin_fixed %i, " "ymin_fixed %i"
               "mm_addr_coords %x" "mm_addr_features %x" "memcopy_size %i",
              index_shift, xmin_fixed, ymin_fixed, mm_addr_coords, mm_addr_features, memcopy_size);
@@ -509,7 +516,7 @@ struct  COMMAND_SCATTER {
     //    vpro: 20 x 8-bit
 
     const char* to_char() const {
-      static char buf[4096];
+      BIF_STRBUF char buf[4096];
       switch(type.type) {
       case COMMAND_SEGMENT_TYPE::DMA_CMD:
         if (dma.direction != loop)
@@ -553,7 +560,7 @@ struct  COMMAND_SCATTER {
     uint32_t channels{};
 
     const char* to_char(const char *prefix = "") const {
-      static char buf[1024];
+      BIF_STRBUF char buf[1024];
       sprintf(buf, "%smm_base  0x%08" PRIx32 "" "%sx        %10" PRId32 "" "%sy        %10" PRId32 "" "%sy_stride %10" PRId32 "" "%schannels %10" PRId32 "",
               prefix, mm_base,
               prefix, x,
@@ -643,7 +650,7 @@ struct  COMMAND_SCATTER {
     COMMAND_SEGMENT command_segments[];
 
     const char* to_char(bool legacy_compatibility = false) const {
-      static char buf[4096];
+      BIF_STRBUF char buf[4096];
       int offs = sprintf(buf,
               "in_channels             %d\n"
               "out_channels            %d\n"
@@ -182,7 +182,7 @@ namespace CNN_LAYER {
         assert(!(layercfg.use_dma_extension && layercfg.use_dma_interleaver) && "DMA extension and interleaving are not compatible with each other!");
         assert((layercfg.use_dma_extension || layercfg.use_dma_interleaver) && "DMA extension or interleaving must be active to generate correct dma cluster masks!");
 
-        printf("  [Segment Mapping | Unit Broadcasting] %lu Commands (double buffering: DMA/VPRO/Sync)\n", commands.size());
+        NETGEN_LOG::printf("  [Segment Mapping | Unit Broadcasting] %lu Commands (double buffering: DMA/VPRO/Sync)\n", commands.size());
 
         if (layercfg.use_dma_merger) {
             auto merger = DmaMerger(commands);
@@ -41,7 +41,12 @@ namespace CNN_LAYER {
     enum SEGMENTATION_STRATEGY {
         FAST_HEURISTIC, // computation of the heuristic is fast, but the resulting VPRO runtime execution may be slow
         DETAILED_HEURISTIC, // heuristic takes time to design the segmentation, faster VPRO execution
+        COST_MODEL, // search all supported segmentations for the lowest cycle count predicted by SegmentationCostModel
     };
+
+#ifndef SEGMENTATION_STRATEGY_DEFAULT
+#define SEGMENTATION_STRATEGY_DEFAULT DETAILED_HEURISTIC
+#endif
   
     // configure command generation
     struct LAYERCFG {
@@ -52,7 +57,7 @@ namespace CNN_LAYER {
         bool use_dma_loop_extension{true};
         bool use_dma_l2e_mix_extension{false};
         SEGMENT_SCHEDULING_ORDER scheduling_order{ITERATE_ALL_SORTED_OUTC};
-        SEGMENTATION_STRATEGY segmentation_strategy{DETAILED_HEURISTIC};
+        SEGMENTATION_STRATEGY segmentation_strategy{SEGMENTATION_STRATEGY_DEFAULT};
         bool force_segment_dump{false};
     };
 
@@ -122,6 +122,13 @@ void Layer::loadWeights(const std::string &path){
 
 // called by memory management
 void Layer::setOutputMMAddr(mm_addr_type base_addr) {
+    if (fused_into) {
+        // output is written by the fusing layer
+        assert(fused_into->out_dim.mm.layout_known && "fusing layer must be placed before the fused layer");
+        out_dim.mm = fused_into->out_dim.mm;
+        return;
+    }
+
     out_dim.mm.base = base_addr;
 
     // Set number of segments and their dimensions and main memory image of this layer's output
@@ -145,8 +152,20 @@ void Layer::setOutputMMAddr(mm_addr_type base_addr) {
     out_dim.mm.layout_known = true;
 }
 
+void Layer::relocateOutputMM(mm_addr_type base_addr) {
+    assert(out_dim.mm.layout_known && "relocateOutputMM moves an existing layout. Call setOutputMMAddr() first!");
+    // channel_base may be offset from base (pre-garbage, aliases) -> shift everything by the same distance
+    mm_addr_type old_base = out_dim.mm.base;
+    out_dim.mm.base = base_addr;
+    for (auto &cb: out_dim.mm.channel_base) {
+        cb = cb - old_base + base_addr;
+    }
+}
+
 // tell memory management how much output space is required (may be larger than actual payload data)
 mm_size_type Layer::getOutputMMSize() {
+    if (fused_into) // alias of the fusing layer's output
+        return 0;
     assert(out_dim.mm.layout_known && "getOutputSize relies on the size determined by calcOutputMemLayout(). Call setOutputMMAddr() first!");
     return out_dim.mm.size;
 }
@@ -195,12 +214,13 @@ void Layer::generateBifLayer(BIF::LAYER &bl) {
     bl.parallel_inchannels_per_lane = parallel_inchannels_per_lane;
 }
 
-std::vector<BIF::COMMAND_SEGMENT> &Layer::generateCommandSegments() {
+std::vector<BIF::COMMAND_SEGMENT> &Layer::generateCommandSegments(bool compress/*=true*/) {
     // fill commands vector
     //FIXME: this is done in generateCommands() -> refactor this
     generateSegments();
     generateCommands();
-    compressCommands();
+    if (compress)
+        compressCommands();
 
     return commands;
 }
@@ -264,6 +284,9 @@ std::string Layer::getLayerInfoText() {
     if (first_layer_producing_output)
         ss << "  First layer writing CNN output\n";
 
+    if (fused_into)
+        ss << "  Fused into " << fused_into->getFullName() << " (not executed, output written by fusing layer)\n";
+
     ss << "  src :";
     std::string sep {" "};
     for (auto sl: src_layers) {
@@ -14,6 +14,7 @@
 
 #include "misc.h"
 #include "bif.h"
+#include "netgen_log.h"
 #include "DMACommandExtensions/interleaver.h"
 #include "DMACommandExtensions/dma_block_extension.h"
 #include "command_helpers.h"
@@ -29,6 +30,7 @@
 //             Layer::computeOutputDim() // -> out_dim.(x|y)
 //             Layer::computeInputPadding() // -> padding.algo
 // 
+//     Net::generateLayerExecList()
 //     Net::designMmLayoutVpro()
 //         Layer::setOutputMMAddr() for layers
 //             Layer::setSegmentDimensions();
@@ -36,8 +38,9 @@
 //             Layer::computeDmaPadding() // padding.algo -> padding.dma
 //             Layer::setOutputMemDimensions() // -> out_dim.mm.(x|y)
 //             Layer::calcOutputMemLayout() // derive all other out_dim.mm.* fields from out_dim.mm.(x|y)
+//         Net::designMmLayoutReuse() // share output space of layers with disjoint live ranges
+//             Layer::relocateOutputMM() for layers
 // 
-//     Net::generateLayerExecList()
 //     Net::generateVproBlob() // weights
 //     Net::generateEisvBlob() // program
 //         Layer::generateCommandSegments() for layers
@@ -57,7 +60,7 @@
 //                     Layer::store() // DMA LM->MM
 //                         dataStore() for each lane
 //                 }
-//             Layer::compressCommands()
+//             Layer::compressCommands() // overlap_layers: after Net::overlapLayerBoundaries() moved first loads into the preceding layer
 //                 Layer::DmaMerger()
 //                 Layer::DmaBlockExtension()
 //                 Layer::DmaLoopExtension()
@@ -173,9 +176,21 @@ namespace CNN_LAYER {
     // called by memory management
     virtual void setOutputMMAddr(mm_addr_type base_addr);
 
+    // called by memory management after setOutputMMAddr(): move the output to another address, layout unchanged
+    virtual void relocateOutputMM(mm_addr_type base_addr);
+
     // tell memory management how much output space is required (may be larger than actual payload data)
     virtual mm_size_type getOutputMMSize();
 
+    // cross-layer fusion: compute consumer (only reader of this layer's output) within this layer's command segments
+    // return value: consumer can be fused; called by Net::fuseLayers(), which removes consumer from execution
+    virtual bool fuseConsumer(Layer *consumer) { return false; }
+
+    // true if the VPRO commands of a set of segments only access LM quarters written by the set's loads or read by its stores
+    // (double buffering of Layer::generateCommands(): inputs, kernels and bias in the lower, results in the upper quarter of a buffer)
+    // Net::overlapLayerBoundaries() then prefetches the next layer into other quarters while the last set computes
+    virtual bool vproLmFootprintFromDma() { return false; }
+
     // set quantized weights
     virtual void setWeights(std::vector<weight_t> &weights);
 
@@ -188,7 +203,8 @@ namespace CNN_LAYER {
     // return value: does this layer have a BIF::LAYER representation? Input layers do not.
     virtual void generateBifLayer(BIF::LAYER &bl);
 
-    std::vector<BIF::COMMAND_SEGMENT> &generateCommandSegments();
+    // compress = false: commands are compressed later by the caller (Net::overlapLayerBoundaries() works on uncompressed commands)
+    std::vector<BIF::COMMAND_SEGMENT> &generateCommandSegments(bool compress = true);
 
     // groups
     virtual int firstInputChannel(int x, int y, int out_ch, int src_idx = 0);
@@ -247,6 +263,7 @@ namespace CNN_LAYER {
 
     std::vector<SEGMENT *> segments; // flattened representation of [VPRO_CFG::CLUSTERS][VPRO_CFG::UNITS][VPRO_CFG::LANES]
     std::vector<BIF::COMMAND_SEGMENT> commands; // commands of this layer
+    std::string generation_log; // output captured while generating commands on a worker thread, printed by generateEisvBlob()
 
   // internal TODO: public?
   public:
@@ -255,6 +272,10 @@ namespace CNN_LAYER {
 
     bool produces_binary_data{true};
     bool is_input_layer{false};
+
+    // cross-layer fusion (Net::fuseLayers()): this layer is computed by fused_into together with fused_into's own output
+    // -> not executed, output is an alias of fused_into's output
+    Layer *fused_into{nullptr};
     bool use_dynamic_shape{false};
 
     // in the order of Net.layer_execlist
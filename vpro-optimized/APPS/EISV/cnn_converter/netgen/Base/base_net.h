@@ -8,6 +8,12 @@
 #include <iomanip>
 #include <vector>
 #include <list>
+#include <map>
+#include <set>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <functional>
 #include <math.h>
 #include <iostream>
 #include "base_layer.h"
@@ -56,12 +62,59 @@ namespace CNN_NET {
       }
     }
 
+    // Cross-layer fusion: a layer computes the only consumer of its output within its own command segments,
+    // the intermediate tensor stays in local memory instead of a store/load round trip through MM
+    // (currently Conv2D -> Add, see Conv2D::fuseConsumer())
+    // - the fused consumer is removed from layer_execlist, its output becomes an alias of the fusing layer's output
+    // - the consumer's other inputs must have been computed before the fusing layer is executed
+    // requires layer_execlist, must be called before designMmLayoutVpro()
+    virtual void fuseLayers() {
+      std::map<CNN_LAYER::Layer*, int> exec_pos;
+      for (unsigned int xli = 0; xli < layer_execlist.size(); xli++) {
+        exec_pos[layers[layer_execlist[xli]]] = xli;
+      }
+
+      int fused = 0;
+      for (auto layer: layers) {
+        auto it = exec_pos.find(layer);
+        if (it == exec_pos.end() || layer->fused_into || layer->out_is_result || layer->dest_layers.size() != 1)
+          continue;
+        CNN_LAYER::Layer *consumer = layer->dest_layers[0];
+        // a fused CNN result would not be written by a layer marked first_layer_producing_output
+        if (!exec_pos.count(consumer) || consumer->fused_into || consumer->out_is_result)
+          continue;
+
+        // other inputs are available when layer executes; CNN inputs excluded (host handshake: last_layer_using_input)
+        bool ready = true;
+        for (auto sl: consumer->src_layers) {
+          if (sl == layer)
+            continue;
+          auto sit = exec_pos.find(sl);
+          ready &= sit != exec_pos.end() && sit->second < it->second && !sl->is_transient_input_layer();
+        }
+        if (!ready || !layer->fuseConsumer(consumer))
+          continue;
+
+        consumer->fused_into = layer;
+        consumer->produces_binary_data = false;
+        std::cout << "Layer fusion: " << consumer->getFullName() << " computed by " << layer->getFullName() << "\n";
+        fused++;
+      }
+
+      if (fused) {
+        layer_execlist.erase(std::remove_if(layer_execlist.begin(), layer_execlist.end(),
+                                            [this](int li) { return layers[li]->fused_into != nullptr; }),
+                             layer_execlist.end());
+      }
+    }
+
     // MM static memory layout
     // weight addresses must be known before segment generation
     // segment addresses will be computed on the fly
+    // requires layer_execlist (live ranges of layer outputs)
     virtual void designMmLayoutVpro() {
       // layer output data (output of input-layer is the global cnn input)
-      // dumb linear allocation: each has its private output space
+      // first pass: dumb linear allocation, each has its private output space; determines size and layout of all outputs
       mm_addr_type mm_output_addr = memlayout_static.mm_output_base;
       for (auto layer: layers) {
         // std::cout << "designMmLayoutVpro: " << layer->getFullName() << " " << layer << " .setOutputMMAddr(" << mmAddrStr(mm_output_addr) << ")\n";
@@ -69,20 +122,18 @@ namespace CNN_NET {
         layer->setOutputMMAddr(mm_output_addr); // one addr per src layer
         mm_output_addr += layer->getOutputMMSize();
       }
-      /* Ideas for space-saving memory allocation:
-         - full-blown register allocation and graph coloring approaches are probably unnecessarily complicated
-
-         - algo: three passes over all layers to keep I/O spaces together tight
-           - allocate all inputs
-           - allocate all outputs
-           - allocate buckets for all intermediate layers
-             - re-use buckets no longer required
-             - if all buckets are currently used, allocate a new bucket
-             - bucket tracks:
-               - layers using its content as input (empty list -> bucket can be re-used)
-               - maximum output size of any layer writing into this bucket
-             - input and output layers always have private spaces (overwritten/read in parallel by ARM)
-      */
+
+      // second pass: layers share space if their outputs are not live at the same time
+      // decoupled execution preloads all layer outputs -> everything stays private
+      // per-layer dumps read every output after the CNN has finished -> nothing may be overwritten
+      mm_shared_outputs.clear();
+      if (reuse_output_mm && dump_layer_outputs) {
+        std::cout << "Layer output space re-use disabled: dump_layer_outputs requested\n";
+      }
+      if (reuse_output_mm && !run_layers_decoupled && !dump_layer_outputs) {
+        mm_output_addr = designMmLayoutReuse();
+      }
+      checkMmLayoutLive();
 
       // absolute weight addresses will be stored in command segments -> weight addresses must be known before segment generation
       // uncached .vpro data segment
@@ -104,6 +155,417 @@ namespace CNN_NET {
       assert((mm_output_addr <= 0xC0000000 && mm_weights_addr <= 0xC0000000) && "ISS DMA maps addresses >= 0x40000000 to host mem (as of 2022-11-23)");
     }
 
+    // layers without own output space which point into their input's space (Reshape, SliceChannel) or are computed by a fusing layer
+    static bool isAliasLayer(CNN_LAYER::Layer *layer) {
+      return !layer->produces_binary_data && !layer->getOutputMMSize() && !layer->src_layers.empty();
+    }
+
+    // layer whose output space an alias layer points into
+    static CNN_LAYER::Layer *aliasSource(CNN_LAYER::Layer *layer) {
+      return layer->fused_into ? layer->fused_into : layer->src_layers[0];
+    }
+
+    // extend [first, last] (positions in layer_execlist) by all executed layers reading the output of layer, directly or via alias layers
+    // returns true if the output is a CNN result, directly or via alias layers
+    bool getOutputLiveRange(CNN_LAYER::Layer *layer, const std::map<CNN_LAYER::Layer*, int> &exec_pos, int &first, int &last) {
+      bool is_result = layer->out_is_result;
+      for (auto dl: layer->dest_layers) {
+        if (dl->fused_into && dl->fused_into != layer) {
+          dl = dl->fused_into; // other input of a fused layer: read by the fusing layer
+        } else if (isAliasLayer(dl)) {
+          is_result |= getOutputLiveRange(dl, exec_pos, first, last);
+          continue;
+        }
+        auto it = exec_pos.find(dl);
+        if (it != exec_pos.end()) {
+          first = std::min(first, it->second);
+          last = std::max(last, it->second);
+        }
+      }
+      return is_result;
+    }
+
+    // Bucket-based re-use of layer output space, called by designMmLayoutVpro() after linear allocation
+    // - live range of a layer output: from its execution until the last execution of a layer reading it (positions in layer_execlist)
+    // - input and output layers always have private spaces (overwritten/read in parallel by ARM), as have layers not in layer_execlist
+    // - all other layers are assigned to buckets in order of their live range start:
+    //   - a bucket is free once all layers using its content as input have been executed
+    //   - re-use the smallest free bucket large enough, else grow the largest free bucket, else allocate a new bucket
+    //   - bucket size: maximum output size of any layer writing into this bucket
+    // - memory layout: private spaces first (keeps I/O spaces together tight), then buckets
+    // returns the end address of the layer outputs region
+    virtual mm_addr_type designMmLayoutReuse() {
+      std::map<CNN_LAYER::Layer*, int> exec_pos;
+      for (unsigned int xli = 0; xli < layer_execlist.size(); xli++) {
+        exec_pos[layers[layer_execlist[xli]]] = xli;
+      }
+
+      struct LiveRange {
+        CNN_LAYER::Layer *layer;
+        int first;
+        int last;
+      };
+      std::vector<CNN_LAYER::Layer*> private_layers;
+      std::vector<LiveRange> shared_layers;
+      mm_size_type linear_size = 0;
+      for (auto layer: layers) {
+        mm_size_type size = layer->getOutputMMSize();
+        if (!size) // alias layers are moved together with their source
+          continue;
+        linear_size = align(linear_size, 16) + size;
+        auto it = exec_pos.find(layer);
+        if (layer->is_input_layer || it == exec_pos.end()) {
+          private_layers.push_back(layer);
+          continue;
+        }
+        LiveRange lr{layer, it->second, it->second};
+        if (getOutputLiveRange(layer, exec_pos, lr.first, lr.last)) {
+          private_layers.push_back(layer);
+          continue;
+        }
+        shared_layers.push_back(lr);
+      }
+      std::stable_sort(shared_layers.begin(), shared_layers.end(), [](const LiveRange &a, const LiveRange &b) { return a.first < b.first; });
+
+      struct Bucket {
+        mm_size_type size;
+        int last; // execlist position of last read of current content
+        mm_addr_type base;
+      };
+      std::vector<Bucket> buckets;
+      std::vector<unsigned int> bucket_of(shared_layers.size());
+      for (unsigned int i = 0; i < shared_layers.size(); i++) {
+        const LiveRange &lr = shared_layers[i];
+        mm_size_type size = align(lr.layer->getOutputMMSize(), 16);
+        int best = -1;
+        for (unsigned int b = 0; b < buckets.size(); b++) {
+          if (buckets[b].last >= lr.first) // still in use
+            continue;
+          if (best < 0) {
+            best = b;
+            continue;
+          }
+          bool fits = buckets[b].size >= size;
+          bool best_fits = buckets[best].size >= size;
+          if ((fits && (!best_fits || buckets[b].size < buckets[best].size)) ||
+              (!fits && !best_fits && buckets[b].size > buckets[best].size)) {
+            best = b;
+          }
+        }
+        if (best < 0) {
+          best = buckets.size();
+          buckets.push_back({0, 0, 0});
+        }
+        buckets[best].size = std::max(buckets[best].size, size);
+        buckets[best].last = lr.last;
+        bucket_of[i] = best;
+      }
+
+      // final addresses
+      std::map<CNN_LAYER::Layer*, mm_addr_type> new_base;
+      mm_addr_type addr = memlayout_static.mm_output_base;
+      mm_size_type private_size = 0;
+      for (auto layer: private_layers) {
+        addr = align(addr, 16);
+        new_base[layer] = addr;
+        addr += layer->getOutputMMSize();
+      }
+      private_size = addr - memlayout_static.mm_output_base;
+      for (auto &b: buckets) {
+        addr = align(addr, 16);
+        b.base = addr;
+        addr += b.size;
+      }
+      for (unsigned int i = 0; i < shared_layers.size(); i++) {
+        new_base[shared_layers[i].layer] = buckets[bucket_of[i]].base;
+        mm_shared_outputs.insert(shared_layers[i].layer);
+      }
+
+      // relocate in instantiation order: alias layers follow their (already relocated) source
+      std::map<CNN_LAYER::Layer*, mm_addr_type> shift;
+      for (auto layer: layers) {
+        mm_addr_type s = 0;
+        auto it = new_base.find(layer);
+        if (it != new_base.end()) {
+          s = it->second - layer->out_dim.mm.base;
+        } else if (isAliasLayer(layer)) {
+          s = shift[aliasSource(layer)];
+          if (mm_shared_outputs.count(aliasSource(layer)))
+            mm_shared_outputs.insert(layer);
+        }
+        shift[layer] = s;
+        if (s)
+          layer->relocateOutputMM(layer->out_dim.mm.base + s);
+      }
+
+      // peak amount of simultaneously live output data (lower bound for any allocation)
+      mm_size_type peak_live = 0;
+      for (unsigned int xli = 0; xli < layer_execlist.size(); xli++) {
+        mm_size_type live = private_size;
+        for (auto &lr: shared_layers) {
+          if (lr.first <= (int)xli && (int)xli <= lr.last)
+            live += align(lr.layer->getOutputMMSize(), 16);
+        }
+        peak_live = std::max(peak_live, live);
+      }
+
+      std::cout << "Layer output space re-use: " << private_layers.size() << " private (" << private_size << " byte), "
+                << shared_layers.size() << " shared in " << buckets.size() << " buckets (" << (addr - memlayout_static.mm_output_base - private_size) << " byte)\n";
+      std::cout << "  " << std::setw(10) << (addr - memlayout_static.mm_output_base) << " byte allocated, "
+                << std::setw(10) << peak_live << " byte peak live, "
+                << std::setw(10) << linear_size << " byte total (private allocation)\n";
+
+      return addr;
+    }
+
+    // layout check: outputs which are live at the same time (positions in layer_execlist) must not share MM
+    // private outputs (CNN inputs and results, layers not in layer_execlist) are live during the whole execution
+    void checkMmLayoutLive() {
+      std::map<CNN_LAYER::Layer*, int> exec_pos;
+      for (unsigned int xli = 0; xli < layer_execlist.size(); xli++) {
+        exec_pos[layers[layer_execlist[xli]]] = xli;
+      }
+
+      struct LiveOutput {
+        CNN_LAYER::Layer *layer;
+        int first;
+        int last;
+      };
+      std::vector<LiveOutput> outputs;
+      for (auto layer: layers) {
+        if (!layer->getOutputMMSize()) // alias layers: checked as part of their source
+          continue;
+        LiveOutput lo{layer, INT_MIN, INT_MAX};
+        auto it = exec_pos.find(layer);
+        if (!layer->is_input_layer && it != exec_pos.end()) {
+          lo.first = lo.last = it->second;
+          if (getOutputLiveRange(layer, exec_pos, lo.first, lo.last)) {
+            lo.first = INT_MIN;
+            lo.last = INT_MAX;
+          }
+        }
+        outputs.push_back(lo);
+      }
+
+      for (unsigned int i = 0; i < outputs.size(); i++) {
+        for (unsigned int j = i + 1; j < outputs.size(); j++) {
+          const LiveOutput &a = outputs[i];
+          const LiveOutput &b = outputs[j];
+          if (a.last < b.first || b.last < a.first)
+            continue;
+          mm_addr_type a_base = a.layer->out_dim.mm.base;
+          mm_addr_type b_base = b.layer->out_dim.mm.base;
+          if (a_base + a.layer->getOutputMMSize() <= b_base || b_base + b.layer->getOutputMMSize() <= a_base)
+            continue;
+          std::cout << "Static memory layout failed: live outputs of " << a.layer->getFullName() << " (" << mmAddrStr(a_base) << ") and "
+                    << b.layer->getFullName() << " (" << mmAddrStr(b_base) << ") overlap\n";
+          exit(1);
+        }
+      }
+    }
+
+    // Overlap of layer boundaries: the first loads of a layer (everything before its first DMA wait: kernels, bias and
+    // the first input tiles) are issued by the preceding layer in execution order while its last segments compute and
+    // store, instead of after the full sync at the end of that layer
+    // a load is moved if it does not depend on the preceding layer:
+    // - its MM source is not written by the preceding layer (bounding range of all its stores)
+    // - its LM destination is not accessed by commands of the preceding layer still in flight
+    // - it is not padded, unless both layers use the same DMA pad widths (configured per layer by the runtime)
+    // placement in the preceding layer (commands end with compute(last), sync, store(last), sync):
+    // - before the sync after the last compute, if the LM footprint of the last set's VPRO commands is known
+    //   (Layer::vproLmFootprintFromDma()): overlaps the last compute and the last but one store
+    // - otherwise before the final sync: overlaps the last store
+    // the initial DMA wait of a layer is removed if all of its first loads moved
+    // works on uncompressed commands (before Layer::compressCommands())
+    virtual void overlapLayerBoundaries() {
+      const uint32_t lm_quarter = VPRO_CFG::LM_SIZE / 4;
+
+      auto isLoad = [](const BIF::COMMAND_SEGMENT &c) {
+        return c.type.type == DMA_CMD && (c.dma.direction == e2l1D || c.dma.direction == e2l2D);
+      };
+      auto isStore = [](const BIF::COMMAND_SEGMENT &c) {
+        return c.type.type == DMA_CMD && (c.dma.direction == l2e1D || c.dma.direction == l2e2D);
+      };
+      auto lmEnd = [](const BIF::COMMAND_DMA &d) { return d.lm_addr + uint32_t(d.x_size) * d.y_size; };
+      // upper bound: row distance in MM is at most x_size + y_leap elements
+      auto mmEnd = [](const BIF::COMMAND_DMA &d) { return uint64_t(d.mm_addr) + uint64_t(2) * d.y_size * (d.x_size + d.y_leap); };
+      auto lmOverlap = [&lmEnd](const BIF::COMMAND_DMA &a, const BIF::COMMAND_DMA &b) {
+        return a.cluster == b.cluster && (a.unit_mask & b.unit_mask) && a.lm_addr < lmEnd(b) && b.lm_addr < lmEnd(a);
+      };
+      auto quarters = [lm_quarter, &lmEnd](const BIF::COMMAND_DMA &d) {
+        uint32_t mask = 0;
+        for (uint32_t q = d.lm_addr / lm_quarter; q <= (lmEnd(d) - 1) / lm_quarter; q++)
+          mask |= 1u << q;
+        return mask;
+      };
+      // runtime executes these layer types differently (calcLayer())
+      auto generic = [](CNN_LAYER::Layer *l) {
+        LAYERTYPE t = l->getLayerType();
+        return t != LAYERTYPE::DYNAMIC_AXIS && t != LAYERTYPE::SCATTER_TO_GRID && t != LAYERTYPE::POINTPILLARS;
+      };
+
+      int total_loads = 0, moved_early = 0, moved_late = 0, removed_waits = 0;
+      for (unsigned int xli = 1; xli < layer_execlist.size(); xli++) {
+        CNN_LAYER::Layer *prev = layers[layer_execlist[xli-1]];
+        CNN_LAYER::Layer *next = layers[layer_execlist[xli]];
+        std::vector<BIF::COMMAND_SEGMENT> &pc = prev->commands;
+        std::vector<BIF::COMMAND_SEGMENT> &nc = next->commands;
+        if (!generic(prev) || !generic(next) || pc.empty() || nc.empty())
+          continue;
+
+        // first loads of next: all commands before the first DMA wait
+        unsigned int wait = 0;
+        while (wait < nc.size() && isLoad(nc[wait]))
+          wait++;
+        if (wait == 0 || wait == nc.size() || nc[wait].type.type != DMA_WAIT)
+          continue;
+        total_loads += wait;
+
+        // tail of prev: ... sync (s1) [store(last-1), compute(last)] sync (s2) [store(last)] sync (end)
+        int end = (int)pc.size() - 1;
+        if (pc[end].type.type != BOTH_SYNC)
+          continue;
+        int s2 = end - 1;
+        while (s2 >= 0 && pc[s2].type.type != BOTH_SYNC)
+          s2--;
+        if (s2 < 0 || !std::all_of(pc.begin() + s2 + 1, pc.begin() + end, isStore))
+          continue;
+
+        // MM written by prev, DMA padding state at the end of prev
+        uint64_t mm_lo = UINT64_MAX, mm_hi = 0;
+        bool pad_changed = false;
+        for (auto &c: pc) {
+          if (isStore(c)) {
+            mm_lo = std::min(mm_lo, uint64_t(c.dma.mm_addr));
+            mm_hi = std::max(mm_hi, mmEnd(c.dma));
+          }
+          pad_changed |= c.type.type == DMA_SET_PADDING;
+        }
+        const BIF::PAD_REDUCED &pp = prev->padding.dma, &np = next->padding.dma;
+        bool same_pad = !pad_changed && pp.top == np.top && pp.left == np.left && pp.bottom == np.bottom && pp.right == np.right && pp.value == np.value;
+
+        // early placement: LM quarters of the last set (its loads before s1, its stores after s2) are busy in all units
+        int s1 = -1;
+        uint32_t busy_quarters = 0;
+        if (prev->vproLmFootprintFromDma()) {
+          s1 = s2 - 1;
+          while (s1 >= 0 && pc[s1].type.type != BOTH_SYNC && pc[s1].type.type != DMA_WAIT)
+            s1--;
+          bool tail_ok = s1 >= 0;
+          for (int i = s1 + 1; tail_ok && i < s2; i++)
+            tail_ok = isStore(pc[i]) || pc[i].type.type == VPRO_CMD;
+          uint32_t load_quarters = 0, store_quarters = 0;
+          for (int i = s1 - 1; tail_ok && i >= 0 && pc[i].type.type != BOTH_SYNC && pc[i].type.type != DMA_WAIT; i--) {
+            if (isLoad(pc[i]))
+              load_quarters |= quarters(pc[i].dma);
+          }
+          for (int i = s2 + 1; i < end; i++)
+            store_quarters |= quarters(pc[i].dma);
+          if (!tail_ok || !load_quarters || !store_quarters)
+            s1 = -1;
+          busy_quarters = load_quarters | store_quarters;
+        }
+
+        std::vector<BIF::COMMAND_SEGMENT> early, late, kept;
+        for (unsigned int i = 0; i < wait; i++) {
+          const BIF::COMMAND_DMA &d = nc[i].dma;
+          bool independent = (d.padding == 0 || same_pad) && (mmEnd(d) <= mm_lo || d.mm_addr >= mm_hi);
+          auto free = [&](int from) {
+            for (int j = from + 1; j < end; j++) {
+              if (pc[j].type.type == DMA_CMD && lmOverlap(d, pc[j].dma))
+                return false;
+            }
+            return true;
+          };
+          if (independent && s1 >= 0 && !(quarters(d) & busy_quarters) && free(s1)) {
+            early.push_back(nc[i]);
+          } else if (independent && free(s2)) {
+            late.push_back(nc[i]);
+          } else {
+            kept.push_back(nc[i]);
+          }
+        }
+        if (early.empty() && late.empty())
+          continue;
+
+        pc.insert(pc.begin() + end, late.begin(), late.end());
+        pc.insert(pc.begin() + s2, early.begin(), early.end());
+        unsigned int moved = early.size() + late.size();
+        prev->cmd_cnt.dma += moved;
+        next->cmd_cnt.dma -= moved;
+        if (kept.empty()) {
+          wait++; // initial DMA wait not required any more, prev ends with a full sync
+          next->cmd_cnt.sync--;
+          removed_waits++;
+        }
+        nc.erase(nc.begin(), nc.begin() + wait);
+        nc.insert(nc.begin(), kept.begin(), kept.end());
+
+        moved_early += early.size();
+        moved_late += late.size();
+        std::cout << "Layer boundary overlap: " << moved << "/" << (moved + kept.size()) << " first loads of " << next->getFullName()
+                  << " issued by " << prev->getFullName() << " (" << early.size() << " with last compute, " << late.size() << " with last store)\n";
+      }
+      std::cout << "Layer boundary overlap: " << (moved_early + moved_late) << " of " << total_loads << " first loads moved ("
+                << moved_early << " with last compute, " << moved_late << " with last store), " << removed_waits << " initial DMA waits removed\n";
+    }
+
+    // apply fn to all layers producing binary data on netgen_threads worker threads (in layer order if single-threaded)
+    // layers are independent once MM addresses are fixed (designMmLayoutVpro()); each worker picks the next unprocessed layer
+    // the segmentation search and its cache file are done sequentially in designMmLayoutVpro(), never on the workers
+    // output of fn is captured per layer (NETGEN_LOG) and printed in layer order by generateEisvBlob() -> same log for any thread count
+    virtual void forEachLayerParallel(const std::function<void(CNN_LAYER::Layer*)> &fn, const std::string &what) {
+      std::vector<CNN_LAYER::Layer*> todo;
+      for (auto layer: layers) {
+        if (layer->produces_binary_data)
+          todo.push_back(layer);
+      }
+
+      auto run = [&todo, &fn](unsigned int i) {
+        std::ostringstream log;
+        NETGEN_LOG::capture = &log;
+        fn(todo[i]);
+        NETGEN_LOG::capture = nullptr;
+        todo[i]->generation_log += log.str();
+      };
+
+      unsigned int nthreads = netgen_threads ? netgen_threads : std::max(1u, std::thread::hardware_concurrency());
+      nthreads = std::min(nthreads, (unsigned int)todo.size());
+      if (nthreads <= 1) {
+        for (unsigned int i = 0; i < todo.size(); i++) {
+          run(i);
+        }
+        return;
+      }
+
+      std::cout << "-- " << what << " for " << todo.size() << " layers on " << nthreads << " threads\n";
+      std::atomic<unsigned int> next{0};
+      std::vector<std::thread> workers;
+      for (unsigned int t = 0; t < nthreads; t++) {
+        workers.emplace_back([&todo, &next, &run]() {
+          for (unsigned int i = next++; i < todo.size(); i = next++) {
+            run(i);
+          }
+        });
+      }
+      for (auto &w: workers) {
+        w.join();
+      }
+    }
+
+    // generate command segments of all layers producing binary data (concurrently, see forEachLayerParallel())
+    // results stay in Layer::commands, the EISV blob is assembled in layer order afterwards -> deterministic blob
+    // layer boundary overlap: commands of all layers are generated uncompressed, then overlapped and compressed
+    virtual void generateCommandSegmentsParallel() {
+      bool overlap = overlap_layers && !run_layers_decoupled;
+      forEachLayerParallel([overlap](CNN_LAYER::Layer *l) { l->generateCommandSegments(!overlap); }, "generating commands");
+      if (!overlap)
+        return;
+
+      overlapLayerBoundaries();
+      forEachLayerParallel([](CNN_LAYER::Layer *l) { l->compressCommands(); }, "compressing commands");
+    }
+
     virtual Blob* generateEisvBlob() {
       /*
         EISV blob memory layout                                size
@@ -125,6 +587,9 @@ namespace CNN_NET {
       assert((layer_exec_count > 0) && "layer_execlist is empty");
       std::vector<uint32_t> log_idx_to_bin_idx(layers.size()); // some frontend layers[] are not in EISV blob -> different indexing
       
+      // == generate command segments of all layers (concurrently if configured)
+      generateCommandSegmentsParallel();
+
       // == generate list of BIF::LAYER blobs for all layers
       std::vector<Blob*> layer_blobs; // each element encapsulates the variable-size BIF::LAYER of one layer
 
@@ -134,7 +599,8 @@ namespace CNN_NET {
           continue;
 
         std::cout << "== Layer " << layers[li]->getFullName() << "\n";
-        std::vector<BIF::COMMAND_SEGMENT> &layer_cmd_segs = layers[li]->generateCommandSegments();
+        std::cout << layers[li]->generation_log;
+        std::vector<BIF::COMMAND_SEGMENT> &layer_cmd_segs = layers[li]->commands;
         std::cout << std::setw(8) << layers[li]->segments.size() << " segments -> "
                   << std::setw(6) << layer_cmd_segs.size() << " commands";
 
@@ -304,6 +770,11 @@ namespace CNN_NET {
       // layer descriptor parsed by iolib
       fd << "# Layer " << l->getFullName() << ": " << l->getIoStr(false, true) << l->out_dim.detailStr() << "\n";
 
+      // derived nets may request dumps of intermediate layers: their space is overwritten before the dump
+      if (!in && mm_shared_outputs.count(l) && getSimOutputActiveLayer(*l)) {
+        std::cout << "!! WARNING Dump of " << l->getFullName() << " requested, but its output space is re-used by later layers. Set reuse_output_mm = false or dump_layer_outputs = true\n";
+      }
+
       // iolib's file input provider: control whether a layer's output (i.e. CNN input) is preloaded from file before CNN execution
       fd << "# ";
       if (!(run_layers_decoupled || getSimInputActiveLayer(*l)))
@@ -456,8 +927,14 @@ namespace CNN_NET {
       return "../sim_results/l" + to_signed_string(layer.number, 3) + ".bin";
     }
     virtual bool getSimOutputActiveLayer(const CNN_LAYER::Layer &layer) {
-      // default: dump outputs and intermediate layers
-      return true;
+      // default: dump outputs and intermediate layers; shared output space has been overwritten at the end of execution
+      // (dump_layer_outputs: no shared output space)
+      // fusing layers store the fused layer's result instead of their own output
+      for (auto dl: layer.dest_layers) {
+        if (dl->fused_into == &layer)
+          return false;
+      }
+      return !mm_shared_outputs.count(&layer);
     }
 
     // one file per channel
@@ -485,10 +962,16 @@ Independent execution of all layers in a net, useful to quickly identify working
 
       instantiateLayers();
 
-      designMmLayoutVpro();
-
+      // output space re-use depends on execution order
       generateLayerExecList();
 
+      // decoupled execution preloads every layer output -> each layer must compute its own
+      if (fuse_layers && !run_layers_decoupled) {
+        fuseLayers();
+      }
+
+      designMmLayoutVpro();
+
       if (run_layers_decoupled) {
         layers[layer_execlist.front()]->first_layer_producing_output = true;
         layers[layer_execlist.back()]->last_layer_using_input = true;
@@ -626,6 +1109,32 @@ Independent execution of all layers in a net, useful to quickly identify working
 #endif
     bool run_layers_decoupled{RUN_LAYERS_DECOUPLED};
 
+#ifndef REUSE_OUTPUT_MM
+#define REUSE_OUTPUT_MM true
+#endif
+    bool reuse_output_mm{REUSE_OUTPUT_MM}; // layers with disjoint live ranges share output space (see designMmLayoutReuse())
+    std::set<const CNN_LAYER::Layer*> mm_shared_outputs; // outputs in shared space, overwritten by later layers
+
+#ifndef DUMP_LAYER_OUTPUTS
+#define DUMP_LAYER_OUTPUTS false
+#endif
+    bool dump_layer_outputs{DUMP_LAYER_OUTPUTS}; // ISS dumps all layer outputs (output.cfg), disables reuse_output_mm
+
+#ifndef FUSE_LAYERS
+#define FUSE_LAYERS false
+#endif
+    bool fuse_layers{FUSE_LAYERS}; // compute suitable consumers within the producing layer (see fuseLayers())
+
+#ifndef NETGEN_THREADS
+#define NETGEN_THREADS 0
+#endif
+    unsigned int netgen_threads{NETGEN_THREADS}; // command generation threads, 0: one per hardware thread, 1: sequential
+
+#ifndef OVERLAP_LAYERS
+#define OVERLAP_LAYERS false
+#endif
+    bool overlap_layers{OVERLAP_LAYERS}; // issue independent first loads of a layer during the tail of its predecessor (see overlapLayerBoundaries())
+
     //  protected:
     std::vector<CNN_LAYER::Layer*> layers;
     std::vector<int> layer_execlist; // index into layers[]
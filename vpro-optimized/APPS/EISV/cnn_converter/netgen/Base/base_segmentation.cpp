@@ -171,7 +171,7 @@ void Layer::generateSegments() {
     
     // sanity check for number of segments
     if (segments.size() % VPRO_CFG::parallel_Lanes != 0 || (int)segments.size() != appended_segs + appended_dummies) {
-        std::cout << "Generated " << segments.size() << " segments (" << appended_dummies << " dummies + " << appended_segs << ") for layer "
+        NETGEN_LOG::out() << "Generated " << segments.size() << " segments (" << appended_dummies << " dummies + " << appended_segs << ") for layer "
                   << name //<< ", expected " << expected_segment_count
                   << " (seg.num.x = " << seg.num.x << ", seg.num.y = " << seg.num.y << ", in_dim(0).ch = " << in_dim(0).ch << ", out_dim.ch = " << out_dim.ch << ")\n";
         assert(0);
@@ -0,0 +1,44 @@
+#ifndef NETGEN_LOG_H
+#define NETGEN_LOG_H
+
+#include <cstdarg>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Diagnostic output of code running on the command generation workers (see Net::forEachLayerParallel()).
+// Each worker captures the output of the layer it processes; the net prints it in layer order afterwards,
+// so the log of a parallel run reads like a sequential one. Outside of the workers, output goes to stdout.
+namespace NETGEN_LOG {
+
+// capture buffer of the calling thread, nullptr: write to stdout
+inline thread_local std::ostringstream *capture = nullptr;
+
+inline std::ostream &out() {
+    return capture ? *capture : std::cout;
+}
+
+__attribute__((format(printf, 1, 2)))
+inline int printf(const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    int len;
+    if (capture) {
+        va_list args_copy;
+        va_copy(args_copy, args);
+        len = vsnprintf(nullptr, 0, fmt, args_copy);
+        va_end(args_copy);
+        std::string buf(len, '\0');
+        vsnprintf(&buf[0], len + 1, fmt, args);
+        *capture << buf;
+    } else {
+        len = vprintf(fmt, args);
+    }
+    va_end(args);
+    return len;
+}
+
+} // namespace NETGEN_LOG
+
+#endif // NETGEN_LOG_H
@@ -45,6 +45,11 @@ int MaxEfficiencyCalculation::getBlockOverlap(uint32_t blocksize, uint32_t block
 void MaxEfficiencyCalculation::runCalculation() {
     in_size = inx * iny;
 
+    if (cost_model) {
+        runCalculationCostModel();
+        return;
+    }
+
     if (not silent) {
         printf("Running Eval for:\n");
         printf("  inx = %i, iny = %i, [in size = %i]\n", inx, iny, in_size);
@@ -82,6 +87,7 @@ void MaxEfficiencyCalculation::runCalculation() {
     for (uint32_t n = 2; n <= std::min(std::min(outc, in_size / 2), 62u); n += 2) {   // in_size/2 | n = 62 => bs = 14 | n = 31 => bs =  31
         for (bs = 1; bs <= getBlockSizeUpperBound(in_size, n, m); ++bs) {  //getBlockSizeUpperBound(in_size, n, m)
             printf("\rRemaining: %5i", count);
+            fflush(stdout); // progress without newline
             count--;
             auto bc = getBlockCount(bs, in_size);
             runCalculationSegmentation(n, m, bs, bc);
@@ -130,6 +136,55 @@ void MaxEfficiencyCalculation::runCalculation() {
     printf("  Efficiency Improvement: +%.2f%% [After %u evaluations]\n", improvement_vs_original * 100, eval_count);
 }
 
+void MaxEfficiencyCalculation::runCalculationCostModel() {
+    printf("Cost model eval for inx = %i, iny = %i, [in size = %i], inc = %i, outc = %i. HW parallel Lanes: %i\n", inx, iny, in_size, inc, outc, VPRO_CFG::parallel_Lanes);
+
+    // 1D segments of a 1x1 conv: block of bs pixels per input channel, one MAC per pixel, kernel and bias are single words
+    SegmentationCostModel::Mapping map;
+    map.in_channels = int(inc);
+    map.out_channels = int(outc);
+    map.vpro_commands = 1;  // _conv[_add]()
+    map.post_commands = 2;  // bias/activation, _shift_store()
+    map.weights = 1;
+    map.weights_per_out = 1;
+    map.lanes_per_unit = VPRO_CFG::LANES;
+
+    const CNN_LAYER::SEGMENT_SCHEDULING_ORDER orders[] = {CNN_LAYER::ITERATE_ALL_SORTED_OUTC, CNN_LAYER::ITERATE_ALL_SORTED_X, CNN_LAYER::ITERATE_ALL_SORTED_X2};
+
+    final.cycles = -1;
+    uint eval_count = 0;
+    int m = 1;  // TODO: multiple inputs...
+    for (uint32_t n = 1; n <= std::min(std::min(outc, std::max(in_size / 2, 1u)), 62u); n += (n == 1) ? 1 : 2) {
+        for (uint32_t bs = 1; bs <= getBlockSizeUpperBound(in_size, n, m); ++bs) {
+            auto bc = getBlockCount(bs, in_size);
+            map.segments = bc;
+            map.seg_in_w = int(bs);
+            map.seg_in_x_stride = int(bs);
+            map.seg_compute_elements = int(bs);
+            map.seg_store_elements = int(bs);
+            map.parallel_outchannels_per_lane = int(n);
+            for (auto order: orders) {
+                map.scheduling_order = order;
+                auto est = cost_model->estimate(map);
+                eval_count++;
+                if (final.cycles < 0 || est.total < final.cycles) {
+                    final.cycles = est.total;
+                    final.efficiency = est.lane_usage * 100;
+                    final.order = order;
+                    final.n = n;
+                    final.m = m;
+                    final.block_count = bc;
+                    final.in_size = bs;
+                    final.overcalc = getBlockOverlap(bs, bc, in_size);
+                }
+            }
+        }
+    }
+
+    printf("  Best Result: (n %i, m %i, bs %i, bc %i, order %i, lane usage %.2lf%%, predicted cycles %.0lf) [After %u evaluations]\n",
+           final.n, final.m, final.in_size, final.block_count, final.order, final.efficiency, final.cycles, eval_count);
+}
+
 void MaxEfficiencyCalculation::runCalculationSegmentation(uint n, uint m, uint block_size, uint blockcount) {
     bool DEBUG = false;
 
@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 #include <functional>
+#include "SegmentationCostModel.h"
 
 class MaxEfficiencyCalculation {
 
@@ -14,6 +15,10 @@ public:
     MaxEfficiencyCalculation(uint32_t inx, uint32_t iny, uint32_t inc, uint32_t outc, bool silent = false) :
             inx(inx), iny(iny), inc(inc), outc(outc), silent(silent) {}
 
+    // rank by predicted cycles of the cost model instead of efficiency; also searches the scheduling order
+    MaxEfficiencyCalculation(uint32_t inx, uint32_t iny, uint32_t inc, uint32_t outc, const SegmentationCostModel *cost_model, bool silent = false) :
+            inx(inx), iny(iny), inc(inc), outc(outc), silent(silent), cost_model(cost_model) {}
+
     void runCalculation();
 
     [[nodiscard]] uint32_t get1DInputSize() const {
@@ -40,6 +45,14 @@ public:
         return final.overcalc;
     }
 
+    [[nodiscard]] CNN_LAYER::SEGMENT_SCHEDULING_ORDER getSchedulingOrder() const {
+        return final.order;
+    }
+
+    [[nodiscard]] double getPredictedCycles() const {
+        return final.cycles;
+    }
+
     static int getBlockCount(uint32_t blocksize, uint32_t in_size);
 
     static int getBlockOverlap(uint32_t blocksize, uint32_t blockcount, uint32_t in_size);
@@ -48,6 +61,8 @@ private:
 
     void runCalculationSegmentation(uint n, uint m, uint block_size, uint blockcount);
 
+    void runCalculationCostModel();
+
     bool PRINT_EVERY_TRY{true};
     bool PRINT_EVERY_TRY_IN_NEW_LINE{true};
 
@@ -57,6 +72,7 @@ private:
     uint32_t inc{};
     uint32_t outc{};
     bool silent{false};
+    const SegmentationCostModel *cost_model{nullptr};
 
     uint32_t getBlockSizeUpperBound(uint32_t insize, uint32_t n, uint32_t m);
 
@@ -69,6 +85,8 @@ private:
         uint32_t m{};
         uint32_t overcalc{};    // too much pixels in out size (when all blockCount * blockSize pixels are produced)
         double efficiency{};
+        CNN_LAYER::SEGMENT_SCHEDULING_ORDER order{CNN_LAYER::ITERATE_ALL_SORTED_X2};
+        double cycles{};    // predicted by cost_model
     } final;
 
     double calc_eff{}, hw_eff{};
@@ -0,0 +1,95 @@
+#include "SegmentationCostModel.h"
+#include <algorithm>
+#include <cstring>
+#include "misc.h"
+#include "vpro_globals.h"
+
+SegmentationCostModel::Estimate SegmentationCostModel::estimate(const Mapping &m) const {
+    Estimate e;
+
+    const int lanes = VPRO_CFG::LANES;
+    const int units = VPRO_CFG::UNITS;
+    const int clusters = VPRO_CFG::CLUSTERS;
+    const int n = std::max(1, m.parallel_outchannels_per_lane);
+    const int unit_ch = std::clamp(m.lanes_per_unit, 1, lanes) * n; // output channels of one unit per location
+
+    // output channels iterated per location before the next location is started (Layer::generateSegments())
+    int block;
+    switch (m.scheduling_order) {
+        case CNN_LAYER::ITERATE_ALL_SORTED_X:
+            block = n * (int)VPRO_CFG::parallel_Lanes;
+            break;
+        case CNN_LAYER::ITERATE_ALL_SORTED_X2:
+            block = n * lanes;
+            break;
+        default:
+            block = m.out_channels;
+            break;
+    }
+    block = std::min(block, m.out_channels);
+
+    // a unit only takes segments of one location (same input data), remaining lanes get dummies
+    int full_blocks = m.out_channels / block;
+    int remainder = m.out_channels % block;
+    long unit_usages = long(m.segments) * (full_blocks * ceil_div(block, unit_ch) + (remainder ? ceil_div(remainder, unit_ch) : 0));
+    e.sets = int((unit_usages + clusters * units - 1) / (clusters * units));
+    e.lane_usage = double(m.segments) * m.out_channels / (double(e.sets) * VPRO_CFG::parallel_Lanes * n);
+
+    // per set and cluster: locations (input blocks, broadcast to all units of that location) and kernels (broadcast to all units using them)
+    int shared = m.group_out_channels > 0 ? std::min(block, m.group_out_channels) : block;
+    int units_per_location = std::min(ceil_div(shared, unit_ch), units);
+    int locations = ceil_div(units, units_per_location);
+    int kernels = std::min(units * unit_ch, block);
+    int all_locations = clusters * locations;
+    int all_kernels = std::min(block, clusters * kernels); // X2: identical kernels in all clusters
+
+    // halo columns overlap with the horizontal neighbour; its lines are in the DCMA already
+    double overlap = m.seg_in_w > m.seg_in_x_stride ? double(m.seg_in_w - m.seg_in_x_stride) / m.seg_in_w : 0.;
+    double block_bytes = 2. * m.seg_in_w * m.seg_in_h;
+
+    // one input channel (double buffered phase)
+    double dma_bytes = locations * m.inputs * block_bytes + 2. * kernels * m.weights;
+    int dma_commands = locations * m.inputs + (m.weights ? kernels : 0);
+    double mm_bytes = all_locations * m.inputs * block_bytes * (1. - params.dcma_line_reuse * overlap) + 2. * all_kernels * m.weights;
+
+    double phase_dma = std::max(dma_bytes / params.dma_bytes_per_cycle + dma_commands * params.dma_setup_cycles,
+                                mm_bytes / params.mm_bytes_per_cycle);
+    double phase_compute = n * (double(m.ops_per_element) * m.seg_compute_elements + m.vpro_commands * params.vpro_pipeline_cycles);
+    double phase_commands = double(clusters * dma_commands + n * m.vpro_commands + 1) * params.command_issue_cycles;
+
+    // after all input channels: bias, activation/pooling and store of all results of this set
+    double store_bytes = 2. * units * unit_ch * m.seg_store_elements + 2. * kernels * m.weights_per_out;
+    int store_commands = units * unit_ch + (m.weights_per_out ? kernels : 0);
+    double tail_dma = std::max(store_bytes / params.dma_bytes_per_cycle + store_commands * params.dma_setup_cycles,
+                               clusters * store_bytes / params.mm_bytes_per_cycle);
+    double tail_compute = n * m.post_commands * (double(m.seg_compute_elements) + params.vpro_pipeline_cycles);
+    double tail_commands = double(clusters * store_commands + n * m.post_commands + 1) * params.command_issue_cycles;
+
+    double phase = std::max({phase_compute, phase_dma, phase_commands}) + params.sync_cycles;
+    double tail = std::max({tail_compute, tail_dma, tail_commands}) + params.sync_cycles;
+
+    e.compute = e.sets * (m.in_channels * phase_compute + tail_compute);
+    e.dma = e.sets * (m.in_channels * phase_dma + tail_dma);
+    e.commands = e.sets * (m.in_channels * phase_commands + tail_commands);
+    e.total = e.sets * (m.in_channels * phase + tail);
+    return e;
+}
+
+uint32_t SegmentationCostModel::parameterHash() const {
+    // FNV-1a over the single fields (no struct padding)
+    uint32_t hash = 2166136261u;
+    auto add = [&hash](const auto &value) {
+        unsigned char bytes[sizeof(value)];
+        memcpy(bytes, &value, sizeof(value));
+        for (auto b: bytes)
+            hash = (hash ^ b) * 16777619u;
+    };
+    add(params.dma_bytes_per_cycle);
+    add(params.mm_bytes_per_cycle);
+    add(params.dcma_line_reuse);
+    add(params.dma_setup_cycles);
+    add(params.vpro_pipeline_cycles);
+    add(params.command_issue_cycles);
+    add(params.sync_cycles);
+    return hash;
+}
@@ -0,0 +1,102 @@
+#ifndef CNN_CONVERTER_SEGMENTATIONCOSTMODEL_H
+#define CNN_CONVERTER_SEGMENTATIONCOSTMODEL_H
+
+#include <stdint.h>
+#include <climits>
+#include <string>
+#include "Base/base_enum.h"
+
+/**
+ * Predicts the VPRO execution time of one layer for a candidate segmentation
+ * (segment shape, parallel_outchannels_per_lane, scheduling order).
+ *
+ * Used by the setSegmentDimensions() searches if LAYERCFG::segmentation_strategy == COST_MODEL.
+ * The model follows the runtime (calc_cnn): per input channel, all lanes of one set of segments compute
+ * while the DMA loads the next input channel (double buffering). A phase takes as long as the slowest of
+ *  - VPRO: MAC cycles of the busiest lane + pipeline fill/drain per vector command
+ *  - DMA: bytes of the busiest cluster (input blocks incl. overlap/padding, kernels, results) + setup per transfer,
+ *         limited by the main memory bandwidth shared by all clusters (overlapping lines hit in the DCMA)
+ *  - EIS-V: issue cycles of all commands
+ * plus one synchronization. Only relative values are compared, the parameters are coarse defaults.
+ *
+ * Limits:
+ *  - the parameters are not calibrated against ISS / hardware cycle counts, hence COST_MODEL is not the default
+ *    segmentation strategy. Calibrate by running a net with both strategies and fitting the Parameters to the
+ *    per-layer cycles of the simulator statistics.
+ *  - DCMA hits are a fixed fraction of the halo (no cache simulation), bank conflicts and the main memory timing
+ *    model are not covered
+ *  - Concat, GlobalAveragePooling and DepthToSpace (and the other layers with a fixed segmentation) do not use it
+ */
+class SegmentationCostModel {
+
+public:
+    struct Parameters {
+        double dma_bytes_per_cycle{4};      // LM side of one cluster DMA
+        double mm_bytes_per_cycle{16};      // main memory (DCMA refill) shared by all clusters
+        double dcma_line_reuse{0.9};        // fraction of overlapping input (halo of neighbour segments) served by DCMA lines already loaded
+        uint32_t dma_setup_cycles{20};      // per DMA command (descriptor, address generation, 2D setup)
+        uint32_t vpro_pipeline_cycles{12};  // per vector command (pipeline fill/drain bubble)
+        uint32_t command_issue_cycles{6};   // per command issued by the EIS-V (DMA, VPRO, sync)
+        uint32_t sync_cycles{30};           // per double buffering phase
+    };
+
+    /**
+     * one candidate mapping of a layer, all sizes in elements
+     */
+    struct Mapping {
+        int segments{1};            // segments per output channel (seg.num.x * seg.num.y)
+        int seg_in_w{1};            // input block loaded per segment and input channel
+        int seg_in_h{1};
+        int seg_in_x_stride{1};     // distance of horizontal neighbours -> seg_in_w - seg_in_x_stride columns overlap
+        int seg_compute_elements{1};  // result elements computed per segment in the RF (pre-pool)
+        int seg_store_elements{1};  // result elements stored per segment (post-pool/upsample)
+
+        int out_channels{1};
+        int in_channels{1};         // input channels accumulated per output channel (phases per set)
+        int inputs{1};              // input blocks per input channel (e.g. 2 for elementwise)
+        int ops_per_element{1};     // MAC cycles per result element and input channel (kernel taps)
+        int vpro_commands{1};       // vector commands per segment and input channel
+        int post_commands{1};       // vector commands per segment after accumulation (activation, pooling, store)
+        int weights{0};             // kernel words per output and input channel
+        int weights_per_out{0};     // words per output channel, loaded once (bias)
+
+        int group_out_channels{0};  // output channels sharing one input block (out_channels / groups), 0: all
+        int lanes_per_unit{1};      // lanes of a unit which get segments (compatibleSegmentsBlock())
+        int parallel_outchannels_per_lane{1};
+        CNN_LAYER::SEGMENT_SCHEDULING_ORDER scheduling_order{CNN_LAYER::ITERATE_ALL_SORTED_OUTC};
+    };
+
+    struct Estimate {
+        int sets{};                 // sets of segments for all lanes (= calls of the lane kernels per input channel)
+        double lane_usage{};        // non-dummy segments / all segment slots
+        double compute{};           // VPRO cycles
+        double dma{};               // DMA cycles (busiest cluster or main memory)
+        double commands{};          // EIS-V issue cycles
+        double total{};             // predicted cycles of the layer
+
+        [[nodiscard]] int totalClamped() const {   // for int cost fields
+            return total >= INT_MAX ? INT_MAX - 1 : int(total);
+        }
+    };
+
+    SegmentationCostModel() = default;
+
+    explicit SegmentationCostModel(const Parameters &params) : params(params) {}
+
+    [[nodiscard]] Estimate estimate(const Mapping &m) const;
+
+    [[nodiscard]] const Parameters &getParameters() const {
+        return params;
+    }
+
+    /**
+     * identifies the parameter set (e.g. in segmentation cache file names, results of other parameters differ)
+     */
+    [[nodiscard]] uint32_t parameterHash() const;
+
+private:
+    Parameters params;
+};
+
+
+#endif //CNN_CONVERTER_SEGMENTATIONCOSTMODEL_H
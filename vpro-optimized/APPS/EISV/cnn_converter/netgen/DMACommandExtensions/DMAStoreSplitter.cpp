@@ -3,6 +3,7 @@
 //
 
 #include "DMAStoreSplitter.h"
+#include "Base/netgen_log.h"
 #include <math.h>
 
 /**
@@ -128,7 +129,7 @@ void DmaStoreSpliiter::split_and_append(std::list<BIF::COMMAND_SEGMENT *> &segme
         }
 
         if (debug)
-            printf("\e[92m  Insert  num_stores_per_block: %i, dma_blocks: %i \e[0m\n", num_stores_per_block, dma_blocks);
+            NETGEN_LOG::printf("\e[92m  Insert  num_stores_per_block: %i, dma_blocks: %i \e[0m\n", num_stores_per_block, dma_blocks);
 
         // add to final list
         for (auto s: others) {
@@ -136,7 +137,7 @@ void DmaStoreSpliiter::split_and_append(std::list<BIF::COMMAND_SEGMENT *> &segme
         }
 
     } else {    // continue old way without splitting the store command block
-        printf("\e[33m[Split of DMA Stores failed as multiple distributed store commands are present in one split block!] Continue old way...\e[0m\n");
+        NETGEN_LOG::printf("\e[33m[Split of DMA Stores failed as multiple distributed store commands are present in one split block!] Continue old way...\e[0m\n");
         for (auto s: segment) {
             new_list.push_back(*s);
         }
@@ -3,6 +3,7 @@
 //
 
 #include "DmaLoopExtension.h"
+#include "Base/netgen_log.h"
 
 std::vector<BIF::COMMAND_SEGMENT> DmaLoopExtension::generate(bool debug) {
     total_loop_encoded_dmas = 0;
@@ -38,14 +39,14 @@ std::vector<BIF::COMMAND_SEGMENT> DmaLoopExtension::generate(bool debug) {
         if (!is_dma_cmd_loop) {  // begin + end are not part of a loop
             if (cmp_func(*begin, *end)) {    // begin + end are loopable
                 if (debug){
-                    printf("  [DMA LOOP gen] Loop begin\n");
-                    printf("         Base: %s\n", begin->to_char());
-                    printf("         +1  : %s\n", end->to_char());
+                    NETGEN_LOG::printf("  [DMA LOOP gen] Loop begin\n");
+                    NETGEN_LOG::printf("         Base: %s\n", begin->to_char());
+                    NETGEN_LOG::printf("         +1  : %s\n", end->to_char());
                 }
                 is_dma_cmd_loop = true;
             } else {    // begin + end are not loopable
                 if (debug)
-                    printf("  [DMA LOOP gen] Skip (shortcut to list) \e[2m %s \e[0m\n", begin->to_char());
+                    NETGEN_LOG::printf("  [DMA LOOP gen] Skip (shortcut to list) \e[2m %s \e[0m\n", begin->to_char());
                 total_dmas += 1;
                 new_list.push_back(*begin);
                 begin = end;
@@ -53,13 +54,13 @@ std::vector<BIF::COMMAND_SEGMENT> DmaLoopExtension::generate(bool debug) {
         } else { // begin + previous end are loopable
             if (cmp_func(*begin, *end)) { // loop can continue
                 if (debug) {
-                    printf("  [DMA LOOP gen] Continue\n");
-                    printf("         +1  : %s\n", end->to_char());
+                    NETGEN_LOG::printf("  [DMA LOOP gen] Continue\n");
+                    NETGEN_LOG::printf("         +1  : %s\n", end->to_char());
                 }
                 // nothing, increment end at end
             } else {    // loop finish. extract parameters + push
                 if (debug)
-                    printf("  [DMA LOOP gen] Finish (new begin: %s)\n", end->to_char());
+                    NETGEN_LOG::printf("  [DMA LOOP gen] Finish (new begin: %s)\n", end->to_char());
                 new_list.splice(new_list.end(), extractLoopCommand(std::list<BIF::COMMAND_SEGMENT>(begin, end), debug));
                 begin = end;
                 is_dma_cmd_loop = false;
@@ -203,10 +204,10 @@ std::vector<BIF::COMMAND_SEGMENT> DmaLoopExtension::generate(bool debug) {
     uint32_t new_byte = 32*newer_list.size();
     uint32_t reduced_byte = original_byte - new_byte;
 
-    printf("  [DMA CMD LOOP] Direct DMA commands remaining (no loop): %i, Loop encoded DMA commands: %i, number of DMA Loops: %i (+VPRO/Syncs)\n", total_dmas, total_loop_encoded_dmas, total_loops);
-    printf("      %lu Commands in total (-%u Commands by Loop; -%2.2f%%)\n", newer_list.size(), reduced_byte/32, 100-float(new_byte)/float(original_byte)*100);
+    NETGEN_LOG::printf("  [DMA CMD LOOP] Direct DMA commands remaining (no loop): %i, Loop encoded DMA commands: %i, number of DMA Loops: %i (+VPRO/Syncs)\n", total_dmas, total_loop_encoded_dmas, total_loops);
+    NETGEN_LOG::printf("      %lu Commands in total (-%u Commands by Loop; -%2.2f%%)\n", newer_list.size(), reduced_byte/32, 100-float(new_byte)/float(original_byte)*100);
     if (debug){
-        printf("      Size reduced from %i B to %i B (- %i B)\n", original_byte, new_byte, reduced_byte);
+        NETGEN_LOG::printf("      Size reduced from %i B to %i B (- %i B)\n", original_byte, new_byte, reduced_byte);
     }
 
     /**
@@ -239,11 +240,11 @@ std::vector<BIF::COMMAND_SEGMENT> DmaLoopExtension::generate(bool debug) {
 
     auto output_list_size_unrolled = newer_list.size() - 2 * loop_count + loop_encoded_dmas;
     if (input_list_size != output_list_size_unrolled){
-        printf("\e[91m[Error] Loop List Total Length differs when unrolling all Loops!\e[0m\n");
-        printf("    [DMA LOOP] Loops: %u, Loop Encoded DMAs: %u\n", loop_count, loop_encoded_dmas);
-        printf("    [DMA LOOP] Output List Total: %lu\n", newer_list.size());
-        printf("    [DMA LOOP] Output List Total (old count with individual DMAs): %lu\n", newer_list.size() - 2 * loop_count + loop_encoded_dmas);
-        printf("    [DMA LOOP] Input List Total: %lu\n", input_list_size);
+        NETGEN_LOG::printf("\e[91m[Error] Loop List Total Length differs when unrolling all Loops!\e[0m\n");
+        NETGEN_LOG::printf("    [DMA LOOP] Loops: %u, Loop Encoded DMAs: %u\n", loop_count, loop_encoded_dmas);
+        NETGEN_LOG::printf("    [DMA LOOP] Output List Total: %lu\n", newer_list.size());
+        NETGEN_LOG::printf("    [DMA LOOP] Output List Total (old count with individual DMAs): %lu\n", newer_list.size() - 2 * loop_count + loop_encoded_dmas);
+        NETGEN_LOG::printf("    [DMA LOOP] Input List Total: %lu\n", input_list_size);
         exit(1);
     }
     return std::vector<BIF::COMMAND_SEGMENT>(newer_list.begin(), newer_list.end());
@@ -252,10 +253,10 @@ std::vector<BIF::COMMAND_SEGMENT> DmaLoopExtension::generate(bool debug) {
 std::list<BIF::COMMAND_SEGMENT> DmaLoopExtension::extractLoopCommand(std::list<BIF::COMMAND_SEGMENT> same_dim_dma_list, bool debug) {
 
     if (debug) {
-        printf("    [DMA LOOP Extract] In List Size: %lu \n", same_dim_dma_list.size());
+        NETGEN_LOG::printf("    [DMA LOOP Extract] In List Size: %lu \n", same_dim_dma_list.size());
 //        int cnt = 0;
         for (auto i: same_dim_dma_list) {
-            printf("       %s\n", i.to_char());
+            NETGEN_LOG::printf("       %s\n", i.to_char());
 //            cnt++;
 //            if (cnt > 3) break;
         }
@@ -378,13 +379,13 @@ std::list<BIF::COMMAND_SEGMENT> DmaLoopExtension::extractLoopCommand(std::list<B
 
               if (mm_incr != (int32_t)(second.dma.mm_addr - previous.dma.mm_addr)) {
                     if (debug)
-                        printf("  \e[91m  [DMA LOOP Extract] Undo. No New Loop: mm != %i\e[m\n", (second.dma.mm_addr - previous.dma.mm_addr));
+                        NETGEN_LOG::printf("  \e[91m  [DMA LOOP Extract] Undo. No New Loop: mm != %i\e[m\n", (second.dma.mm_addr - previous.dma.mm_addr));
                     loop = false; // TODO: loop will not be created -> fix to create one and continue
                 } else {
                     if (loop_update_target == INTER_UNIT && cluster_mask_check.second == 0 && unit_mask_check.second == 0) {
                         if (lm_incr != (int32_t)(second.dma.lm_addr - previous.dma.lm_addr)) {
                             if (debug)
-                                printf("  \e[91m  [DMA LOOP Extract] Undo. No New Loop: lm != %i (target: %i)\e[m\n", (second.dma.lm_addr - previous.dma.lm_addr), lm_incr);
+                                NETGEN_LOG::printf("  \e[91m  [DMA LOOP Extract] Undo. No New Loop: lm != %i (target: %i)\e[m\n", (second.dma.lm_addr - previous.dma.lm_addr), lm_incr);
                             loop = false; // TODO: loop will not be created -> fix to create one and continue
                         } else {
                             loop_update_target = INTER_UNIT;
@@ -396,7 +397,7 @@ std::list<BIF::COMMAND_SEGMENT> DmaLoopExtension::extractLoopCommand(std::list<B
                     if (loop_update_target == UNIT && cluster_mask_check.second == 0 && unit_mask_check.second != 0 && unit_mask_shift_last != unit_mask_check.second) {
                         if (unit_mask_check.second < unit_mask_shift_last){
                             if (debug)
-                                printf("  \e[91m  [DMA LOOP Extract] Undo. No New Loop: unit mask shift changed!\e[m\n");
+                                NETGEN_LOG::printf("  \e[91m  [DMA LOOP Extract] Undo. No New Loop: unit mask shift changed!\e[m\n");
                             loop = false; // TODO: loop will not be created -> fix to create one and continue
                         } else {
                             unit_mask_shift_last = unit_mask_check.second;
@@ -421,21 +422,21 @@ std::list<BIF::COMMAND_SEGMENT> DmaLoopExtension::extractLoopCommand(std::list<B
             if (is_looping) {
                 loop_list.push_back(second);
                 if (debug)
-                    printf("    [DMA LOOP Extract] Continue Loop parameter update: mm %i, lm %i, cluster_len: %i (<< %i), unit_len: %i (<< %i), inter_unit_len: %i, list length: %lu, Update: %s\n",
+                    NETGEN_LOG::printf("    [DMA LOOP Extract] Continue Loop parameter update: mm %i, lm %i, cluster_len: %i (<< %i), unit_len: %i (<< %i), inter_unit_len: %i, list length: %lu, Update: %s\n",
                            mm_incr, lm_incr, cluster_len, cluster_shift, unit_len, unit_shift, inter_unit_len, loop_list.size(), UPDATE_TARGET_LOOP_to_string(loop_update_target));
             } else {
                 is_looping = true;
                 loop_list.push_back(base);
                 loop_list.push_back(second);
                 if (debug)
-                    printf("    [DMA LOOP Extract] New Loop      parameter update: mm %i, lm %i, cluster_len: %i (<< %i), unit_len: %i (<< %i), inter_unit_len: %i, list length: %lu, Update: %s\n",
+                    NETGEN_LOG::printf("    [DMA LOOP Extract] New Loop      parameter update: mm %i, lm %i, cluster_len: %i (<< %i), unit_len: %i (<< %i), inter_unit_len: %i, list length: %lu, Update: %s\n",
                            mm_incr, lm_incr, cluster_len, cluster_shift, unit_len, unit_shift, inter_unit_len, loop_list.size(), UPDATE_TARGET_LOOP_to_string(loop_update_target));
             }
             // front stays the same
         } else {
             if (is_looping) {
                 if (debug)
-                    printf("    [DMA LOOP Extract] Loop End -> Gen Parameter\n");
+                    NETGEN_LOG::printf("    [DMA LOOP Extract] Loop End -> Gen Parameter\n");
                 // end loop list with base: front. generate loop command
                 //   validate lm and mm for all inter, units, clusters
                 //   append to new_list with base
@@ -443,7 +444,7 @@ std::list<BIF::COMMAND_SEGMENT> DmaLoopExtension::extractLoopCommand(std::list<B
                     auto loop_cmd = generateLoopCommand(loop_list, cluster_shift, unit_shift, cluster_len, unit_len, inter_unit_len, mm_incr, lm_incr, loop_list.size());
                     if (!verifyLoopCommand(loop_list, loop_cmd, debug)) {
                         if (debug)
-                            printf("\e[91m[Error] Loop Command not executing all required DMA Commands! -> using old way with a lot of commands!\e[0m\n");
+                            NETGEN_LOG::printf("\e[91m[Error] Loop Command not executing all required DMA Commands! -> using old way with a lot of commands!\e[0m\n");
                         new_list.insert(new_list.end(), loop_list.begin(), loop_list.end());
                     } else {
                         new_list.push_back(loop_cmd);
@@ -451,7 +452,7 @@ std::list<BIF::COMMAND_SEGMENT> DmaLoopExtension::extractLoopCommand(std::list<B
                     }
                 } else {
                     if (debug)
-                        printf("    [DMA LOOP Extract] No Loop as length of list of commands ( %zu ) smaller than %i!\n", loop_list.size(), minimal_count_of_instr_in_loop_to_generate_loop);
+                        NETGEN_LOG::printf("    [DMA LOOP Extract] No Loop as length of list of commands ( %zu ) smaller than %i!\n", loop_list.size(), minimal_count_of_instr_in_loop_to_generate_loop);
                     for (auto i: loop_list)
                         new_list.push_back(i);
                 }
@@ -462,7 +463,7 @@ std::list<BIF::COMMAND_SEGMENT> DmaLoopExtension::extractLoopCommand(std::list<B
                 loop_list.clear();
             } else {
                 if (debug)
-                    printf("    [DMA LOOP Extract] No Loop\n");
+                    NETGEN_LOG::printf("    [DMA LOOP Extract] No Loop\n");
                 total_dmas += 1;
                 new_list.push_back(base);
             }
@@ -485,7 +486,7 @@ std::list<BIF::COMMAND_SEGMENT> DmaLoopExtension::extractLoopCommand(std::list<B
             auto loop_cmd = generateLoopCommand(loop_list, cluster_shift, unit_shift, cluster_len, unit_len, inter_unit_len, mm_incr, lm_incr, loop_list.size());
             if (!verifyLoopCommand(loop_list, loop_cmd, debug)) {
                 if (debug)
-                    printf("\e[91m[Error] Finalizing Loop Command not executing all required DMA Commands! -> using old way with a lot of commands!\e[0m\n");
+                    NETGEN_LOG::printf("\e[91m[Error] Finalizing Loop Command not executing all required DMA Commands! -> using old way with a lot of commands!\e[0m\n");
                 new_list.insert(new_list.end(), loop_list.begin(), loop_list.end());
             } else {
                 new_list.push_back(loop_cmd);
@@ -496,13 +497,13 @@ std::list<BIF::COMMAND_SEGMENT> DmaLoopExtension::extractLoopCommand(std::list<B
                 new_list.push_back(i);
         }
         if (debug)
-            printf("    [DMA LOOP Extract] Finalize. Loop End -> Gen Parameter\n");
+            NETGEN_LOG::printf("    [DMA LOOP Extract] Finalize. Loop End -> Gen Parameter\n");
     }
 
     if (debug) {
-        printf("    [DMA LOOP Extract] Out List Size: %lu \n", new_list.size());
+        NETGEN_LOG::printf("    [DMA LOOP Extract] Out List Size: %lu \n", new_list.size());
         for (auto i: new_list) {
-            printf("       %s\n", i.to_char());
+            NETGEN_LOG::printf("       %s\n", i.to_char());
         }
     }
 
@@ -513,9 +514,9 @@ std::list<BIF::COMMAND_SEGMENT> DmaLoopExtension::extractLoopCommand(std::list<B
         }
     }
     if (output_size != input_size){
-        printf("    [DMA LOOP Extract] Out Size wrong when unrolling all loops! out: %i, in: %i\n", output_size, input_size);
+        NETGEN_LOG::printf("    [DMA LOOP Extract] Out Size wrong when unrolling all loops! out: %i, in: %i\n", output_size, input_size);
         for (auto i : new_list) {
-            printf("                %s\n", i.to_char());
+            NETGEN_LOG::printf("                %s\n", i.to_char());
         }
         exit(1);
     }
@@ -525,7 +526,7 @@ std::list<BIF::COMMAND_SEGMENT> DmaLoopExtension::extractLoopCommand(std::list<B
 
 uint8_t DmaLoopExtension::get_tailing_zeros(const uint32_t value) {
     /*if (value & 0xffff0000){
-        printf("\e[91m[Error] get_tailing_zeros only implemented for numbers with maximal 16 tailing zeros!\n\e[0m");
+        NETGEN_LOG::printf("\e[91m[Error] get_tailing_zeros only implemented for numbers with maximal 16 tailing zeros!\n\e[0m");
         exit(1);
     }*/
 
@@ -660,11 +661,11 @@ bool DmaLoopExtension::verifyLoopCommand(std::list<BIF::COMMAND_SEGMENT> &loop_c
     auto base = loop_cmd_list.front();
 
     if (debug) {
-        printf("      [DMA LOOP Verify] In List Size: %lu \n", loop_cmd_list.size());
-        printf("        Loop: %s\n", loop_cmd.dma_loop.to_char());
+        NETGEN_LOG::printf("      [DMA LOOP Verify] In List Size: %lu \n", loop_cmd_list.size());
+        NETGEN_LOG::printf("        Loop: %s\n", loop_cmd.dma_loop.to_char());
 //        int cnt = 0;
         for (auto i: loop_cmd_list) {
-            printf("         %s\n", i.to_char());
+            NETGEN_LOG::printf("         %s\n", i.to_char());
 //            cnt++;
 //    //        if (cnt > 3) break;
         }
@@ -717,7 +718,7 @@ bool DmaLoopExtension::verifyLoopCommand(std::list<BIF::COMMAND_SEGMENT> &loop_c
     bool error = false;
     if (generateCmds.size() != loop_cmd_list.size()){
         if (debug)
-            printf("\e[91m [Error] Loop Generate DMA list size is wrong!\e[0m\n");
+            NETGEN_LOG::printf("\e[91m [Error] Loop Generate DMA list size is wrong!\e[0m\n");
         error = true;
     }
     auto it1 = generateCmds.begin();
@@ -725,16 +726,16 @@ bool DmaLoopExtension::verifyLoopCommand(std::list<BIF::COMMAND_SEGMENT> &loop_c
     for(; it1 != generateCmds.end() && it2 != loop_cmd_list.end(); ++it1, ++it2) {
         if (!dma_compare(*it1, *it2)){
             if (debug)
-                printf("\e[91m[Error] Loop Generate DMA Commands differ from source command list!\e[0m\n");
+                NETGEN_LOG::printf("\e[91m[Error] Loop Generate DMA Commands differ from source command list!\e[0m\n");
             error = true;
         }
     }
 
     if (debug) {
-        printf("      [DMA LOOP Verify] Out List Size: %lu \n", generateCmds.size());
+        NETGEN_LOG::printf("      [DMA LOOP Verify] Out List Size: %lu \n", generateCmds.size());
 //        int cnt = 0;
         for (auto i: generateCmds) {
-            printf("         %s\n", i.to_char());
+            NETGEN_LOG::printf("         %s\n", i.to_char());
 //            cnt++;
 //        if (cnt > 3) break;
         }
@@ -3,6 +3,7 @@
 //
 
 #include "DmaMerger.h"
+#include "Base/netgen_log.h"
 
 void DmaMerger::merge_same_commands(){
     auto cmd_lst = new_list.begin();
@@ -21,8 +22,8 @@ void DmaMerger::merge_same_commands(){
         equal &= (cmd_lst->dma.padding == cmd_it->dma.padding);
 
         if (equal) { // skip this cmd
-            printf("\e[41mSKIPPED DMA Cmd (twice the same!)... \e[0m\n");
-            printf("CMD: %s\n", cmd_it->dma.to_char());
+            NETGEN_LOG::printf("\e[41mSKIPPED DMA Cmd (twice the same!)... \e[0m\n");
+            NETGEN_LOG::printf("CMD: %s\n", cmd_it->dma.to_char());
             cmd_it = new_list.erase(cmd_it); // remove from list (erase will update iterator to next element)
             --cmd_it; // correct iterator
         }
@@ -60,7 +61,7 @@ void DmaMerger::transform_2d_to_1d(){
         }
     }
     if (merge_2d_to_1d > 0 && debug) {
-        printf("   [DMA Merge] \e[96mMerged 2D -> 1D: %d Commands\e[0m\n", merge_2d_to_1d);
+        NETGEN_LOG::printf("   [DMA Merge] \e[96mMerged 2D -> 1D: %d Commands\e[0m\n", merge_2d_to_1d);
     }
 }
 
@@ -72,7 +73,7 @@ void DmaMerger::reduce_1d_by_overcalc(){
                 cmd.dma.skipped_elements_at_end = 0;      // just once!
             } else {  // 2D
                 if (cmd.dma.skipped_elements_at_end != 0) {
-                    printf("2D Command with skipped elements at end!!!!!!!\n");
+                    NETGEN_LOG::printf("2D Command with skipped elements at end!!!!!!!\n");
                     assert(false);
                 }
             }
@@ -240,12 +241,12 @@ std::vector<BIF::COMMAND_SEGMENT> DmaMerger::generate(bool debug) {
     merge_sequential_2ds();
 
     if (dma_1d_merges > 0 || dma_2d_merges > 0)
-        printf("   [DMA Merge] \e[96mConcat Regions in sequential DMA Transfers: Merged %i (1D), %i (2D) | -%.2f%% Commands\e[0m\n", dma_1d_merges, dma_2d_merges,
+        NETGEN_LOG::printf("   [DMA Merge] \e[96mConcat Regions in sequential DMA Transfers: Merged %i (1D), %i (2D) | -%.2f%% Commands\e[0m\n", dma_1d_merges, dma_2d_merges,
                100*float(dma_1d_merges+dma_2d_merges)/(new_list.size()+dma_1d_merges+dma_2d_merges));
 
     auto final_transfers = count_dma_transfers();
     if (final_transfers != initial_transfers){
-        printf("   [DMA Merge] \e[91mError: Total count of dma transfers differ! Initial %lu elements, Final %lu elements\e[0m\n", initial_transfers, final_transfers);
+        NETGEN_LOG::printf("   [DMA Merge] \e[91mError: Total count of dma transfers differ! Initial %lu elements, Final %lu elements\e[0m\n", initial_transfers, final_transfers);
     }
 
     auto sortfunction3 = [](const BIF::COMMAND_SEGMENT &a, const BIF::COMMAND_SEGMENT &b) -> bool{
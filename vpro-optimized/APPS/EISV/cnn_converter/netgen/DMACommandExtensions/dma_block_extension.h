@@ -248,7 +248,7 @@ public:
                 pblock.vpro.list.clear();
                 pblock.got_dma = false;
                 pblock.got_vpro = false;
-            } else {printf/*_error*/("unknown segment type.type!\n"); }
+            } else {NETGEN_LOG::printf/*_error*/("unknown segment type.type!\n"); }
         }
 
 
@@ -258,7 +258,7 @@ public:
                 total_dma_blocks++;
         }
 
-        printf("  [DMA Block Extraction | Cluster Broadcasting] %i DMA Blocks\n"\
+        NETGEN_LOG::printf("  [DMA Block Extraction | Cluster Broadcasting] %i DMA Blocks\n"\
                "      %i Commands total (-%i DMA Commands by Cluster Broadcasting; -%2.2f%%)\n",
                total_dma_blocks,
                cmds_final.size(), merged_dma_commands, 100*float(merged_dma_commands)/float(cmds_final.size() + merged_dma_commands));
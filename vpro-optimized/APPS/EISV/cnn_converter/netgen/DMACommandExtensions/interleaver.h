@@ -120,13 +120,13 @@ public:
                 cmds_interleaved.append(s);
 
                 if(!vpro_block.empty() || !dma_block.empty()){
-                    printf/*_error*/("either VPRO or DMA Block list not yet empty!\n");
+                    NETGEN_LOG::printf/*_error*/("either VPRO or DMA Block list not yet empty!\n");
                 }
             }
         }
 
         if(!vpro_block.empty() || !dma_block.empty()){
-            printf/*_error*/("BLOCKS not yet empty!\n");
+            NETGEN_LOG::printf/*_error*/("BLOCKS not yet empty!\n");
         }
 
 
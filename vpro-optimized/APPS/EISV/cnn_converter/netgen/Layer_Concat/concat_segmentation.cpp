@@ -74,7 +74,7 @@ void Concatenate::generateSegments(){
     unsigned int expected_segment_count = seg.num.x * seg.num.y * out_dim.ch + appended_dummies;
     if (segments.size() != expected_segment_count) {
         int seg_num_in_ch = out_dim.ch;
-        std::cout << "Generated " << segments.size() << " segments (" << appended_dummies << " dummies) for layer " << name << ", expected " << expected_segment_count << " (seg.num.x = " << seg.num.x << ", seg.num.y = " << seg.num.y << ", seg_num_in_ch = " << seg_num_in_ch << ", out_dim.ch = " << out_dim.ch << ")\n";
+        NETGEN_LOG::out() << "Generated " << segments.size() << " segments (" << appended_dummies << " dummies) for layer " << name << ", expected " << expected_segment_count << " (seg.num.x = " << seg.num.x << ", seg.num.y = " << seg.num.y << ", seg_num_in_ch = " << seg_num_in_ch << ", out_dim.ch = " << out_dim.ch << ")\n";
         assert(0);
     }
 }
@@ -124,6 +124,56 @@ namespace CNN_LAYER {
         return dma;
     }
 
+    DMA_COMMANDS::DMA_DESCRIPTOR Conv2D::residualLoad(const SEGMENT &segment, int cluster, int unit, int lane, BUFFER buffer) {
+
+        // fused Add: residual tile of the segment's output channel behind the conv result of this lane (result region of the store buffer)
+        // the residual tensor has the dimensions of the conv output but its own MM layout; overcalculated elements read garbage
+        const Dim &res_dim = fused_residual->out_dim;
+
+        DMA_COMMANDS::DMA_DESCRIPTOR dma;
+        dma.dir = e2l2D;
+        dma.cluster = cluster;
+        dma.unit = unit;
+        dma.x_size = seg.out.w;
+        dma.y_size = seg.out.h;
+        dma.lm_addr = int(buffer) * VPRO_CFG::LM_SIZE / 2 + VPRO_CFG::LM_SIZE / 4 + lane * lm_lane_stride + seg.out.w * seg.out.h;
+        dma.mm_addr = res_dim.mm.channel_base[segment.out_channel] +
+                      /* 16 bit elements */ 2 * (segment.x_seg * seg.out.x_stride + segment.y_seg * seg.out.y_stride * res_dim.mm.x);
+        // unsigned leap: a segment wider than the residual's MM rows would wrap around
+        assert(int64_t(res_dim.mm.x) - int64_t(seg.out.w) + 1 >= 1 && "fused Add: segment wider than the residual rows");
+        dma.y_leap = res_dim.mm.x - seg.out.w + 1;
+
+        return dma;
+    }
+
+    bool Conv2D::fuseConsumer(Layer *consumer) {
+        // Conv2D -> Add (residual connection): add the residual tile to the conv result in LM before it is stored
+        // derived layers (MaxPool2D, DConvConv, Conv2DTranspose) have their own compute
+        auto add = dynamic_cast<Add *>(consumer);
+        if (!add || getLayerType() != LAYERTYPE::CONV2 || add->src_layers.size() != 2 || add->src_layers[0] == add->src_layers[1])
+            return false;
+
+        // Add input is the plain conv result; 1D path (parallel_outchannels_per_lane > 1) stores several channels per lane region
+        if (activation != NO_ACTIVATION || pool_size[0] != 1 || upsampling_scale != 1)
+            return false;
+
+        // runtime: _elwise() and activation in L0 only, no RELU6 constant in the conv RF layout
+        if (add->activation != NO_ACTIVATION && add->activation != RECT && add->activation != LEAKY)
+            return false;
+        if (add->pool_size[0] != 1 || add->upsampling_scale != 1)
+            return false;
+
+        // residual tile has the geometry of the conv output tile
+        for (int src_idx = 0; src_idx < 2; src_idx++) {
+            if (add->bc_x(src_idx) || add->bc_y(src_idx) || add->bc_ch(src_idx))
+                return false;
+        }
+
+        fused_add = add;
+        fused_residual = add->src_layers[add->src_layers[0] == this ? 1 : 0];
+        return true;
+    }
+
     void Conv2D::generateCommands() {
         if (kernel_length == 1 && pool_size[0] == 1 && stride == 1 && groups == 1 && parallel_outchannels_per_lane > 1 && upsampling_scale == 1) {
             // former globals from vpro_functions.h, now member variables
@@ -237,6 +287,20 @@ namespace CNN_LAYER {
         std::vector<DMA_COMMANDS::DMA_DESCRIPTOR> dmas_1d, dmas_2d;
         dmas_1d.reserve(2 * VPRO_CFG::parallel_Lanes); // kernel and bias load for each lane
 
+        // fused Add: residual tiles of the last input channel go to the result region shiftStoreVPRO() will switch to for this set
+        // region was last read by the store of the set before the previous one (DMA commands of a cluster execute in order)
+        bool load_residual = false;
+        if (fused_add) {
+            for (unsigned int i = 0; i < VPRO_CFG::parallel_Lanes; i++) {
+                if (!segments[i + seg_cnt]->dummy) {
+                    load_residual = segments[i + seg_cnt]->isLast;
+                    break;
+                }
+            }
+            if (load_residual)
+                fused_store_buffer = (fused_store_buffer == A) ? B : A;
+        }
+
         unsigned int cl = 0, un = 0, ln = 0; // cluster, unit and lane of segment
         for (unsigned int i = 0; i < VPRO_CFG::parallel_Lanes; i++) {
             SEGMENT &segment = *segments[i + seg_cnt];
@@ -251,6 +315,10 @@ namespace CNN_LAYER {
                 if (ln == 0) {
                     dmas_2d.push_back(dataLoad(segment, cl, un, buffer));
                 }
+
+                if (load_residual) {
+                    dmas_2d.push_back(residualLoad(segment, cl, un, ln, fused_store_buffer));
+                }
             }
             next_hardware_element(cl, un, ln);
         }
@@ -321,6 +389,53 @@ namespace CNN_LAYER {
             // transfer result from RF to LM
             cmd_cnt.vpro++;
             commands.push_back(shiftStoreVPRO(mem_layout, store_buffer));
+
+            if (fused_add) {
+                fusedAddVPRO(mem_layout, store_buffer);
+            }
+        }
+    }
+
+    void Conv::fusedAddVPRO(const BIF::COMMAND_VPRO &conv_layout, BUFFER store_buffer) {
+        // result region of each lane in LM: [conv result][residual tile] (residual loaded by Conv2D::load())
+        // the Add kernel occupies L0 (input 0, sum) and L1 (input 1) -> one pass per lane; the sum replaces the conv result
+
+        // no lane sync between the shift store and the Add loads of the same LM words: both run in the LS lane, which
+        // executes its commands in order and reads / writes LM in the same pipeline stage (LSPipeObject::tick_stage(),
+        // stage 5) -> a load never passes an earlier store. The syncs in the activation kernels guard changes of
+        // vpro_mul_h_bit_shift(); the fused Add's LEAKY shift is set once at layer start (conv uses mac_h_bit_shift only)
+
+        for (unsigned int lane = 0; lane < VPRO_CFG::LANES; lane++) {
+            if (!(conv_layout.lane_mask & (1 << lane)))
+                continue;
+
+            BIF::COMMAND_VPRO mem_layout = conv_layout;
+            mem_layout.lane_mask = L0;
+            mem_layout.zend = 0;
+            mem_layout.rf_ch_stride = 0;
+            mem_layout.lm_ch_stride = 0;
+            mem_layout.rf_base = 0;
+            mem_layout.lm_base = int(store_buffer) * VPRO_CFG::LM_SIZE / 2 + VPRO_CFG::LM_SIZE / 4 + lane * lm_lane_stride;
+            mem_layout.shift_right = fused_add->store_shift_right;
+            mem_layout.rf_frac_bits = fused_add->rf_frac_bits;
+
+            BIF::COMMAND_SEGMENT cmd;
+            cmd.vpro = mem_layout;
+            cmd.vpro.command = fused_add->get_vpro_type();
+            cmd.vpro.broadcast_map = 0;
+            commands.push_back(cmd);
+            cmd_cnt.vpro++;
+
+            if (fused_add->activation != NO_ACTIVATION) {
+                commands.push_back(fused_add->activationVPRO(mem_layout));
+                cmd_cnt.vpro++;
+            }
+
+            BUFFER add_buffer = store_buffer; // switched by shiftStoreVPRO(), overridden below
+            cmd = fused_add->shiftStoreVPRO(mem_layout, add_buffer);
+            cmd.vpro.lm_base = mem_layout.lm_base;
+            commands.push_back(cmd);
+            cmd_cnt.vpro++;
         }
     }
 
@@ -331,6 +446,7 @@ namespace CNN_LAYER {
         RF_KERNEL_BASE = RF_DISCARD_ADDR - (kernel_x * kernel_y);
         RF_BIAS_BASE = RF_KERNEL_BASE - 1;
         RF_RELU_6_BASE = RF_BIAS_BASE - 1;
+        fused_store_buffer = A; // same initial store buffer as FusedFunc::generateCommands()
 
         FusedFunc::generateCommands();
     }
@@ -2,6 +2,7 @@
 #define CONV_H
 
 #include "Base/fusedfunc_layer.h"
+#include "Layer_Elwise/elwise_layer.h"
 
 namespace CNN_LAYER {
 
@@ -30,6 +31,8 @@ namespace CNN_LAYER {
       std::stringstream ss;
       ss << FusedFunc::getLayerInfoText();
       ss << "  conv_seg wh " << conv_seg_w << "x" << conv_seg_h << "\n";
+      if (fused_add)
+        ss << "  fused " << fused_add->getFullName() << ", residual input " << fused_residual->getFullName() << "\n";
       return ss.str();
     }
 
@@ -58,13 +61,30 @@ namespace CNN_LAYER {
 
       bl.conv_result_shift_right = result_shift_right;
       bl.bias_shift_right = bias_shift_right;
+
+      if (fused_add) {
+        // runtime applies shifts and activation of the fused Add (see fusedAddVPRO()); LM input 0 is the conv result
+        bool conv_is_src_0 = fused_add->src_layers[0] == this;
+        bl.elwise_0_left_shift = conv_is_src_0 ? fused_add->input_shift_left_0 : fused_add->input_shift_left_1;
+        bl.elwise_1_left_shift = conv_is_src_0 ? fused_add->input_shift_left_1 : fused_add->input_shift_left_0;
+        bl.activation = fused_add->activation;
+        bl.alpha = fused_add->alpha;
+        bl.alpha_mulh_shift_right = fused_add->alpha_mulh_shift_right;
+        bl.relu_6_shift_left = fused_add->rf_frac_bits;
+      }
     }
 
     virtual BIF::COMMAND_SEGMENT convVPRO(const CNN_LAYER::SEGMENT &segment, BUFFER &buffer, uint32_t lane_mask, BIF::COMMAND_VPRO &mem_layout);
     virtual void compute(std::vector<SEGMENT *> &segments, int seg_cnt, BUFFER &buffer, BUFFER &store_buffer);
+    virtual void fusedAddVPRO(const BIF::COMMAND_VPRO &conv_layout, BUFFER store_buffer);
     virtual void generateCommands();
 
   protected:
+    // cross-layer fusion (fuseConsumer()): Add consuming the conv result, computed before the result is stored
+    Elementwise *fused_add{nullptr};
+    Layer *fused_residual{nullptr}; // other input of fused_add, loaded next to the conv result
+    BUFFER fused_store_buffer{A}; // result region of the last set loaded so far (follows shiftStoreVPRO())
+
     Dim conv_out_dim;
     int conv_in_dim_w{0};
     int conv_in_dim_h{0};
@@ -102,6 +122,10 @@ namespace CNN_LAYER {
     virtual void generateSegments();
     virtual void generateCommands();
 
+    virtual bool fuseConsumer(Layer *consumer);
+
+    virtual bool vproLmFootprintFromDma() { return getLayerType() == LAYERTYPE::CONV2; }
+
     virtual void computeOutputDim() {
       // chain: zeropadding - conv - maxpool2x2
 
@@ -188,6 +212,7 @@ namespace CNN_LAYER {
 
     virtual DMA_COMMANDS::DMA_DESCRIPTOR biasLoad(const SEGMENT &segment, int cluster, int unit, int lane, BUFFER buffer);
     virtual DMA_COMMANDS::DMA_DESCRIPTOR kernelLoad(const SEGMENT &segment, int cluster, int unit, int lane, BUFFER buffer);
+    virtual DMA_COMMANDS::DMA_DESCRIPTOR residualLoad(const SEGMENT &segment, int cluster, int unit, int lane, BUFFER buffer);
 
     virtual std::string getLayerInfoText() {
       std::stringstream ss;
@@ -1,10 +1,13 @@
 #include <sys/stat.h> // mkdir
+#include <unistd.h> // getpid
+#include <cstdio> // rename
 #include <set>
 #include "conv_layer.h"
 #include "Base/segment.h"
 #include "vpro_globals.h"
 #include "vpro_cmd_defs.h"
 #include "ConvSegmentationHeuristic/MaxEfficiencyCalculation.h"
+#include "ConvSegmentationHeuristic/SegmentationCostModel.h"
 
 namespace CNN_LAYER
 {
@@ -134,7 +137,18 @@ namespace CNN_LAYER
         // inputs stored in local memory; halved for double buffering
         int lm_free_entries = VPRO_CFG::LM_SIZE / 4 - VPRO_CFG::LANES * n_weights; // each lane computes one output channel
 
-        if (layercfg.segmentation_strategy == DETAILED_HEURISTIC && kernel_length == 1 && pool_size[0] == 1 && stride == 1 && groups == 1 && upsampling_scale == 1 && pre_zp.top == 0 && pre_zp.right == 0 && pre_zp.bottom == 0 && pre_zp.left == 0) {
+        // fused Add: conv result and residual tile share the result region of a lane in LM
+        if (fused_add) {
+            rf_free_entries = std::min(rf_free_entries, lm_lane_stride / 2);
+        }
+
+        bool use_cost_model = layercfg.segmentation_strategy == COST_MODEL;
+        SegmentationCostModel cost_model;
+
+        if ((layercfg.segmentation_strategy == DETAILED_HEURISTIC || use_cost_model) && !fused_add && kernel_length == 1 && pool_size[0] == 1 && stride == 1 && groups == 1 && upsampling_scale == 1 && pre_zp.top == 0 && pre_zp.right == 0 && pre_zp.bottom == 0 && pre_zp.left == 0) {
+            // manual / table parametrizations and the heuristic use X2, COST_MODEL takes the best order of its search
+            SEGMENT_SCHEDULING_ORDER scheduling_order_1d = ITERATE_ALL_SORTED_X2;
+
             // if defined [manual] by layer, use this parametrization
             if (outchannel_parallelism > 0) {    // TODO setting in layer
                 seg.num.x = MaxEfficiencyCalculation::getBlockCount(outchannel_block_size, in_dim(0).mm.x * in_dim(0).y);
@@ -282,23 +296,38 @@ namespace CNN_LAYER
                 assert(overcalc_elements_1d >= 0);
             } else {
                 // check for a cache version
+                // cost model results depend on its parameters -> part of the name
+                char model_key[16] = "";
+                if (use_cost_model)
+                    sprintf(model_key, "_cm%08x", cost_model.parameterHash());
                 char cache_fname[1024];
-                sprintf(cache_fname, "../../cache/conv2d1x1_segmentation_%dc%du%dl_%ldx%dx%d_%d.bin",
-                        VPRO_CFG::CLUSTERS, VPRO_CFG::UNITS, VPRO_CFG::LANES,
+                sprintf(cache_fname, "../../cache/conv2d1x1_segmentation%s_%dc%du%dl_%ldx%dx%d_%d.bin",
+                        model_key, VPRO_CFG::CLUSTERS, VPRO_CFG::UNITS, VPRO_CFG::LANES,
                         in_dim(0).mm.x, in_dim(0).y, in_dim(0).ch, out_dim.ch);
+                // runs in Net::designMmLayoutVpro(), i.e. sequentially; concurrent netgen processes (make -j) may share the cache
                 std::ifstream is(cache_fname, std::ofstream::binary | std::ofstream::in);
-                if (is) {
-#define READ_BIN(DATA) is.read(reinterpret_cast<char *>(&DATA), sizeof(DATA))
+                bool cached = bool(is);
+                if (cached) {
+                    auto seg_before = seg;
+#define READ_BIN(DATA) cached = cached && is.read(reinterpret_cast<char *>(&DATA), sizeof(DATA)).gcount() == sizeof(DATA)
                     READ_BIN(seg);
                     READ_BIN(parallel_outchannels_per_lane);
                     READ_BIN(parallel_inchannels_per_lane);
                     READ_BIN(overcalc_elements_1d);
+                    if (use_cost_model)
+                        READ_BIN(scheduling_order_1d);
                     is.close();
-                } else {
+                    if (!cached) {
+                        std::cout << "Ignoring truncated cache file '" << cache_fname << "'\n";
+                        seg = seg_before;
+                    }
+                }
+                if (!cached) {
                     // evaluate heuristic for most efficient version
-                    setvbuf(stdout, NULL, _IONBF, 0);
-                    auto eval = MaxEfficiencyCalculation(in_dim(0).mm.x, in_dim(0).y, in_dim(0).ch, out_dim.ch, true);
+                    auto eval = MaxEfficiencyCalculation(in_dim(0).mm.x, in_dim(0).y, in_dim(0).ch, out_dim.ch, use_cost_model ? &cost_model : nullptr, true);
                     eval.runCalculation();
+                    if (use_cost_model)
+                        scheduling_order_1d = eval.getSchedulingOrder();
 
                     seg.num.x = eval.getBlockCount();
                     seg.num.y = 1;
@@ -318,22 +347,31 @@ namespace CNN_LAYER
                     overcalc_elements_1d = eval.getOvercalc();
 
                     // save version to cache
+                    // written to a private file and renamed: readers see either no file or a complete one
                     /*int status = */mkdir("../../cache", 0777);//S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
-                    std::ofstream fd(cache_fname, std::ofstream::binary | std::ofstream::out);
+                    char tmp_fname[1100];
+                    sprintf(tmp_fname, "%s.%d.tmp", cache_fname, int(getpid()));
+                    std::ofstream fd(tmp_fname, std::ofstream::binary | std::ofstream::out);
                     if (!fd) {
-                        std::cout << "Could not open cache file '" << cache_fname << "' for writing\n";
+                        std::cout << "Could not open cache file '" << tmp_fname << "' for writing\n";
                     }
 #define WRITE_BIN(DATA) fd.write(reinterpret_cast<char *>(&DATA), sizeof(DATA))
                     WRITE_BIN(seg);
                     WRITE_BIN(parallel_outchannels_per_lane);
                     WRITE_BIN(parallel_inchannels_per_lane);
                     WRITE_BIN(overcalc_elements_1d);
+                    if (use_cost_model)
+                        WRITE_BIN(scheduling_order_1d);
                     fd.close();
+                    if (!fd || std::rename(tmp_fname, cache_fname)) {
+                        std::cout << "Could not write cache file '" << cache_fname << "'\n";
+                        std::remove(tmp_fname);
+                    }
                 }
             }
             
             if (parallel_outchannels_per_lane > 1) {
-                layercfg.scheduling_order = ITERATE_ALL_SORTED_X2;  // TODO: eval, which order is best
+                layercfg.scheduling_order = scheduling_order_1d;
                 conv_seg_w = seg.out.w; // no pool, upsample
                 conv_seg_h = seg.out.h; // no pool, upsample
                 padding.enabled = false; // padding only works for 2D input
@@ -371,6 +409,9 @@ namespace CNN_LAYER
                 double penalty{};
                 double total{}; // sum
             } cost;
+
+            SegmentationCostModel::Estimate estimate; // COST_MODEL only
+            SEGMENT_SCHEDULING_ORDER scheduling_order{ITERATE_ALL_SORTED_OUTC};
         } c, best; // current, lowest cost
 
         best.cost.total = INT_MAX;
@@ -645,6 +686,36 @@ namespace CNN_LAYER
 
                 c.cost.total = c.cost.penalty; // + c.cost.commands + c.cost.dma_in + c.cost.compute + c.cost.dma_out;
 
+                if (use_cost_model) {
+                    SegmentationCostModel::Mapping map;
+                    map.segments = seg.num.x * seg.num.y;
+                    map.seg_in_w = seg.in.w;
+                    map.seg_in_h = seg.in.h;
+                    map.seg_in_x_stride = seg.in.x_stride;
+                    map.seg_compute_elements = conv_seg_w * conv_seg_h;
+                    map.seg_store_elements = seg.out.w * seg.out.h;
+                    map.out_channels = conv_out_dim.ch;
+                    map.in_channels = in_dim(0).ch / groups;
+                    map.ops_per_element = kernel_length_x * kernel_length_y;
+                    map.vpro_commands = 1; // _conv[_add]()
+                    map.post_commands = 1 + int(activation != NO_ACTIVATION) + int(pool_size[0] > 1); // activation, pooling, _shift_store[_upsample]()
+                    map.weights = kernel_length_x * kernel_length_y;
+                    map.weights_per_out = int(use_bias);
+                    map.group_out_channels = conv_out_dim.ch / groups;
+                    map.lanes_per_unit = std::min((int)VPRO_CFG::LANES, map.group_out_channels);
+
+                    // input broadcast to the units of one location (OUTC) vs. kernel broadcast to the units of one channel block (X2)
+                    for (auto order: {ITERATE_ALL_SORTED_OUTC, ITERATE_ALL_SORTED_X2}) {
+                        map.scheduling_order = order;
+                        auto estimate = cost_model.estimate(map);
+                        if (order == ITERATE_ALL_SORTED_OUTC || estimate.total < c.estimate.total) {
+                            c.estimate = estimate;
+                            c.scheduling_order = order;
+                        }
+                    }
+                    c.cost.total = c.estimate.totalClamped();
+                }
+
 #if PRINT_ALL_CAND
                 printf("conv_out %3d x %3d, out %3d x %3d, in %3d x %3d s %3d x %3d, num %3d x %3d, passes %4d, ccpp %5d, cycles %8d, dop %6d, LM %4d/%4d, RF %4d/%4d, cost: commands %8d, dma_in %8d, compute %8d, dma_out %6d, penalty %6d, total %8d\n",
                        conv_seg_w, conv_seg_h,
@@ -678,6 +749,8 @@ namespace CNN_LAYER
         seg = best.seg;
         conv_seg_w = best.conv_seg_w;
         conv_seg_h = best.conv_seg_h;
+        if (use_cost_model)
+            layercfg.scheduling_order = best.scheduling_order;
 
         printf("Best Segmentation [after %i iterations]\n", segmentation_search_count);
         printf("  c.effective_unit_usage:        %f \n", best.effective_unit_usage);
@@ -686,6 +759,9 @@ namespace CNN_LAYER
         printf("  c.effective_pixel_calc_factor: %f \n", best.effective_pixel_calc_factor);
         printf("  seg.num.x: %d, y: %d \n", best.seg.num.x, best.seg.num.y);
         printf("  seg.out.w: %d, h: %d \n", best.seg.out.w, best.seg.out.h);
+        if (use_cost_model)
+            printf("  predicted cycles: %.0f (compute %.0f, dma %.0f, commands %.0f, sets %d, order %d) \n",
+                   best.estimate.total, best.estimate.compute, best.estimate.dma, best.estimate.commands, best.estimate.sets, best.scheduling_order);
 
         // FIXME seg.out is pre-pooling, it should be post-pooling. Currently worked around in conv_commands
 
@@ -2,6 +2,7 @@
 #include "Base/segment.h"
 #include "vpro_globals.h"
 #include "vpro_cmd_defs.h"
+#include "ConvSegmentationHeuristic/SegmentationCostModel.h"
 
 #define DEBUG_SEGMENTATION 0
 
@@ -61,6 +62,9 @@ void Conv2DTranspose::setSegmentDimensions() {
 
     best.cost.total = INT_MAX;
 
+    bool use_cost_model = layercfg.segmentation_strategy == COST_MODEL;
+    SegmentationCostModel cost_model;
+
 #if DEBUG_SEGMENTATION // compiler warning "unused variable"
     // estimate lower bound: output image has to fit into the sum of all RFs
     int min_seg_num = ceil_div(conv_out_dim.x*conv_out_dim.y, rf_free_entries);
@@ -221,6 +225,27 @@ void Conv2DTranspose::setSegmentDimensions() {
 
             c.cost.total = c.unit_usages * seg_area;
 
+            if (use_cost_model) {
+                // one command per output subpixel phase, each output accumulates kernel taps / stride^2 products
+                SegmentationCostModel::Mapping map;
+                map.segments = seg.num.x * seg.num.y;
+                map.seg_in_w = seg.in.w;
+                map.seg_in_h = seg.in.h;
+                map.seg_in_x_stride = seg.in.x_stride;
+                map.seg_compute_elements = seg.out.w * seg.out.h;
+                map.seg_store_elements = seg.out.w * seg.out.h;
+                map.out_channels = conv_out_dim.ch;
+                map.in_channels = in_dim(0).ch / groups;
+                map.ops_per_element = ceil_div(kernel_length_x * kernel_length_y, transpose_conv_stride_x * transpose_conv_stride_y);
+                map.vpro_commands = transpose_conv_stride_x * transpose_conv_stride_y;
+                map.post_commands = 1 + int(activation != NO_ACTIVATION);
+                map.weights = kernel_length_x * kernel_length_y;
+                map.weights_per_out = int(use_bias);
+                map.group_out_channels = conv_out_dim.ch / groups;
+                map.lanes_per_unit = std::min((int)VPRO_CFG::LANES, map.group_out_channels);
+                c.cost.total = cost_model.estimate(map).totalClamped();
+            }
+
             PRINTSEG("; POSSIBLE_SEG: num %2d x %2d, in %2d x %2d stride %2d x %2d, out %2d x %2d stride %2d x %2d, cost %6d: unit_usages %4d, seg_area %4d",
                      seg.num.x, seg.num.y, seg.in.w, seg.in.h, seg.in.x_stride, seg.in.y_stride, seg.out.w, seg.out.h, seg.out.x_stride, seg.out.y_stride,
                      c.cost.total, c.unit_usages, seg_area);
@@ -117,22 +117,22 @@ void DepthToSpace::generateSegments() {
     // sanity check for number of segments
     unsigned int expected_segment_count = seg.num.x * seg.num.y * in_dim(0).ch + appended_dummies;
     if (segments.size() != expected_segment_count) {
-        std::cout << " segments.size()=" << segments.size() << std::endl; 
-        std::cout << " appended_dummies=" << appended_dummies << std::endl;
-        std::cout << " expected_segment_count=" << expected_segment_count << std::endl;
-        std::cout << " out_dim.ch=" << out_dim.ch << std::endl;
-        std::cout << " out_dim.x=" << out_dim.x << std::endl; 
-        std::cout << " out_dim.y=" << out_dim.y << std::endl;
-        std::cout << " in_dim(0).ch=" << in_dim(0).ch << std::endl;
-        std::cout << " in_dim(0).x=" << in_dim(0).x << std::endl; 
-        std::cout << " in_dim(0).y=" << in_dim(0).y << std::endl; 
-        std::cout << " seg.num.y=" << seg.num.y << std::endl; 
-        std::cout << " seg.num.x=" << seg.num.x << std::endl;
-        std::cout << " seg.in.h=" << seg.in.h << std::endl; 
-        std::cout << " seg.in.w=" << seg.in.w << std::endl;
-        std::cout << " seg.out.h=" << seg.out.h << std::endl; 
-        std::cout << " seg.out.w=" << seg.out.w << std::endl;
-        std::cout << std::endl;
+        NETGEN_LOG::out() << " segments.size()=" << segments.size() << std::endl; 
+        NETGEN_LOG::out() << " appended_dummies=" << appended_dummies << std::endl;
+        NETGEN_LOG::out() << " expected_segment_count=" << expected_segment_count << std::endl;
+        NETGEN_LOG::out() << " out_dim.ch=" << out_dim.ch << std::endl;
+        NETGEN_LOG::out() << " out_dim.x=" << out_dim.x << std::endl; 
+        NETGEN_LOG::out() << " out_dim.y=" << out_dim.y << std::endl;
+        NETGEN_LOG::out() << " in_dim(0).ch=" << in_dim(0).ch << std::endl;
+        NETGEN_LOG::out() << " in_dim(0).x=" << in_dim(0).x << std::endl; 
+        NETGEN_LOG::out() << " in_dim(0).y=" << in_dim(0).y << std::endl; 
+        NETGEN_LOG::out() << " seg.num.y=" << seg.num.y << std::endl; 
+        NETGEN_LOG::out() << " seg.num.x=" << seg.num.x << std::endl;
+        NETGEN_LOG::out() << " seg.in.h=" << seg.in.h << std::endl; 
+        NETGEN_LOG::out() << " seg.in.w=" << seg.in.w << std::endl;
+        NETGEN_LOG::out() << " seg.out.h=" << seg.out.h << std::endl; 
+        NETGEN_LOG::out() << " seg.out.w=" << seg.out.w << std::endl;
+        NETGEN_LOG::out() << std::endl;
         assert(0);
     }
 
@@ -82,6 +82,9 @@ public:
   
   virtual void generateCommands();
 
+  // inputs are reloaded for every set, result in the store quarter
+  virtual bool vproLmFootprintFromDma() { return true; }
+
   virtual DMA_COMMANDS::DMA_DESCRIPTOR dataLoad(const SEGMENT &segment, int cluster, int unit, BUFFER &buffer, int source/*=0*/);
   virtual void load(std::vector<SEGMENT *> &segments, int seg_cnt, BUFFER &buffer);
   virtual void compute(std::vector<SEGMENT *> &segments, int seg_cnt, BUFFER &buffer, BUFFER &store_buffer);
@@ -1,6 +1,7 @@
  #include "elwise_layer.h"
  #include "Base/segment.h"
  #include "vpro_globals.h"
+#include "ConvSegmentationHeuristic/SegmentationCostModel.h"
 
 namespace CNN_LAYER {
 
@@ -32,6 +33,38 @@ void Elementwise::setSegmentDimensions() {
 
     seg.out.w = ceil_div(out_dim.x, seg.num.x);
     seg.out.h = ceil_div(out_dim.y, seg.num.y);
+
+    if (layercfg.segmentation_strategy == COST_MODEL) {
+        // search all segment sizes within the limits above; few large segments are not always fastest (unused lanes in the last set)
+        SegmentationCostModel cost_model;
+        SegmentationCostModel::Mapping map;
+        map.out_channels = out_dim.ch;
+        map.inputs = (int)src_layers.size();
+        map.ops_per_element = 0; // operation after loading all inputs
+        map.vpro_commands = 0;
+        map.post_commands = 2; // add/mul, store
+        map.group_out_channels = 1;
+        double best_total = -1;
+        for (int w = 1; w <= std::min(rf_out_seg_max, out_dim.x); w++) {
+            for (int h = 1; h <= std::min(rf_out_seg_max, out_dim.y); h++) {
+                int num_x = std::max(ceil_div(out_dim.x, w), ceil_div(in_dim(0).x, lm_in_seg_max));
+                int num_y = std::max(ceil_div(out_dim.y, h), ceil_div(in_dim(0).y, lm_in_seg_max));
+                map.segments = num_x * num_y;
+                map.seg_in_w = map.seg_in_x_stride = w;
+                map.seg_in_h = h;
+                map.seg_compute_elements = map.seg_store_elements = w * h;
+                auto estimate = cost_model.estimate(map);
+                if (best_total < 0 || estimate.total < best_total) {
+                    best_total = estimate.total;
+                    seg.num.x = num_x;
+                    seg.num.y = num_y;
+                    seg.out.w = w;
+                    seg.out.h = h;
+                }
+            }
+        }
+    }
+
     seg.in.w = seg.out.w;
     seg.in.h = seg.out.h;
  }
@@ -1,6 +1,8 @@
 #ifndef GLOBALPOOL_LAYER_H
 #define GLOBALPOOL_LAYER_H
 
+#include <mutex>
+
 #include "vpro_globals.h"
 #include "vpro_cmd_defs.h"
 #include "bif.h"
@@ -81,14 +83,14 @@ namespace CNN_LAYER {
 
         // is i factorizable into x, y, z with 1<=x<=63, 1<=y<=63, 1<=z<=1023?
         static bool factorize(int i, int &x, int &y, int &z) {
-            static bool initialized = false;
+            static std::once_flag initialized; // thread-safe: commands of layers may be generated concurrently
             static int max_i;
             static std::vector<bool> factorizable;
             static std::vector<int> x_tab;
             static std::vector<int> y_tab;
             static std::vector<int> z_tab;
     
-            if (!initialized) {
+            std::call_once(initialized, []() {
                 // precompute tables
                 max_i = VPRO_CFG::LM_SIZE / 2;
                 factorizable = std::vector<bool>(max_i+1, false);
@@ -111,8 +113,7 @@ namespace CNN_LAYER {
                         }
                     }
                 }
-                initialized = true;
-            }
+            });
 
             assert(i <= max_i);
 
@@ -2,6 +2,7 @@
 #include "Base/segment.h"
 #include "vpro_globals.h"
 #include "vpro_cmd_defs.h"
+#include "ConvSegmentationHeuristic/SegmentationCostModel.h"
 
 namespace CNN_LAYER {
 
@@ -42,6 +43,9 @@ void AveragePooling2D::setSegmentDimensions() {
 
     best.cost.total = INT_MAX;
 
+    bool use_cost_model = layercfg.segmentation_strategy == COST_MODEL;
+    SegmentationCostModel cost_model;
+
 #if PRINT_ALL_CAND || PRINT_BEST_CAND
     std::cout << "segment dimensions for layer " << getFullName() << " " << src_layers[0]->out_dim.algoStr() << " -> " << out_dim.algoStr() << ", kernel " << pool_size[0] << "x" << pool_size[1] << ":\n";
 #endif
@@ -164,6 +168,23 @@ void AveragePooling2D::setSegmentDimensions() {
 
 
             c.cost.total = c.cost.commands + c.cost.dma_in + c.cost.compute + c.cost.dma_out + c.cost.penalty;
+
+            if (use_cost_model) {
+                // depthwise: each output channel has its own input -> one lane per unit
+                SegmentationCostModel::Mapping map;
+                map.segments = seg.num.x * seg.num.y;
+                map.seg_in_w = seg.in.w;
+                map.seg_in_h = seg.in.h;
+                map.seg_in_x_stride = seg.in.x_stride;
+                map.seg_compute_elements = seg.out.w * seg.out.h;
+                map.seg_store_elements = seg.out.w * seg.out.h;
+                map.out_channels = out_dim.ch;
+                map.ops_per_element = pool_size[0] * pool_size[1];
+                map.post_commands = 2; // divide, store
+                map.weights_per_out = size_div_map; // divisor map
+                map.group_out_channels = 1;
+                c.cost.total = cost_model.estimate(map).totalClamped();
+            }
             
 
 #if PRINT_ALL_CAND
@@ -0,0 +1,29 @@
+#!/usr/bin/env python3
+# weights and input of the residualtest nets (fixed seed, reproducible)
+# weights/lNNN_weights.bin: int16 kernels followed by the bias per output channel (Conv2D::expectedWeightCount())
+# input/l-01.bin: int16 input image, chw
+
+import os
+import random
+import struct
+
+random.seed(2024)
+
+# layer number: (out channels, in channels, kernel length)
+convs = {0: (8, 4, 3), 1: (8, 8, 1), 3: (4, 8, 3)}
+input_shape = (4, 40, 40)
+
+
+def write(path, values):
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    with open(path, "wb") as f:
+        f.write(struct.pack("<%dh" % len(values), *values))
+
+
+for number, (outc, inc, k) in convs.items():
+    kernels = [random.randint(-8, 8) for _ in range(outc * inc * k * k)]
+    bias = [random.randint(-64, 64) for _ in range(outc)]
+    write("weights/l%03d_weights.bin" % number, kernels + bias)
+
+ch, h, w = input_shape
+write("input/l-01.bin", [random.randint(-128, 127) for _ in range(ch * h * w)])
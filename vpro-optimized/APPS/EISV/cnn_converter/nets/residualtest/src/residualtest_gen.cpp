@@ -0,0 +1,9 @@
+#include "residualtest_net.h"
+
+int main(int argc, char *argv[]) {
+
+  ResidualtestNet *cnn = new ResidualtestNet();
+
+  cnn->generateNet();
+  
+}
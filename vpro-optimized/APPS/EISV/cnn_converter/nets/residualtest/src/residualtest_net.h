@@ -0,0 +1,87 @@
+#ifndef RESIDUALTEST_NET_H
+#define RESIDUALTEST_NET_H
+
+#include "layers.h"
+#include "base_net.h"
+
+// residual block: Conv2D -> Conv2D -> Add (residual from the first conv) -> Conv2D
+// weights and input: gen_data.py (fixed seed)
+// residualtest_fused / residualtest_overlap: same net with fused and layer-overlapped / only layer-overlapped command
+// generation, must produce identical results (make verify_fusion)
+class ResidualtestNet : public CNN_NET::Net {
+
+public:
+
+  ResidualtestNet(const std::string &name = "RESIDUALTEST") : CNN_NET::Net(name) {}
+
+  virtual void instantiateLayers() {
+
+    // input layer
+    auto in = new CNN_LAYER::Input;
+    in->name = "input";
+    in->number = -1;
+    in->out_dim.x = 40;
+    in->out_dim.y = 40;
+    in->out_dim.ch = 4;
+    addLayer(in);
+
+    //// Layer 0: residual source
+    auto l0 = new CNN_LAYER::Conv2D;
+    l0->name = "L0";
+    l0->number = 0;
+    l0->addSrcLayers({in});
+    l0->out_dim.ch = 8;
+    l0->kernel_length = 3;
+    l0->activation = RECT;
+    l0->use_bias = true;
+    l0->result_shift_right = 2;
+    l0->processParams();
+    l0->loadQuantData();
+    addLayer(l0);
+
+    //// Layer 1: fused with layer 2 if fuse_layers
+    auto l1 = new CNN_LAYER::Conv2D;
+    l1->name = "L1";
+    l1->number = 1;
+    l1->addSrcLayers({l0});
+    l1->out_dim.ch = 8;
+    l1->kernel_length = 1;
+    l1->use_bias = true;
+    l1->result_shift_right = 6;
+    l1->processParams();
+    l1->loadQuantData();
+    addLayer(l1);
+
+    //// Layer 2: residual connection (no result: fused layers do not write their output)
+    auto l2 = new CNN_LAYER::Add;
+    l2->name = "L2";
+    l2->number = 2;
+    l2->addSrcLayers({l0, l1});
+    l2->input_shift_left_0 = 1;
+    l2->input_shift_left_1 = 0;
+    l2->activation = LEAKY;
+    l2->alpha = 26;
+    l2->alpha_mulh_shift_right = 8;
+    l2->store_shift_right = 1;
+    l2->processParams();
+    addLayer(l2);
+
+    //// Layer 3
+    auto l3 = new CNN_LAYER::Conv2D;
+    l3->name = "L3";
+    l3->number = 3;
+    l3->addSrcLayers({l2});
+    l3->out_dim.ch = 4;
+    l3->kernel_length = 3;
+    l3->use_bias = true;
+    l3->result_shift_right = 4;
+    l3->out_is_result = true;
+    l3->processParams();
+    l3->loadQuantData();
+    addLayer(l3);
+
+  }
+
+}; // class ResidualtestNet
+
+#endif // RESIDUALTEST_NET_H
@@ -0,0 +1,22 @@
+// nets/residualtest with layer fusion (Conv2D -> Add) and layer boundary overlap
+// weights and input are the ones of residualtest (symlinks), results must match it (make verify_fusion)
+#include "../../residualtest/src/residualtest_net.h"
+
+class ResidualtestFusedNet : public ResidualtestNet {
+
+public:
+
+  ResidualtestFusedNet() : ResidualtestNet("RESIDUALTEST_FUSED") {
+    fuse_layers = true;
+    overlap_layers = true;
+  }
+
+}; // class ResidualtestFusedNet
+
+int main(int argc, char *argv[]) {
+
+  ResidualtestFusedNet *cnn = new ResidualtestFusedNet();
+
+  cnn->generateNet();
+  
+}
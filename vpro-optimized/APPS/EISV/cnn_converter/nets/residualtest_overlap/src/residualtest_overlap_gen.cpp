@@ -0,0 +1,21 @@
+// nets/residualtest with layer boundary overlap only (no fusion)
+// weights and input are the ones of residualtest (symlinks), results must match it (make verify_fusion)
+#include "../../residualtest/src/residualtest_net.h"
+
+class ResidualtestOverlapNet : public ResidualtestNet {
+
+public:
+
+  ResidualtestOverlapNet() : ResidualtestNet("RESIDUALTEST_OVERLAP") {
+    overlap_layers = true;
+  }
+
+}; // class ResidualtestOverlapNet
+
+int main(int argc, char *argv[]) {
+
+  ResidualtestOverlapNet *cnn = new ResidualtestOverlapNet();
+
+  cnn->generateNet();
+  
+}
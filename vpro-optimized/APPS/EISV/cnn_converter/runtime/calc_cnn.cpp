@@ -14,18 +14,22 @@ char completeVersion[] = {
         ':', BUILD_MIN_CH0, BUILD_MIN_CH1, ':', BUILD_SEC_CH0, BUILD_SEC_CH1, '\0'
 };
 
-uint64_t calcCnn(BIF::NET *bnet, bool per_layer_stats) {
+uint64_t calcCnn(BIF::NET *bnet, bool per_layer_stats, unsigned int first_layer, uint64_t first_clock) {
   printf("=================== CNN execution from binary ===================\n");
 
-  uint64_t totalclock = 0;
-  aux_reset_all_stats();
+  uint64_t totalclock = first_clock;
+  if (first_layer == 0) {
+    aux_reset_all_stats();
+  } else {  // the stats are part of the checkpoint
+    printf("Resumed after layer_execlist[%3d] (Risc Clock Accumulated: %" PRId64 ")\n", first_layer - 1, totalclock);
+  }
 
   assert((bnet->magicword == BIF::net_magicword) && "Magicword mismatch");
   // layer execution list
   if (per_layer_stats) {
     printf("layers = %d\n", bnet->layer_execlist_count);
   }
-  for (unsigned int xli = 0; xli < bnet->layer_execlist_count; xli++) { // eXecution-List Index
+  for (unsigned int xli = first_layer; xli < bnet->layer_execlist_count; xli++) { // eXecution-List Index
     unsigned int lbi = ((uint32_t*)(((uint8_t*)bnet) + (bnet->layer_execlist_offs)))[xli];
     assert((lbi < bnet->layer_count) && "Layer execution list entry is larger than number of available layers");
 
@@ -49,6 +53,7 @@ uint64_t calcCnn(BIF::NET *bnet, bool per_layer_stats) {
       uint32_t startclock = aux_get_CNT_RISC_TOTAL();
     calcLayer(*layer, commandSegments, layer->command_segments_count);
     vpro_sync();    // make shure sync is really done (double sync), as sync is not blocking any more (Sync Feature Update, 09.2023)
+    // also completes the first loads of the next layer issued in this layer's tail (netgen OVERLAP_LAYERS), its initial DMA wait may be omitted
 
 //    // flush after last layer
 //    if (xli == bnet->layer_execlist_count - 1)
@@ -65,6 +70,9 @@ uint64_t calcCnn(BIF::NET *bnet, bool per_layer_stats) {
       printf("Stats have been reset before this Layer!\n");
       printf("\tRisc Clock\t Layer: %" PRId32 ", \tAccumulated: %" PRId64 "\n", endclock - startclock, totalclock);
     }
+
+    // ISS: checkpoint after this layer (--checkpoint-layer)
+    sim_checkpoint_layer(xli + 1, totalclock);
   }
 
   return totalclock;
@@ -24,7 +24,11 @@ enum ARM_RV_Comm : uint32_t {
 void pre_layer_hook(int layer_exec_idx, int total_layers, const BIF::LAYER *layer);
 void post_layer_hook(int layer_exec_idx, int total_layers, const BIF::LAYER *layer);
 
-uint64_t calcCnn(BIF::NET *bnet, bool per_layer_stats);
+/**
+ * executes the layers of the execution list, starting with first_layer (resumed from an ISS checkpoint,
+ * first_clock: accumulated clock of the layers before)
+ */
+uint64_t calcCnn(BIF::NET *bnet, bool per_layer_stats, unsigned int first_layer = 0, uint64_t first_clock = 0);
 
 void print_cnn_stats(uint64_t totalclock, unsigned int clockfreq_mhz);
 
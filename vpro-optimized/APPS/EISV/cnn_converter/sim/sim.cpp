@@ -1,6 +1,11 @@
 
 #include <stdint.h>
+#include <cstring>
+#include <fstream>
+#include <sstream>
 #include <string>
+#include <vector>
+#include <QDir>
 #include "riscv/eisV_hardware_info.hpp"
 #include "vpro_functions.h"
 #include "segment_scheduling.h"
@@ -35,6 +40,80 @@ void post_layer_hook(int layer_exec_idx, int total_layers, const BIF::LAYER *lay
 }
 
 
+/**
+ * Batch mode (--batch=<list file>): the process, the loaded weights and the eisvblob stay resident,
+ * one inference is executed for each line of the list: <input dir> [<output dir>]
+ *  - input.cfg files below batch_input_prefix are reloaded from <input dir> (other entries are kept)
+ *  - output.cfg files below batch_output_prefix are dumped to <output dir> (default: <input dir>)
+ */
+const char batch_input_prefix[] = "../input/";
+const char batch_output_prefix[] = "../sim_results/";
+
+struct BatchEntry {
+    std::string input_dir;
+    std::string output_dir;
+};
+
+std::vector<BatchEntry> read_batch_list(const char *list_file) {
+    std::vector<BatchEntry> entries;
+    std::ifstream list(list_file);
+    if (!list) {
+        printf_error("Batch list could not be opened! [File: %s]\n", list_file);
+        return entries;
+    }
+    std::string line;
+    while (std::getline(list, line)) {
+        std::istringstream items(line);
+        BatchEntry entry;
+        if (!(items >> entry.input_dir) || entry.input_dir[0] == '#' || entry.input_dir[0] == ';')
+            continue;
+        if (!(items >> entry.output_dir))
+            entry.output_dir = entry.input_dir;
+        entries.push_back(entry);
+    }
+    return entries;
+}
+
+void run_batch(BIF::NET *net, const char *list_file, unsigned int clockfreq_mhz) {
+    auto entries = read_batch_list(list_file);
+    uint64_t clock_sum = 0, clock_min = UINT64_MAX, clock_max = 0;
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        const auto &entry = entries[i];
+        printf("=================== Batch inference %zu / %zu: %s ===================\n",
+               i + 1, entries.size(), entry.input_dir.c_str());
+
+        // swap the input region only
+        core_->loadMemoryConfig(core_->getInputConfig(), batch_input_prefix,
+                                QString::fromStdString(entry.input_dir + "/"));
+
+        // reset DCMA to load new input into cache
+        dcma_reset();
+
+        uint64_t totalclock = calcCnn(net, RV_PRINT_LAYER_CYCLE_DETAILS);
+
+        // include dcma flush cycles in profiling, main memory is consistent afterwards
+        dcma_flush();
+
+        print_cnn_stats(totalclock, clockfreq_mhz);
+
+        QDir().mkpath(QString::fromStdString(entry.output_dir));
+        core_->dumpMemoryConfig(core_->getOutputConfig(), batch_output_prefix,
+                                QString::fromStdString(entry.output_dir + "/"));
+
+        clock_sum += totalclock;
+        clock_min = std::min(clock_min, totalclock);
+        clock_max = std::max(clock_max, totalclock);
+    }
+
+    printf("=================== Batch completed ===================\n");
+    printf("\tInferences: %zu\n", entries.size());
+    if (!entries.empty()) {
+        printf("\tRisc-V Clock Cycles: avg %" PRIu64 ", min %" PRIu64 ", max %" PRIu64 "\n",
+               clock_sum / entries.size(), clock_min, clock_max);
+    }
+}
+
 //----------------------------------------------------------------------------------
 //----------------------------------Main--------------------------------------------
 //----------------------------------------------------------------------------------
@@ -42,6 +121,12 @@ void post_layer_hook(int layer_exec_idx, int total_layers, const BIF::LAYER *lay
 int main(int argc, char *argv[]) {
     sim_init(main, argc, argv);
 
+    const char *batch_list = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--batch=", 8) == 0)
+            batch_list = argv[i] + 8;
+    }
+
     aux_print_hardware_info("CNN sim", versionVersion, completeVersion);
 
     // check HW config of this cnn's App config
@@ -71,22 +156,35 @@ int main(int argc, char *argv[]) {
       
     }
 
-    vpro_set_cluster_mask(0xFFFFFFFF);
-    vpro_set_unit_mask(0xFFFFFFFF);
+    // --checkpoint-restore=<file>: continue after the layers done in the checkpoint, the ISS state includes
+    // the setup below
+    uint64_t resume_clock = 0;
+    uint32_t resume_layer = sim_checkpoint_resume(&resume_clock);
 
-    initOvercalcMemSim();
+    if (resume_layer == 0) {
+        vpro_set_cluster_mask(0xFFFFFFFF);
+        vpro_set_unit_mask(0xFFFFFFFF);
 
-    // reset DCMA to load new input into cache
-    dcma_reset();
-        
-    uint64_t totalclock = calcCnn(net, RV_PRINT_LAYER_CYCLE_DETAILS);
+        initOvercalcMemSim();
+    }
 
-    // include dcma flush cycles in profiling
-    dcma_flush();
-    
     unsigned int clockfreq_mhz = int(1000 / core_->getRiscClockPeriod());
-    print_cnn_stats(totalclock, clockfreq_mhz);
-    
+
+    if (batch_list != nullptr) {
+        run_batch(net, batch_list, clockfreq_mhz);
+    } else {
+        // reset DCMA to load new input into cache (a checkpoint includes the DCMA content)
+        if (resume_layer == 0)
+            dcma_reset();
+
+        uint64_t totalclock = calcCnn(net, RV_PRINT_LAYER_CYCLE_DETAILS, resume_layer, resume_clock);
+
+        // include dcma flush cycles in profiling
+        dcma_flush();
+
+        print_cnn_stats(totalclock, clockfreq_mhz);
+    }
+
 
     aux_print_debugfifo(0xbeefdead);
     aux_print_debugfifo(0xbeef0000); // really dead!
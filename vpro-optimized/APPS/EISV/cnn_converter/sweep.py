@@ -0,0 +1,241 @@
+#!/usr/bin/python3
+# Design-space sweep: run one net (nets/<net>) on a grid of hardware configurations
+#
+# Each configuration gets its own netgen/sim build dir (kept in <out>/build, built by the Makefile targets
+# build_<net>_gen / <build dir>/sim, rebuilt incrementally on the next sweep) and its own run dir
+# (<out>/runs/<config>, links to the nets inputs).
+# Builds, then netgen + sim runs are distributed over all cores. The statistics json of each run
+# (sim_exit, ../statistics/statistics_detail_*.json) is collected into <out>/sweep.csv
+#
+# Examples:
+#   ./sweep.py yololite --clusters 1 2 4 8 --units 1 2 4 8
+#   ./sweep.py testlayer --line-size 1024 4096 --associativity 2 4 8 -j 32
+#   ./sweep.py yololite --clusters 2 4 8 --runtime-config  # one sim binary for all points (per LANES)
+
+import argparse
+import csv
+import glob
+import itertools
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+from concurrent.futures import ThreadPoolExecutor
+
+# hardware parameters: name, command line option, Makefile variable, sim run-time option (None: compile-time only), default (see Makefile)
+PARAMETERS = [
+    ("clusters", "--clusters", "CLUSTERS", "--clusters", 8),
+    ("units", "--units", "UNITS", "--units", 8),
+    ("lanes", "--lanes", "LANES", None, 2),
+    ("nr_rams", "--nr-rams", "NR_RAMS", "--dcma-nr-rams", 8),
+    ("line_size", "--line-size", "LINE_SIZE", "--dcma-line-size", 4096),
+    ("associativity", "--associativity", "ASSOCIATIVITY", "--dcma-associativity", 8),
+    ("ram_size", "--ram-size", "RAM_SIZE", "--dcma-ram-size", 524288),
+]
+# build / run dir names, e.g. 8c8u2l_8r4096ls8a524288rs
+KEY_TAGS = {"clusters": "c", "units": "u", "lanes": "l", "nr_rams": "r", "line_size": "ls",
+            "associativity": "a", "ram_size": "rs"}
+VPRO_PARAMETERS = ["clusters", "units", "lanes"]
+
+# created by netgen / sim in each run dir (everything else of nets/<net> is linked)
+RUN_OUTPUTS = ["generated", "sim_results", "statistics", "emu_results"]
+# contain checked-in scripts + files generated by netgen -> copied
+RUN_COPIES = ["init", "exit"]
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+
+
+def config_key(point, names=None):
+    names = names or [p[0] for p in PARAMETERS]
+    vpro = "".join("%d%s" % (point[n], KEY_TAGS[n]) for n in names if n in VPRO_PARAMETERS)
+    dcma = "".join("%d%s" % (point[n], KEY_TAGS[n]) for n in names if n not in VPRO_PARAMETERS)
+    return "_".join(k for k in [vpro, dcma] if k)
+
+
+def make_variables(point, names=None):
+    names = names or [p[0] for p in PARAMETERS]
+    return ["%s=%d" % (p[2], point[p[0]]) for p in PARAMETERS if p[0] in names]
+
+
+def run_logged(cmd, log, cwd=None):
+    """ executes cmd, appends stdout+stderr to log. returns True on success """
+    with open(log, "a") as f:
+        f.write("$ " + " ".join(cmd) + "\n")
+        f.flush()
+        return subprocess.run(cmd, cwd=cwd, stdout=f, stderr=subprocess.STDOUT).returncode == 0
+
+
+def build(target, build_dir, variables, make_jobs, debug):
+    """ one netgen / sim configuration by the Makefile target (build_<net>_gen, <build dir>/sim) """
+    os.makedirs(build_dir, exist_ok=True)
+    log = os.path.join(build_dir, "build.log")
+    open(log, "w").close()
+    cmd = ["make", "-s", "-j%d" % make_jobs, "-C", SCRIPT_DIR, target] + variables
+    cmd += ["DEBUG=%d" % (1 if debug else 0)]
+    ok = run_logged(cmd, log)
+    if not ok:
+        print("[sweep] build FAILED: %s (see %s)" % (build_dir, log))
+    return ok
+
+
+def prepare_run_dir(net_dir, run_dir):
+    os.makedirs(run_dir, exist_ok=True)
+    for entry in os.listdir(net_dir):
+        src = os.path.join(net_dir, entry)
+        dst = os.path.join(run_dir, entry)
+        if not os.path.isdir(src) or entry in RUN_OUTPUTS or os.path.lexists(dst):
+            continue
+        if entry in RUN_COPIES:
+            shutil.copytree(src, dst)
+        else:
+            os.symlink(os.path.abspath(src), dst)
+    for entry in RUN_OUTPUTS:
+        os.makedirs(os.path.join(run_dir, entry), exist_ok=True)
+
+
+def run_point(args, point, netgen_exe, sim_exe):
+    """ netgen + sim of one configuration in it's own run dir. returns the statistics json file (or None) """
+    key = config_key(point)
+    run_dir = os.path.join(args.out, "runs", key)
+    results = glob.glob(os.path.join(run_dir, "statistics", "*.json"))
+    if results and not args.rerun:
+        return results[0]
+
+    prepare_run_dir(os.path.join(SCRIPT_DIR, "nets", args.net), run_dir)
+    for f in glob.glob(os.path.join(run_dir, "statistics", "*.json")):
+        os.remove(f)
+    log = os.path.join(run_dir, "sweep.log")
+    open(log, "w").close()
+
+    # cwd required for netgen to find it's input files
+    if not run_logged([netgen_exe], log, cwd=run_dir):
+        print("[sweep] netgen FAILED: %s (see %s)" % (key, log))
+        return None
+
+    sim_cmd = [sim_exe, "--windowless"]
+    if args.runtime_config:
+        sim_cmd += ["%s=%d" % (p[3], point[p[0]]) for p in PARAMETERS if p[3] is not None]
+    if not run_logged(sim_cmd, log, cwd=os.path.join(run_dir, "sim_results")):
+        print("[sweep] sim FAILED: %s (see %s)" % (key, log))
+        return None
+
+    results = glob.glob(os.path.join(run_dir, "statistics", "*.json"))
+    if not results:
+        print("[sweep] no statistics: %s (see %s)" % (key, log))
+        return None
+    print("[sweep] done: %s" % key)
+    return results[0]
+
+
+def load_statistics(filename):
+    with open(filename) as f:
+        text = f.read()
+    # QTextStream prints nan/inf for counters without any access
+    text = re.sub(r"(?<=:)\s*-?(nan|inf)\b", "null", text)
+    return json.loads(text)
+
+
+def table_row(point, stats):
+    row = dict(point)
+    if stats is None:
+        row["status"] = "failed"
+        return row
+    row["status"] = "ok"
+    risc = stats.get("risc", {})
+    vpro = stats.get("vpro", {})
+    dma = stats.get("dma", {})
+    dcma = stats.get("dcma", {})
+    row["risc_cycles"] = risc.get("total_ticks")
+    row["vpro_cycles"] = vpro.get("total_ticks")
+    if vpro.get("total_ticks") is not None and vpro.get("clock_period") is not None:
+        row["runtime_ns"] = vpro["total_ticks"] * vpro["clock_period"]
+    for lane in ["L0", "L1", "LS"]:
+        if lane in vpro:
+            row[lane + "_architecture_utilization"] = vpro[lane].get("architecture_utilization")
+            row[lane + "_algorithm_utilization"] = vpro[lane].get("algorithm_utilization")
+    row["dma_architecture_utilization"] = dma.get("architecture_utilization")
+    row["dma_algorithm_utilization"] = dma.get("algorithm_utilization")
+    row["dcma_read_hit_rate"] = dcma.get("read_hit_rate")
+    row["dcma_write_hit_rate"] = dcma.get("write_hit_rate")
+    return row
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Run a net on a grid of VPRO / DCMA configurations")
+    parser.add_argument("net", help="subdir of nets/")
+    for name, option, _, _, default in PARAMETERS:
+        parser.add_argument(option, dest=name, type=int, nargs="+", default=[default],
+                            help="list of values (default: %d)" % default)
+    parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count(), help="parallel jobs (default: all cores)")
+    parser.add_argument("-o", "--out", default="sweep", help="build, run and result dir (default: sweep)")
+    parser.add_argument("--runtime-config", action="store_true",
+                        help="build the sim once per LANES, pass the configuration on it's command line")
+    parser.add_argument("--rerun", action="store_true", help="run points that already have a result again")
+    parser.add_argument("--debug", action="store_true", help="debug builds of netgen and sim")
+    args = parser.parse_args()
+
+    if not os.path.isdir(os.path.join(SCRIPT_DIR, "nets", args.net)):
+        print("[sweep] net %s not found in nets/" % args.net)
+        return 1
+    args.out = os.path.abspath(args.out)
+
+    names = [p[0] for p in PARAMETERS]
+    points = [dict(zip(names, values)) for values in itertools.product(*[getattr(args, n) for n in names])]
+    print("[sweep] %s: %d configurations, %d jobs" % (args.net, len(points), args.jobs))
+
+    # builds: netgen per configuration, sim per configuration (or per LANES with run-time configuration)
+    sim_names = ["lanes"] if args.runtime_config else names
+    builds = {}
+    for point in points:
+        netgen_dir = os.path.join(args.out, "build", "netgen_" + config_key(point))
+        builds[netgen_dir] = ("build_%s_gen" % args.net,
+                              make_variables(point) + ["BUILD_NETGEN=" + netgen_dir, "RLD=0"])
+        sim_dir = os.path.join(args.out, "build", "sim_" + config_key(point, sim_names))
+        builds[sim_dir] = (os.path.join(sim_dir, "sim"),
+                           make_variables(point, sim_names) + ["BUILD_SIM=" + sim_dir,
+                                                               "RUNTIME_CONFIG=%d" % (1 if args.runtime_config else 0)])
+
+    make_jobs = max(1, args.jobs // len(builds))
+    with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        futures = {d: pool.submit(build, t, d, v, make_jobs, args.debug) for d, (t, v) in builds.items()}
+        built = {d: f.result() for d, f in futures.items()}
+
+    # netgen + sim runs
+    def run(point):
+        netgen_dir = os.path.join(args.out, "build", "netgen_" + config_key(point))
+        sim_dir = os.path.join(args.out, "build", "sim_" + config_key(point, sim_names))
+        if not built[netgen_dir] or not built[sim_dir]:
+            return None
+        return run_point(args, point, os.path.join(netgen_dir, args.net + "_gen"), os.path.join(sim_dir, "sim"))
+
+    with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        results = list(pool.map(run, points))
+
+    rows = []
+    for point, result in zip(points, results):
+        stats = None
+        if result is not None:
+            try:
+                stats = load_statistics(result)
+            except (OSError, ValueError) as e:
+                print("[sweep] invalid statistics %s: %s" % (result, e))
+        rows.append(table_row(point, stats))
+
+    columns = []
+    for row in rows:
+        columns += [c for c in row if c not in columns]
+    table = os.path.join(args.out, "sweep.csv")
+    with open(table, "w", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=columns)
+        writer.writeheader()
+        writer.writerows(rows)
+
+    failed = sum(1 for r in rows if r["status"] != "ok")
+    print("[sweep] %d/%d configurations ok, table: %s" % (len(rows) - failed, len(rows), table))
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
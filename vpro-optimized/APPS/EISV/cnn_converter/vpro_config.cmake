@@ -33,6 +33,27 @@ endif(NOT DEFINED RAM_SIZE)
 
 set(VPRO_CONFIG_SWITCHES -DCONF_LANES=${LANES} -DCONF_UNITS=${UNITS} -DCONF_CLUSTERS=${CLUSTERS} -DCONF_DCMA_NR_RAMS=${NR_RAMS} -DCONF_DCMA_LINE_SIZE=${LINE_SIZE} -DCONF_DCMA_ASSOCIATIVITY=${ASSOCIATIVITY} -DCONF_DCMA_RAM_SIZE=${RAM_SIZE})
 
+# run-time hardware configuration of the simulator (values above are the defaults, see VPRO_CFG)
+if(RUNTIME_CONFIG)
+    list(APPEND VPRO_CONFIG_SWITCHES -DCONF_RUNTIME=1)
+    message(STATUS "[VPRO config] RUNTIME_CONFIG: set by the sim command line")
+endif()
+
+# per-cycle debug options of the simulator in release builds (see INSTRUMENTED_BUILD)
+if(ISS_INSTRUMENTED)
+    list(APPEND VPRO_CONFIG_SWITCHES -DISS_INSTRUMENTED=1)
+    message(STATUS "[VPRO config] ISS_INSTRUMENTED")
+endif()
+
+# events of the simulator trace file, e.g. DMA,RF (see GENERATE_TRACE)
+if(ISS_TRACE)
+    string(REPLACE "," ";" ISS_TRACE_EVENTS "${ISS_TRACE}")
+    foreach(EVENT ${ISS_TRACE_EVENTS})
+        list(APPEND VPRO_CONFIG_SWITCHES -DISS_TRACE_${EVENT}=1)
+    endforeach()
+    message(STATUS "[VPRO config] ISS_TRACE=${ISS_TRACE}")
+endif()
+
 message(STATUS "[VPRO config] CLUSTERS=${CLUSTERS}")
 message(STATUS "[VPRO config] UNITS=${UNITS}")
 message(STATUS "[VPRO config] LANES=${LANES}")
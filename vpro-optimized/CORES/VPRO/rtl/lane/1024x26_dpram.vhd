@@ -150,6 +150,8 @@ begin
                 write(line_out, '>');
                 write(line_out, ' ');
                 write(line_out, hstr(std_logic_vector(data_i(DATA_WIDTH_g - 1 downto 0))));
+                write(line_out, string'(" @ "));
+                write(line_out, now);   -- for the ISS compare (trace_compare)
                 writeline(rf_trace, line_out);
             end if;
             
@@ -13,6 +13,11 @@ use ieee.std_logic_1164.all;
 use ieee.numeric_std.all;
 use ieee.math_real.all;
 
+use STD.textio.all;
+
+library utils;
+use utils.txt_util.all;
+
 library core_v2pro;
 use core_v2pro.v2pro_package.all;
 use core_v2pro.package_specializations.all;
@@ -23,7 +28,8 @@ entity local_mem_64bit_wrapper is
         ADDR_WIDTH_g      : natural := 13; -- must be 11..15;  13 => 8192x16bit
         LM_DATA_WIDTH_g   : natural := 16;
         VPRO_DATA_WIDTH_g : natural := 16; -- should not be changed
-        DCMA_DATA_WIDTH_g : natural := 64 -- should not be changed
+        DCMA_DATA_WIDTH_g : natural := 64; -- should not be changed
+        LM_LABLE_g        : string  := "unknown" -- trace file name prefix (e.g. C0U0)
     );
     port(
         -- port A: VPRO Lane--
@@ -248,5 +254,40 @@ begin
         dma_addr_i(a_addr_i'length - number_local_mem_log2_c - 1 downto 0) <= b_addr_i(b_addr_i'length - 1 downto number_local_mem_log2_c);
     end process;
 
+    -- trace generation
+    --pragma translate_off
+    trace_g : if LM_LABLE_g /= "unknown" and lm_generate_write_traces_c generate
+        -- "LM[<16-bit word address>] > <data> @ <time>", as the ISS LM trace (trace_compare)
+        file lm_trace : text open write_mode is LM_LABLE_g & "LM.trace";
+    begin
+        vpro_trace : process(a_clk_i)
+            variable line_out : line;
+        begin
+            if rising_edge(a_clk_i) and a_we_i = '1' then
+                write(line_out, "LM[" & str(to_integer(unsigned(a_addr_i))) & "] > " & hstr(std_logic_vector(a_di_i)) & " @ ");
+                write(line_out, now);
+                writeline(lm_trace, line_out);
+            end if;
+        end process;
+
+        dma_trace : process(b_clk_i)
+            constant words_c  : natural := DCMA_DATA_WIDTH_g / VPRO_DATA_WIDTH_g;
+            variable line_out : line;
+            variable base_v   : natural;
+        begin
+            if rising_edge(b_clk_i) then
+                base_v := (to_integer(unsigned(b_addr_i)) / words_c) * words_c;
+                for word in 0 to words_c - 1 loop
+                    if b_we_i(word) = '1' then
+                        write(line_out, "LM[" & str(base_v + word) & "] > " & hstr(std_logic_vector(b_di_i((word + 1) * VPRO_DATA_WIDTH_g - 1 downto word * VPRO_DATA_WIDTH_g))) & " @ ");
+                        write(line_out, now);
+                        writeline(lm_trace, line_out);
+                    end if;
+                end loop;
+            end if;
+        end process;
+    end generate;
+    --pragma translate_on
+
 end rtl;
 -- coverage on
@@ -26,6 +26,7 @@ package v2pro_package is
     constant active_reset_c : std_ulogic := '0'; -- default: low-active
 
     constant rf_generate_write_traces_c : boolean := true; -- whether to generate c0u0l0rf.trace files in simulation dir with all write data traces
+    constant lm_generate_write_traces_c : boolean := false; -- whether to generate C0U0LM.trace files in simulation dir with all local memory writes (lanes + dma)
 
     -- specific hardware configuration --
     constant use_lut_cmd_fifo_c      : boolean := true; -- build CMD FIFO from BRAM or LUTs (distr. RAM)?
@@ -166,7 +166,8 @@ package package_specializations is
         generic(
             ADDR_WIDTH_g      : natural := 13;
             VPRO_DATA_WIDTH_g : natural := 16;
-            DCMA_DATA_WIDTH_g : natural := 64
+            DCMA_DATA_WIDTH_g : natural := 64;
+            LM_LABLE_g        : string  := "unknown"
         );
         port(
             a_clk_i  : in  std_ulogic;
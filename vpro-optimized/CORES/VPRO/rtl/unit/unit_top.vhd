@@ -327,7 +327,8 @@ begin
         generic map(
             ADDR_WIDTH_g      => lm_addr_width_c,
             VPRO_DATA_WIDTH_g => vpro_data_width_c,
-            DCMA_DATA_WIDTH_g => mm_data_width_c
+            DCMA_DATA_WIDTH_g => mm_data_width_c,
+            LM_LABLE_g        => UNIT_LABLE_g
         )
         port map(
             a_clk_i  => vcp_clk_i,
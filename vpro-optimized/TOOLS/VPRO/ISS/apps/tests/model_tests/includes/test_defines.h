@@ -0,0 +1,26 @@
+//
+// Tests of single ISS model components (no VPRO application, no sim_init)
+//
+
+#ifndef MODEL_TESTS_TEST_DEFINES_H
+#define MODEL_TESTS_TEST_DEFINES_H
+
+#include <simulator/helper/debugHelper.h>
+
+/**
+ * fails the current test (returns false) if the condition does not hold
+ */
+#define TEST_CHECK(cond, ...)                              \
+    do {                                                   \
+        if (!(cond)) {                                     \
+            printf_error("[%s:%i] ", __FILE__, __LINE__);  \
+            printf_error(__VA_ARGS__);                     \
+            printf_error("\n");                            \
+            return false;                                  \
+        }                                                  \
+    } while (0)
+
+bool main_memory_test();
+bool dcma_test();
+
+#endif  //MODEL_TESTS_TEST_DEFINES_H
@@ -0,0 +1,38 @@
+// ########################################################
+// # ISS model tests                                      #
+// #                                                      #
+// # single components of the simulator (main memory,     #
+// # DCMA, ...) without a VPRO application                #
+// ########################################################
+
+#include <cstdio>
+#include "test_defines.h"
+
+/**
+ * Main
+ */
+int main(int argc, char* argv[]) {
+    printf("\nISS Model Tests\n");
+
+    struct {
+        const char* name;
+        bool (*run)();
+    } tests[] = {
+        {"NonBlockingMainMemory", main_memory_test},
+        {"DCMA", dcma_test},
+    };
+
+    int failed = 0;
+    for (auto& test : tests) {
+        printf("# %s\n", test.name);
+        if (test.run()) {
+            printf_success("TEST IS SUCCESSFUL\n");
+        } else {
+            printf_error("TEST FAILED [%s]\n", test.name);
+            failed++;
+        }
+    }
+
+    printf("TESTS FINISHED (%i failed)\n", failed);
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,299 @@
+//
+// DCMA: replacement policies (FIFO, LRU, LFU, Random), the prefetcher and the timing of the
+// default concurrency
+//
+
+#include <vector>
+#include "model/architecture/DCMA.h"
+#include "simulator/ISS.h"
+#include "test_defines.h"
+
+namespace {
+
+// one set of 4 lines: every line address maps to the same set
+constexpr uint32_t line_size = 256;
+constexpr uint32_t associativity = 4;
+constexpr uint32_t nr_brams = 2;
+constexpr uint32_t bram_size = 512;
+constexpr uint32_t clusters = 3;
+
+uint32_t line(uint32_t n) {
+    return n * line_size;
+}
+
+// DCMA and main memory, ticked together (same clock in these tests)
+struct Env {
+    NonBlockingMainMemory mm;
+    DCMA dcma;
+
+    explicit Env(const Cache::Policy& policy, const Cache::Concurrency& concurrency = Cache::Concurrency())
+        : mm(1 << 20, clusters),
+          dcma(&core(), &mm, clusters, line_size, associativity, nr_brams, bram_size, concurrency, policy) {
+        // the counters (line fills, prefetches) live in the statistics, which read the DCMA of the core
+        core().dcma = &dcma;
+        Statistics::get().initialize(&core());
+    }
+
+    static ISS& core() {
+        static ISS iss;
+        return iss;
+    }
+
+    StatisticDcma::AllCounters& counters() {
+        return Statistics::get().getDCMAStat()->counters;
+    }
+
+    // same order as the simulator: dma requests of the cycle, then the dcma tick
+    void tick() {
+        dcma.commitRequests();
+        dcma.tick();
+        mm.tick();
+    }
+
+    void idle(int ticks) {
+        for (int i = 0; i < ticks; ++i) tick();
+    }
+
+    // ticks until a read request of the cluster is done
+    uint64_t wait(uint32_t cluster) {
+        uint64_t n = 0;
+        uint8_t data[DCMA::dma_dataword_length_byte];
+        while (!dcma.isReadDataAvailable(cluster)) {
+            tick();
+            n++;
+        }
+        dcma.readData(cluster, data);
+        return n;
+    }
+
+    // dma read of one word, returns whether it needed a line fill
+    bool readMisses(uint32_t addr, uint32_t cluster = 0) {
+        uint32_t fills = counters().line_fills;
+        dcma.requestDmaReadTransfer(addr, 1, cluster);
+        wait(cluster);
+        return counters().line_fills != fills;
+    }
+};
+
+Cache::Policy replacement(uint32_t policy) {
+    Cache::Policy p;
+    p.replacement = policy;
+    return p;
+}
+
+// fills the set with lines 0..3 (in this order), reads line 0 again
+bool fillSet(Env& env) {
+    for (uint32_t n = 0; n < associativity; ++n) TEST_CHECK(env.readMisses(line(n)), "cold miss of line %u", n);
+    TEST_CHECK(!env.readMisses(line(0)), "hit of line 0");
+    return true;
+}
+
+bool fifo() {
+    Env env(replacement(Cache::FIFO));
+    if (!fillSet(env)) return false;
+    // line 4 replaces the oldest fill (line 0) although it was just read
+    TEST_CHECK(env.readMisses(line(4)), "miss of line 4");
+    TEST_CHECK(!env.readMisses(line(1)), "line 1 kept");
+    TEST_CHECK(env.readMisses(line(0)), "line 0 replaced");
+    return true;
+}
+
+bool lru() {
+    Env env(replacement(Cache::LRU));
+    if (!fillSet(env)) return false;
+    // line 1 is the least recently used
+    TEST_CHECK(env.readMisses(line(4)), "miss of line 4");
+    TEST_CHECK(!env.readMisses(line(0)), "line 0 kept");
+    TEST_CHECK(!env.readMisses(line(2)), "line 2 kept");
+    TEST_CHECK(!env.readMisses(line(3)), "line 3 kept");
+    TEST_CHECK(env.readMisses(line(1)), "line 1 replaced");
+    return true;
+}
+
+bool lfu() {
+    Env env(replacement(Cache::LFU));
+    if (!fillSet(env)) return false;
+    // accesses (fill + reads): line 0: 4, line 1: 4, line 2: 3, line 3: 2 -> line 3 is the least frequently used
+    TEST_CHECK(!env.readMisses(line(1)), "hit of line 1");
+    TEST_CHECK(!env.readMisses(line(1)), "hit of line 1");
+    TEST_CHECK(!env.readMisses(line(0)), "hit of line 0");
+    TEST_CHECK(!env.readMisses(line(2)), "hit of line 2");
+    TEST_CHECK(env.readMisses(line(4)), "miss of line 4");
+    TEST_CHECK(!env.readMisses(line(0)), "line 0 kept");
+    TEST_CHECK(!env.readMisses(line(1)), "line 1 kept");
+    TEST_CHECK(!env.readMisses(line(2)), "line 2 kept");
+    TEST_CHECK(env.readMisses(line(3)), "line 3 replaced");
+    return true;
+}
+
+// misses of a cyclic access to one line more than the set holds
+uint32_t cyclicMisses(uint32_t policy) {
+    Env env(replacement(policy));
+    uint32_t misses = 0;
+    for (int round = 0; round < 10; ++round) {
+        for (uint32_t n = 0; n <= associativity; ++n) misses += env.readMisses(line(n));
+    }
+    return misses;
+}
+
+bool randomReplacement() {
+    // FIFO and LRU replace the line which is read next: every access misses
+    uint32_t accesses = 10 * (associativity + 1);
+    TEST_CHECK(cyclicMisses(Cache::FIFO) == accesses, "FIFO: cyclic access hits");
+    TEST_CHECK(cyclicMisses(Cache::LRU) == accesses, "LRU: cyclic access hits");
+    uint32_t misses = cyclicMisses(Cache::Random);
+    TEST_CHECK(misses < accesses, "Random: no hit in cyclic access (%u misses)", misses);
+    TEST_CHECK(cyclicMisses(Cache::Random) == misses, "Random: not reproducible (fixed seed)");
+    return true;
+}
+
+Cache::Policy prefetch(uint32_t mode) {
+    Cache::Policy p;
+    p.prefetch = mode;
+    return p;
+}
+
+Cache::Concurrency mshrs(uint32_t n) {
+    Cache::Concurrency c;
+    c.mshrs = n;
+    return c;
+}
+
+bool nextLine() {
+    Env env(prefetch(DCMAPrefetcher::NEXT_LINE), mshrs(2));
+    TEST_CHECK(env.readMisses(line(0)), "miss of line 0");
+    env.idle(200);
+    TEST_CHECK(env.counters().prefetch_line_fills == 1, "line 1 not prefetched");
+    TEST_CHECK(env.dcma.isIdle(), "idle after the prefetch");
+    TEST_CHECK(!env.readMisses(line(1)), "prefetched line 1 misses");
+    TEST_CHECK(env.counters().prefetch_useful == 1, "prefetch of line 1 not counted as useful");
+
+    // a single mshr is kept for demand misses: no prefetcher
+    Env single(prefetch(DCMAPrefetcher::NEXT_LINE), mshrs(1));
+    TEST_CHECK(single.readMisses(line(0)), "miss of line 0, one mshr");
+    single.idle(200);
+    TEST_CHECK(single.counters().prefetch_line_fills == 0, "prefetch with one mshr");
+    TEST_CHECK(single.dcma.isIdle(), "idle, one mshr");
+    return true;
+}
+
+bool stride() {
+    Env env(prefetch(DCMAPrefetcher::STRIDE), mshrs(2));
+    // the distance of 2 lines repeats with the third request -> line 6 is queued
+    for (uint32_t n : {0, 2, 4}) {
+        TEST_CHECK(env.readMisses(line(n)), "miss of line %u", n);
+        env.idle(200);
+    }
+    TEST_CHECK(env.counters().prefetch_line_fills == 1, "line 6 not prefetched");
+    TEST_CHECK(!env.readMisses(line(6)), "prefetched line 6 misses");
+    return true;
+}
+
+// cycles until a miss of cluster 1 is served, gap cycles after cluster 0 has triggered prefetches
+uint64_t demandLatency(uint32_t mode, int gap) {
+    Cache::Policy policy = prefetch(mode);
+    policy.prefetch_degree = 4;
+    Env env(policy, mshrs(2));
+    env.dcma.requestDmaReadTransfer(line(0), 1, 0);
+    env.wait(0);
+    env.idle(gap);  // prefetcher queued lines 1..4
+    env.dcma.requestDmaReadTransfer(line(8), 1, 1);
+    return env.wait(1);
+}
+
+bool demandFirst() {
+    for (int gap : {0, 1, 2, 3, 5, 10}) {
+        uint64_t without = demandLatency(DCMAPrefetcher::OFF, gap);
+        uint64_t with = demandLatency(DCMAPrefetcher::NEXT_LINE, gap);
+        TEST_CHECK(with == without, "demand miss delayed by prefetches (%lu vs. %lu cycles, gap %i)", with, without, gap);
+    }
+    return true;
+}
+
+struct Transfer {
+    bool read;
+    uint32_t addr;
+    uint32_t words;  // dma words (16-bit)
+};
+
+// one dma per cluster: issues the transfers in order, moves up to one dcma word per cycle
+// (as DMA::execute)
+std::vector<uint64_t> runTransfers(Env& env, const std::vector<std::vector<Transfer>>& dmas) {
+    DCMA& dcma = env.dcma;
+    constexpr uint32_t words_per_cycle =
+        DCMA::dcma_dataword_length_byte / DCMA::dma_dataword_length_byte;
+    std::vector<uint64_t> done;  // cycle in which the last word of each transfer was moved
+    std::vector<size_t> next(dmas.size(), 0);
+    std::vector<uint32_t> remaining(dmas.size(), 0);
+    uint8_t data[DCMA::dma_dataword_length_byte] = {1, 2};
+    size_t open = 0;
+    for (auto& dma : dmas) open += dma.size();
+
+    for (uint64_t cycle = 0; open > 0 || !dcma.isIdle() || !env.mm.isIdle(); ++cycle) {
+        if (cycle > 100000) return {};  // dead lock
+        for (uint32_t c = 0; c < dmas.size(); ++c) {
+            if (remaining[c] > 0) {
+                const Transfer& t = dmas[c][next[c] - 1];
+                for (uint32_t n = 0; n < words_per_cycle && remaining[c] > 0; ++n) {
+                    if (t.read ? !dcma.isReadDataAvailable(c) : !dcma.isWriteDataReady(c)) break;
+                    t.read ? dcma.readData(c, data) : dcma.writeData(c, data);
+                    if (--remaining[c] == 0) {
+                        done.push_back(cycle);
+                        open--;
+                    }
+                }
+            } else if (next[c] < dmas[c].size() && !dcma.isBusy(c)) {
+                const Transfer& t = dmas[c][next[c]++];
+                t.read ? dcma.requestDmaReadTransfer(t.addr, t.words, c)
+                       : dcma.requestDmaWriteTransfer(t.addr, t.words, c);
+                remaining[c] = t.words;
+            }
+        }
+        env.tick();
+    }
+    return done;
+}
+
+// misses of several clusters at the same time, hits under a miss and dirty victims (uploads)
+const std::vector<std::vector<Transfer>> transfers = {
+    {{true, line(0), 16},
+        {false, line(0) + 64, 8},
+        {true, line(1) + 32, 32},
+        {true, line(4), 8},
+        {false, line(5), 64},
+        {true, line(0), 8}},
+    {{true, line(0) + 128, 8},
+        {true, line(2), 16},
+        {false, line(2) + 64, 16},
+        {true, line(6), 8},
+        {true, line(1), 8}},
+    {{true, line(3), 4},
+        {true, line(0), 4},
+        {false, line(7), 32},
+        {true, line(2), 8},
+        {true, line(5), 64}},
+};
+
+// cycles of the cache model before the mshrs (one line fill at a time), the default concurrency
+// has to keep them
+bool defaultTiming() {
+    const std::vector<uint64_t> single_fill = {
+        50, 50, 85, 124, 129, 135, 177, 204, 228, 267, 320, 362, 422, 423, 457, 500};
+    Env env{Cache::Policy()};
+    std::vector<uint64_t> done = runTransfers(env, transfers);
+    TEST_CHECK(done == single_fill,
+        "default concurrency changes the cycles (%zu transfers, last done in cycle %lu)",
+        done.size(),
+        done.empty() ? 0 : done.back());
+
+    Env parallel(Cache::Policy(), mshrs(2));
+    done = runTransfers(parallel, transfers);
+    TEST_CHECK(!done.empty() && done.back() < single_fill.back(), "no gain of 2 mshrs");
+    return true;
+}
+
+}  // namespace
+
+bool dcma_test() {
+    return fifo() && lru() && lfu() && randomReplacement() && nextLine() && stride() && demandFirst() && defaultTiming();
+}
@@ -0,0 +1,178 @@
+//
+// NonBlockingMainMemory: timing wheel, replaced requests, skipped ticks, debug block access
+//
+
+#include <cstring>
+#include "model/architecture/NonBlockingMainMemory.h"
+#include "test_defines.h"
+
+namespace {
+
+constexpr int word = NonBlockingBusSlaveInterface::dataword_length_byte;  // bytes per burst word
+
+// ticks until the read of the initiator is available
+uint64_t waitRead(NonBlockingMainMemory& mm, uint32_t id) {
+    uint64_t n = 0;
+    while (!mm.isReadDataAvailable(id)) {
+        mm.tick();
+        n++;
+    }
+    return n;
+}
+
+uint64_t waitWrite(NonBlockingMainMemory& mm, uint32_t id) {
+    uint64_t n = 0;
+    while (!mm.isWriteDataReady(id)) {
+        mm.tick();
+        n++;
+    }
+    return n;
+}
+
+bool fixedLatency() {
+    NonBlockingMainMemory mm(1 << 20, 2);
+    MainMemoryTiming::Config config;  // read / write latency 36 / 6
+    uint8_t data[2 * word], result[2 * word];
+    for (size_t i = 0; i < sizeof(data); ++i) data[i] = uint8_t(i * 7 + 1);
+
+    for (int i = 0; i < 5; ++i) mm.tick();
+    TEST_CHECK(mm.isIdle(), "idle without requests");
+
+    // the write is visible immediately, the burst completes after the latency (+ the tick of the request)
+    mm.requestWriteTransfer(128, data, 2, 0);
+    TEST_CHECK(!mm.isIdle(), "pending write");
+    TEST_CHECK(waitWrite(mm, 0) == config.write_latency + 1, "write latency");
+
+    mm.requestReadTransfer(128, 2, 1);
+    TEST_CHECK(waitRead(mm, 1) == config.read_latency + 1, "read latency");
+    TEST_CHECK(mm.readData(result, 1), "read data");
+    TEST_CHECK(memcmp(data, result, sizeof(data)) == 0, "read data differs from the written data");
+    TEST_CHECK(mm.isIdle(), "idle after the read");
+
+    // initiator id above the constructor's count gets its slot on demand
+    mm.requestReadTransfer(0, 1, 7);
+    TEST_CHECK(waitRead(mm, 7) == config.read_latency + 1, "read latency of initiator 7");
+    return mm.readData(result, 7) && mm.isIdle();
+}
+
+bool replacedRequest() {
+    NonBlockingMainMemory mm(1 << 20, 1);
+    MainMemoryTiming::Config config;
+    uint8_t result[word];
+
+    // a new request of the same initiator replaces the pending one, only its completion counts
+    mm.requestReadTransfer(0, 1, 0);
+    mm.tick();
+    mm.requestReadTransfer(64, 1, 0);
+    TEST_CHECK(waitRead(mm, 0) == config.read_latency + 1, "replacing read latency");
+    TEST_CHECK(mm.isIdle(), "idle after the replacing read");
+    TEST_CHECK(mm.readData(result, 0), "read data");
+
+    // jump far ahead (several wheel turns), later requests keep their latency
+    mm.requestReadTransfer(0, 1, 0);
+    mm.requestReadTransfer(0, 1, 0);
+    waitRead(mm, 0);
+    mm.readData(result, 0);
+    for (uint64_t skip : {uint64_t(1), uint64_t(63), uint64_t(1000000007)}) {
+        TEST_CHECK(mm.isIdle(), "idle before skipping");
+        mm.skipTicks(skip);
+        mm.requestReadTransfer(0, 1, 0);
+        TEST_CHECK(waitRead(mm, 0) == config.read_latency + 1, "read latency after skipping %lu ticks", skip);
+        mm.readData(result, 0);
+    }
+
+    // skipping with pending requests (next event scheduling): up to the tick completing the earliest
+    TEST_CHECK(mm.ticksToNextEvent() == UINT64_MAX, "no event while idle");
+    mm.requestReadTransfer(0, 1, 0);
+    mm.tick();
+    mm.requestReadTransfer(64, 1, 0);  // stale entry of the replaced read stays in the wheel
+    mm.requestWriteTransfer(128, result, 1, 1);
+    TEST_CHECK(mm.ticksToNextEvent() == config.write_latency, "next event: write completion");
+    mm.skipTicks(mm.ticksToNextEvent());
+    TEST_CHECK(waitWrite(mm, 1) == 1, "write completes in the tick after the skip");
+    TEST_CHECK(mm.ticksToNextEvent() == config.read_latency - config.write_latency - 1,
+        "next event: read completion");
+    mm.skipTicks(mm.ticksToNextEvent());
+    TEST_CHECK(!mm.isRequestDone(0, false), "read pending before its tick");
+    TEST_CHECK(waitRead(mm, 0) == 1, "read completes in the tick after the skip");
+    TEST_CHECK(mm.isIdle(), "idle after the skipped reads");
+    return mm.readData(result, 0);
+}
+
+bool bandwidth() {
+    NonBlockingMainMemory mm(1 << 20, 2);
+    MainMemoryTiming::Config config;
+    config.read_latency = 200;  // > wheel size: completions wait for later turns of the wheel
+    config.bytes_per_cycle = word;  // one cycle per burst word
+    mm.setTiming(config);
+
+    // two bursts of 4 words share the read channel: the second one completes 4 cycles later
+    mm.requestReadTransfer(0, 4, 0);
+    mm.requestReadTransfer(0, 4, 1);
+    uint64_t done[2] = {0, 0}, n = 0;
+    while (!mm.isIdle()) {
+        mm.tick();
+        n++;
+        for (uint32_t id = 0; id < 2; ++id)
+            if (!done[id] && mm.isReadDataAvailable(id)) done[id] = n;
+    }
+    TEST_CHECK(done[0] == config.read_latency + 4 + 1, "first burst (%lu)", done[0]);
+    TEST_CHECK(done[1] == done[0] + 4, "second burst (%lu)", done[1]);
+    return true;
+}
+
+bool dram() {
+    NonBlockingMainMemory mm(1 << 20, 4);
+    MainMemoryTiming::Config config;
+    config.model = MainMemoryTiming::DRAM;
+    config.bytes_per_cycle = 2 * word;
+    mm.setTiming(config);
+
+    // same row: the first burst opens it (miss), the others hit and follow on the data bus
+    for (uint32_t id = 0; id < 4; ++id) mm.requestReadTransfer(id * word, 1, id);
+    uint64_t done[4] = {}, n = 0;
+    while (!mm.isIdle()) {
+        mm.tick();
+        n++;
+        for (uint32_t id = 0; id < 4; ++id)
+            if (!done[id] && mm.isReadDataAvailable(id)) done[id] = n;
+    }
+    TEST_CHECK(done[0] == config.row_miss_latency + 1 + 1, "row miss (%lu)", done[0]);
+    for (uint32_t id = 1; id < 4; ++id)
+        TEST_CHECK(done[id] > done[id - 1], "row hits complete in order (%lu)", done[id]);
+
+    // idle skip keeps the bank / bus state in absolute cycles: the row is still open
+    mm.skipTicks(1000);
+    mm.requestReadTransfer(0, 1, 0);
+    TEST_CHECK(waitRead(mm, 0) == config.row_hit_latency + 1 + 1, "row hit after skipping");
+    return true;
+}
+
+// block access running past the end of memory: the part inside is copied, reads return zeros for the rest
+bool debugBlockClip() {
+    constexpr uint64_t size = 1 << 20;
+    NonBlockingMainMemory mm(size, 1);
+    uint8_t data[64], result[64];
+    for (size_t i = 0; i < sizeof(data); ++i) data[i] = uint8_t(i + 1);
+
+    mm.dbgWriteBlock(size - 16, data, sizeof(data));
+    memset(result, 0xff, sizeof(result));
+    mm.dbgReadBlock(size - 16, result, sizeof(result));
+    TEST_CHECK(memcmp(data, result, 16) == 0, "clipped write / read, part inside the memory");
+    for (size_t i = 16; i < sizeof(result); ++i) TEST_CHECK(result[i] == 0, "clipped read, byte %zu not zero", i);
+
+    memset(result, 0xff, sizeof(result));
+    mm.dbgReadBlock(size + 64, result, sizeof(result));
+    for (size_t i = 0; i < sizeof(result); ++i) TEST_CHECK(result[i] == 0, "read outside, byte %zu not zero", i);
+    mm.dbgWriteBlock(size + 64, data, sizeof(data));  // dropped
+
+    uint8_t byte;
+    mm.dbgRead(size - 17, &byte);
+    return byte == 0;
+}
+
+}  // namespace
+
+bool main_memory_test() {
+    return fixedLatency() && replacedRequest() && bandwidth() && dram() && debugBlockClip();
+}
@@ -504,6 +504,11 @@ inline void __attribute__((always_inline)) sim_dump_local_memory(uint32_t cluste
 inline void __attribute__((always_inline)) sim_dump_register_file(uint32_t cluster, uint32_t unit, uint32_t lane){}
 inline void __attribute__((always_inline)) sim_dump_queue(uint32_t cluster, uint32_t unit){}
 
+inline bool __attribute__((always_inline)) sim_checkpoint_save(const char* file_name){return false;}
+inline bool __attribute__((always_inline)) sim_checkpoint_restore(const char* file_name){return false;}
+inline void __attribute__((always_inline)) sim_checkpoint_layer(uint32_t layers_done, uint64_t app_data){}
+inline uint32_t __attribute__((always_inline)) sim_checkpoint_resume(uint64_t* app_data){return 0;}
+
 #include "../riscv/eisv_defs.h"
 inline uint32_t __attribute__((always_inline)) get_gpr_vpro_freq() { return *((volatile uint32_t *)(GP_REGISTERS_ADDR + 6 * 4)); }
 inline uint32_t __attribute__((always_inline)) get_gpr_risc_freq() { return *((volatile uint32_t *)(GP_REGISTERS_ADDR + 7 * 4)); }
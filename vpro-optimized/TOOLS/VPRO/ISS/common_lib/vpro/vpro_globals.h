@@ -66,19 +66,39 @@
 #endif
 
 
+/*
+ * CONF_RUNTIME (simulator only, cmake -DRUNTIME_CONFIG=1):
+ * CLUSTERS, UNITS and the DCMA configuration are variables, initialized with the CONF_* defaults and
+ * set once at startup (ISS command line / config file, before the architecture is created).
+ * One simulator binary can run different configurations. Otherwise all values are constexpr.
+ * LANES stays constexpr: the ISA lane mask (L0, L1, LS) fixes the number of lanes.
+ */
+#ifdef CONF_RUNTIME
+#define VPRO_CFG_PARAM inline
+#else
+#define VPRO_CFG_PARAM constexpr
+#endif
+
 namespace VPRO_CFG {
-    constexpr unsigned int CLUSTERS = CONF_CLUSTERS;
-    constexpr unsigned int UNITS = CONF_UNITS;
+    VPRO_CFG_PARAM unsigned int CLUSTERS = CONF_CLUSTERS;
+    VPRO_CFG_PARAM unsigned int UNITS = CONF_UNITS;
     constexpr unsigned int LANES = CONF_LANES;
-    constexpr unsigned int parallel_Lanes = CLUSTERS*UNITS*LANES;
+    VPRO_CFG_PARAM unsigned int parallel_Lanes = CLUSTERS*UNITS*LANES;
     constexpr uint64_t     MM_SIZE = CONF_MM_SIZE;
     constexpr unsigned int LM_SIZE = CONF_LM_SIZE;
     constexpr unsigned int RF_SIZE = CONF_RF_SIZE;
 
-    constexpr unsigned int DCMA_LINE_SIZE = CONF_DCMA_LINE_SIZE; // in bytes
-    constexpr unsigned int DCMA_ASSOCIATIVITY = CONF_DCMA_ASSOCIATIVITY;
-    constexpr unsigned int DCMA_NR_BRAMS = CONF_DCMA_NR_RAMS;
-    constexpr unsigned int DCMA_BRAM_SIZE = CONF_DCMA_RAM_SIZE; // in bytes
+    VPRO_CFG_PARAM unsigned int DCMA_LINE_SIZE = CONF_DCMA_LINE_SIZE; // in bytes
+    VPRO_CFG_PARAM unsigned int DCMA_ASSOCIATIVITY = CONF_DCMA_ASSOCIATIVITY;
+    VPRO_CFG_PARAM unsigned int DCMA_NR_BRAMS = CONF_DCMA_NR_RAMS;
+    VPRO_CFG_PARAM unsigned int DCMA_BRAM_SIZE = CONF_DCMA_RAM_SIZE; // in bytes
+
+#ifdef CONF_RUNTIME
+    // to be called after a change of the run-time configuration
+    inline void updateDerived() {
+        parallel_Lanes = CLUSTERS*UNITS*LANES;
+    }
+#endif
 
     // Configuration related to how the HW is simulated
     namespace SIM {
@@ -64,7 +64,7 @@ void aux_print_debugfifo(uint32_t data) {
 #ifdef ISS_STANDALONE
     core_->runUntilRiscReadyForCmd();
 #endif
-    if (debug & DEBUG_INSTRUCTIONS) {
+    if (if_debug(DEBUG_INSTRUCTIONS)) {
         printf("Sim print debug fifo \n");
     }
     printf("#SIM DEBUG_FIFO: 0x%08x\n", data);
@@ -74,10 +74,10 @@ void aux_dev_null(uint32_t data) {
 #ifdef ISS_STANDALONE
     core_->runUntilRiscReadyForCmd();
 #endif
-    if (debug & DEBUG_INSTRUCTIONS) {
+    if (if_debug(DEBUG_INSTRUCTIONS)) {
         printf("Sim print dev null \n");
     }
-    if (debug & DEBUG_DEV_NULL) {
+    if (if_debug(DEBUG_DEV_NULL)) {
         printf("#SIM DEV_NULL: 0x%08x\n", data);
     }
 }
@@ -86,7 +86,7 @@ void aux_flush_dcache() {
 #ifdef ISS_STANDALONE
     core_->runUntilRiscReadyForCmd();
 #endif
-    if (debug & DEBUG_INSTRUCTIONS) {
+    if (if_debug(DEBUG_INSTRUCTIONS)) {
         printf("Sim flush dcache \n");
     }
     // just a dummy
@@ -119,7 +119,7 @@ void aux_clr_sys_time() {
 #endif
     core_->aux_sys_time = 0;
     // just a dummy
-    if (debug & DEBUG_INSTRUCTIONS) {
+    if (if_debug(DEBUG_INSTRUCTIONS)) {
         printf("Sim aux clr sys time \n");
     }
 }
@@ -130,7 +130,7 @@ void aux_clr_cycle_cnt() {
 #endif
     core_->aux_cycle_counter = 0;
     // just a dummy
-    if (debug & DEBUG_INSTRUCTIONS) {
+    if (if_debug(DEBUG_INSTRUCTIONS)) {
         printf("Sim aux clr cycle caunt \n");
     }
 }
@@ -139,7 +139,7 @@ uint32_t aux_get_cycle_cnt() {
 #ifdef ISS_STANDALONE
     core_->runUntilRiscReadyForCmd();
 #endif
-    if (debug & DEBUG_INSTRUCTIONS) {
+    if (if_debug(DEBUG_INSTRUCTIONS)) {
         printf("Sim get cycle cnt %i \n", uint32_t(core_->aux_cycle_counter));
     }
     return core_->aux_cycle_counter;
@@ -151,7 +151,7 @@ void aux_send_system_runtime() {
 #endif
     printf("\n#SIM aux_sys_time send: 0x%08x\n", uint32_t(core_->aux_sys_time));
     // just a dummy
-    if (debug & DEBUG_INSTRUCTIONS) {
+    if (if_debug(DEBUG_INSTRUCTIONS)) {
         printf("Sim send system runtime \n");
     }
 }
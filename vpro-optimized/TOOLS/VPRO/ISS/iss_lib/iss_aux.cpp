@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include "simulator/helper/debugHelper.h"
+#include "simulator/helper/trace.h"
 
 struct sync_function {
     uint32_t data[1];
@@ -42,9 +43,8 @@ void dma_wait_to_finish(uint32_t cluster_mask) {
     core_->setWaitingToFinish(true);
 
     if (core_->DMA_gen_trace) {
-        uint32_t cycle_stamp = core_->getTime() / core_->getDMAClockPeriod();
-        core_->dma_sync_trace << cycle_stamp << "\n";
-        core_->dma_sync_trace.flush();
+        Trace::Writer::get().record(
+            Trace::DMA_SYNC, Trace::NONE, Trace::NONE, Trace::NONE, 0, 0, cluster_mask);
     }
 
     core_->io_write(VPRO_BUSY_MASK_CL_ADDR, cluster_mask);
@@ -489,6 +489,22 @@ void sim_stat_reset() {
     core_->sim_stats_reset();
 }
 
+bool sim_checkpoint_save(const char* file_name) {
+    return core_->checkpointSave(file_name);
+}
+
+bool sim_checkpoint_restore(const char* file_name) {
+    return core_->checkpointRestore(file_name);
+}
+
+void sim_checkpoint_layer(uint32_t layers_done, uint64_t app_data) {
+    core_->checkpointLayer(layers_done, app_data);
+}
+
+uint32_t sim_checkpoint_resume(uint64_t* app_data) {
+    return core_->checkpointResume(app_data);
+}
+
 void sim_printf(const char* format) {
     printf("#SIM_PRINTF: ");
     printf("%s", format);
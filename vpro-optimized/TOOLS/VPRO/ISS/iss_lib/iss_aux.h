@@ -161,6 +161,34 @@ void sim_dump_queue(uint32_t cluster, uint32_t unit);
 
 void sim_stat_reset();
 
+/**
+ * Saves the architecture state (memories, register files, accus, dcma, clocks) to a binary file.
+ * Running commands are finished before. Restart the application with --checkpoint-restore=<file>
+ * (or call sim_checkpoint_restore) and skip the part simulated before
+ * @return whether the checkpoint was written
+ */
+bool sim_checkpoint_save(const char* file_name);
+
+/**
+ * Restores a checkpoint of sim_checkpoint_save (same architecture configuration required)
+ * @return whether the state was restored
+ */
+bool sim_checkpoint_restore(const char* file_name);
+
+/**
+ * Layer boundary of the application (commands of the layers before are synchronized).
+ * With --checkpoint-save=<file> --checkpoint-layer=<n> the checkpoint is saved after layer n.
+ * layers_done and app_data are part of the checkpoint (see sim_checkpoint_resume)
+ */
+void sim_checkpoint_layer(uint32_t layers_done, uint64_t app_data);
+
+/**
+ * Resume after --checkpoint-restore=<file> (or sim_checkpoint_restore): skip the layers done
+ * @param app_data set to the app_data of sim_checkpoint_layer in the checkpoint
+ * @return layers done in the restored checkpoint, once (0: no checkpoint restored)
+ */
+uint32_t sim_checkpoint_resume(uint64_t* app_data);
+
 void sim_printf(const char* format);
 
 template <typename... Args>
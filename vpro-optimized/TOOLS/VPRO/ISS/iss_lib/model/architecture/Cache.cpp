@@ -3,13 +3,17 @@
 //
 
 #include "Cache.h"
+#include <algorithm>
+#include "../../simulator/helper/checkpoint.h"
 
 Cache::Cache(ISS* core,
     uint32_t line_size,
     uint32_t associativity,
     uint32_t nr_brams,
     uint32_t bram_size_byte,
-    NonBlockingBusSlaveInterface* bus)
+    NonBlockingBusSlaveInterface* bus,
+    const Concurrency& concurrency,
+    const Policy& policy)
     : core(core) {
     this->bus = bus;
 
@@ -23,8 +27,13 @@ Cache::Cache(ISS* core,
     tag_memory = std::vector<uint32_t>(config.nr_lines, 0);
     dirty_flags = std::vector<bool>(config.nr_lines, false);
     valid_flags = std::vector<bool>(config.nr_lines, false);
+    prefetched_flags = std::vector<bool>(config.nr_lines, false);
 
-    bus_buffer = std::vector<uint8_t>(line_size, 0);
+    mshrs = std::vector<Request>(std::max(concurrency.mshrs, 1u));
+    for (auto& mshr : mshrs)
+        mshr.bus_buffer = std::vector<uint8_t>(line_size, 0);
+    hit_under_miss = concurrency.hit_under_miss;
+    replacement_policy = policy.replacement;
 
     config.total_cache_size = bram_size_byte * nr_brams;  // in bytes
     config.nr_sets = config.total_cache_size / (line_size * associativity);
@@ -48,7 +57,7 @@ Cache::Cache(ISS* core,
 
     // init brams
     for (int i = 0; i < nr_brams; ++i) {
-        brams.emplace_back(bram_size_byte, dma_dataword_length_byte);
+        brams.emplace_back(bram_size_byte, dma_dataword_length_byte, concurrency.bram_ports);
     }
 }
 
@@ -128,17 +137,8 @@ void Cache::dmaReadDataHit(uint32_t addr_in, uint8_t* data_ptr) {
     brams[bram_idx].read(bram_addr, data_ptr);
     brams[bram_idx].set_accessed_this_cycle(true);
 
-    if (replacement_policy == ReplacementPolicy::LRU) {
-        // increment replacement memory of other lines in a set
-        for (int i = 0; i < config.associativity; ++i) {
-            if (i == line)
-                replacement_memory[set_offset + line] = 0;
-            else
-                replacement_memory[set_offset + i]++;
-        }
-    } else if (replacement_policy == ReplacementPolicy::LFU) {
-        replacement_memory[set_offset + line]++;
-    }
+    countAccess(line + set_offset);
+    touchLine(set_offset, line, false);
 }
 
 /**
@@ -166,23 +166,15 @@ void Cache::dmaWriteDataHit(uint32_t addr_in, uint8_t* data_ptr) {
 
     dirty_flags[line + set_offset] = true;
 
-    if (replacement_policy == ReplacementPolicy::LRU) {
-        // increment replacement memory of other lines in a set
-        for (int i = 0; i < config.associativity; ++i) {
-            if (i == line)
-                replacement_memory[set_offset + line] = 0;
-            else
-                replacement_memory[set_offset + i]++;
-        }
-    } else if (replacement_policy == ReplacementPolicy::LFU) {
-        replacement_memory[set_offset + line]++;
-    }
+    countAccess(line + set_offset);
+    touchLine(set_offset, line, false);
 }
 
 /**
  * starts a write request to the bus for uploading a cache line
  */
-void Cache::uploadCacheLine() {
+void Cache::uploadCacheLine(uint32_t mshr) {
+    auto& cur_bus_request = mshrs[mshr];
     uint32_t addr = uint32_t(cur_bus_request.cache_line / config.associativity) * config.line_size;
     uint32_t tag = tag_memory[cur_bus_request.cache_line];
     addr += tag << (config.addr_word_bitwidth + config.addr_word_select_bitwidth +
@@ -197,10 +189,10 @@ void Cache::uploadCacheLine() {
     for (int i = 0; i < config.line_size; i = i + dma_dataword_length_byte) {
         bram_idx = getBramIdx(cache_addr + i);
         bram_addr = getBramAddr(cache_addr + i);
-        brams[bram_idx].read(bram_addr, &bus_buffer[i]);
+        brams[bram_idx].read(bram_addr, &cur_bus_request.bus_buffer[i]);
     }
 
-    bus->requestWriteTransfer(addr, &bus_buffer[0], burst_length, initiator_id);
+    bus->requestWriteTransfer(addr, &cur_bus_request.bus_buffer[0], burst_length, mshr);
 
     cur_bus_request.is_waiting_for_wdata = true;
     cur_bus_request.is_waiting_for_bus = true;
@@ -209,12 +201,13 @@ void Cache::uploadCacheLine() {
 /**
  * starts a read request to the bus for downloading a cache line
  */
-void Cache::downloadCacheLine() {
+void Cache::downloadCacheLine(uint32_t mshr) {
+    auto& cur_bus_request = mshrs[mshr];
     intptr_t addr = calcLineAlignedAddr(cur_bus_request.byte_addr);
     uint32_t burst_length = config.line_size / bus_dataword_length_byte;
 
     //    dcma->requestDmaReadTransfer(addr, burst_length, initiator_id);
-    bus->requestReadTransfer(addr, burst_length, initiator_id);
+    bus->requestReadTransfer(addr, burst_length, mshr);
     cur_bus_request.is_waiting_for_bus = true;
 }
 
@@ -231,17 +224,22 @@ uint32_t Cache::calcLineAlignedAddr(uint32_t addr) {
 }
 
 /**
- * start a cache line download request, only possible if cache is not busy (loading another cache line)
+ * start a cache line download request, only possible if a mshr is free (see hasFreeMshr)
  * @param byte_addr byte addr of requested data
  * @param initiator_id cluster id
  */
-void Cache::dmaRequestDownloadCacheLine(uint32_t byte_addr, uint32_t initiator_id) {
-    cur_bus_request.byte_addr = calcLineAlignedAddr(byte_addr);
-    //    cur_bus_request.is_read = false;
-    cur_bus_request.is_waiting_for_bus = false;
-    cur_bus_request.is_waiting_for_wdata = false;
-    cur_bus_request.is_done = false;
-    cur_bus_request.cache_line_data_ptr = 0;
+void Cache::dmaRequestDownloadCacheLine(uint32_t byte_addr, uint32_t initiator_id, bool prefetch) {
+    for (auto& cur_bus_request : mshrs) {
+        if (!cur_bus_request.is_done) continue;
+        cur_bus_request.byte_addr = calcLineAlignedAddr(byte_addr);
+        cur_bus_request.is_prefetch = prefetch;
+        //    cur_bus_request.is_read = false;
+        cur_bus_request.is_waiting_for_bus = false;
+        cur_bus_request.is_waiting_for_wdata = false;
+        cur_bus_request.is_done = false;
+        cur_bus_request.cache_line_data_ptr = 0;
+        return;
+    }
 }
 
 /**
@@ -249,7 +247,35 @@ void Cache::dmaRequestDownloadCacheLine(uint32_t byte_addr, uint32_t initiator_i
  * @return bool busy
  */
 bool Cache::isBusy() {
-    return !cur_bus_request.is_done;
+    return flush_flag || activeMshrs() > 0;
+}
+
+bool Cache::hasFreeMshr() {
+    return !flush_flag && activeMshrs() < mshrs.size();
+}
+
+bool Cache::isPending(uint32_t addr) {
+    uint32_t line_addr = calcLineAlignedAddr(addr);
+    for (auto& mshr : mshrs) {
+        if (!mshr.is_done && mshr.byte_addr == line_addr) return true;
+    }
+    return false;
+}
+
+uint32_t Cache::activeMshrs() {
+    uint32_t active = 0;
+    for (auto& mshr : mshrs)
+        active += !mshr.is_done;
+    return active;
+}
+
+bool Cache::isReserved(uint32_t cache_line) {
+    for (auto& mshr : mshrs) {
+        if (!mshr.is_done && (mshr.is_waiting_for_bus || mshr.is_waiting_for_wdata) &&
+            mshr.cache_line == cache_line)
+            return true;
+    }
+    return false;
 }
 
 /**
@@ -258,6 +284,7 @@ bool Cache::isBusy() {
  * @return bool ready
  */
 bool Cache::isAccessReady(uint32_t addr_in) {
+    if (!hit_under_miss && isBusy()) return false;
     if (isHit(addr_in)) {
         uint32_t bram_idx = getBramIdx(addr_in);
         return !brams[bram_idx].get_accessed_this_cycle();
@@ -265,148 +292,226 @@ bool Cache::isAccessReady(uint32_t addr_in) {
     return false;
 }
 
-/**
- * simulates a cache cycle
- */
+uint64_t Cache::ticksToNextEvent() {
+    if (flush_flag) return 0;
+    uint64_t next = UINT64_MAX;
+    for (uint32_t mshr = 0; mshr < mshrs.size(); ++mshr) {
+        auto& request = mshrs[mshr];
+        if (request.is_done) continue;
+        if (!request.is_waiting_for_bus && !request.is_waiting_for_wdata) return 0;
+        if (request.burst_wait_counter > 0) {
+            next = std::min(next, uint64_t(request.burst_wait_counter - 1));
+            continue;
+        }
+        // waits for the bus: its data / the channel (released by the burst of another mshr)
+        uint32_t channel = request.is_waiting_for_wdata ? write_channel_mshr : read_channel_mshr;
+#ifdef ISS_STANDALONE
+        if (channel == none && reinterpret_cast<NonBlockingMainMemory*>(bus)->isRequestDone(
+                                   mshr, request.is_waiting_for_wdata))
+            return 0;
+#else
+        if (channel == none) return 0;  // completion of the external bus is unknown
+#endif
+    }
+    return next;
+}
+
+void Cache::skipTicks(uint64_t ticks) {
+    if (ticks == 0) return;
+    for (Bram& bram : brams)
+        bram.set_accessed_this_cycle(false);
+
+    // bursts count down, the other mshrs wait for the bus (the wait cycle is counted once)
+    bool waiting = false;
+    for (auto& request : mshrs) {
+        if (request.is_done) continue;
+        if (request.burst_wait_counter > 0)
+            request.burst_wait_counter -= ticks;
+        else
+            waiting = true;
+    }
+    if (waiting) Statistics::get().getDCMAStat()->counters.bus_wait_cycles += ticks;
+}
+
 void Cache::tick() {
     // reset bram accessed this cycle flag
     for (Bram& bram : brams)
         bram.set_accessed_this_cycle(false);
 
     if (flush_flag) {
-        if (!cur_bus_request.is_waiting_for_bus) {
-            uint32_t cache_ext_addr;
-            uint32_t cache_bram_addr;
-            bool found_dirty = false;
-            while (!found_dirty && !flush_last) {
-                if (dirty_flags[flush_counter]) {
-                    found_dirty = true;
-                    cache_ext_addr =
-                        (uint32_t(flush_counter / config.associativity) * config.associativity) *
-                        config.line_size;
-                    cache_bram_addr = flush_counter * config.line_size;
-                }
+        tickFlush();
+        return;
+    }
 
-                flush_counter++;
-                if (flush_counter == config.nr_lines) {
-                    flush_last = true;
-                    if (!found_dirty) {
-                        cur_bus_request.is_done = true;
-                        flush_flag = false;
-                    }
-                }
+    // line fills of all mshrs, the wait cycle is counted once
+    bool waiting = false;
+    for (uint32_t mshr = 0; mshr < mshrs.size(); ++mshr) {
+        if (tickMshr(mshr)) waiting = true;
+    }
+    if (waiting) Statistics::get().getDCMAStat()->counters.bus_wait_cycles++;
+}
+
+void Cache::tickFlush() {
+    auto& cur_bus_request = mshrs[0];
+    auto& burst_wait_counter = cur_bus_request.burst_wait_counter;
+    auto& bus_buffer = cur_bus_request.bus_buffer;
+    if (!cur_bus_request.is_waiting_for_bus) {
+        uint32_t cache_ext_addr;
+        uint32_t cache_bram_addr;
+        bool found_dirty = false;
+        while (!found_dirty && !flush_last) {
+            if (dirty_flags[flush_counter]) {
+                found_dirty = true;
+                cache_ext_addr =
+                    (uint32_t(flush_counter / config.associativity) * config.associativity) *
+                    config.line_size;
+                cache_bram_addr = flush_counter * config.line_size;
             }
-            if (found_dirty) {
-                uint32_t burst_length = config.line_size / bus_dataword_length_byte;
-
-                // get upload data from cache/brams
-                uint32_t bram_idx;
-                uint32_t bram_addr;
-                for (int i = 0; i < config.line_size; i = i + dma_dataword_length_byte) {
-                    bram_idx = getBramIdx(cache_bram_addr + i);
-                    bram_addr = getBramAddr(cache_bram_addr + i);
-                    brams[bram_idx].read(bram_addr, &bus_buffer[i]);
+
+            flush_counter++;
+            if (flush_counter == config.nr_lines) {
+                flush_last = true;
+                if (!found_dirty) {
+                    cur_bus_request.is_done = true;
+                    flush_flag = false;
                 }
+            }
+        }
+        if (found_dirty) {
+            uint32_t burst_length = config.line_size / bus_dataword_length_byte;
+
+            // get upload data from cache/brams
+            uint32_t bram_idx;
+            uint32_t bram_addr;
+            for (int i = 0; i < config.line_size; i = i + dma_dataword_length_byte) {
+                bram_idx = getBramIdx(cache_bram_addr + i);
+                bram_addr = getBramAddr(cache_bram_addr + i);
+                brams[bram_idx].read(bram_addr, &bus_buffer[i]);
+            }
 
-                uint32_t tag = tag_memory[flush_counter - 1];
-                uint32_t ext_addr =
-                    cache_ext_addr / config.associativity +
-                    (tag << (config.addr_word_bitwidth + config.addr_word_select_bitwidth +
-                             config.addr_set_bitwidth));
-                bus->requestWriteTransfer(ext_addr, &bus_buffer[0], burst_length, initiator_id);
+            uint32_t tag = tag_memory[flush_counter - 1];
+            uint32_t ext_addr =
+                cache_ext_addr / config.associativity +
+                (tag << (config.addr_word_bitwidth + config.addr_word_select_bitwidth +
+                         config.addr_set_bitwidth));
+            bus->requestWriteTransfer(ext_addr, &bus_buffer[0], burst_length, 0);
 
-                cur_bus_request.is_waiting_for_wdata = true;
-                cur_bus_request.is_waiting_for_bus = true;
-            }
+            cur_bus_request.is_waiting_for_wdata = true;
+            cur_bus_request.is_waiting_for_bus = true;
+        }
 
-        } else {
-            if (burst_wait_counter > 0) {
-                burst_wait_counter--;
-                if (burst_wait_counter == 0) {
-                    cur_bus_request.is_waiting_for_bus = false;
-                    if (flush_last) {
-                        flush_flag = false;
-                        cur_bus_request.is_done = true;
-                    }
+    } else {
+        if (burst_wait_counter > 0) {
+            burst_wait_counter--;
+            if (burst_wait_counter == 0) {
+                cur_bus_request.is_waiting_for_bus = false;
+                if (flush_last) {
+                    flush_flag = false;
+                    cur_bus_request.is_done = true;
                 }
-            } else if (bus->isWriteDataReady(initiator_id)) {
-                burst_wait_counter = config.line_size / bus_dataword_length_byte;
-                Statistics::get().getDCMAStat()->counters.bus_write_cycles += burst_wait_counter;
             }
+        } else if (bus->isWriteDataReady(0)) {
+            burst_wait_counter = config.line_size / bus_dataword_length_byte;
+            Statistics::get().getDCMAStat()->counters.bus_write_cycles += burst_wait_counter;
         }
     }
+}
+
+bool Cache::tickMshr(uint32_t mshr) {
+    auto& cur_bus_request = mshrs[mshr];
+    auto& burst_wait_counter = cur_bus_request.burst_wait_counter;
+    if (cur_bus_request.is_done) return false;
+
     // if cur request is not processed yet, start new bus transfer
-    else if (!cur_bus_request.is_done && !cur_bus_request.is_waiting_for_bus &&
-             !cur_bus_request.is_waiting_for_wdata) {
+    if (!cur_bus_request.is_waiting_for_bus && !cur_bus_request.is_waiting_for_wdata) {
         // get corresponding cache line according to addr
-        cur_bus_request.cache_line = getReplaceLine(cur_bus_request.byte_addr);
+        uint32_t cache_line = getReplaceLine(cur_bus_request.byte_addr);
+        if (cache_line == none) return false;  // set occupied by other line fills, retry
+        cur_bus_request.cache_line = cache_line;
         splitAddr(cur_bus_request.byte_addr,
             &cur_bus_request.tag,
             &cur_bus_request.set,
             &cur_bus_request.word);
+
+        auto& stat_counters = Statistics::get().getDCMAStat()->counters;
+        if (cur_bus_request.is_prefetch)
+            stat_counters.prefetch_line_fills++;
+        else
+            stat_counters.line_fills++;
+        if (valid_flags[cache_line] && prefetched_flags[cache_line])
+            stat_counters.prefetch_unused++;  // evicted before any access
+        prefetched_flags[cache_line] = false;
         valid_flags[cur_bus_request.cache_line] = false;
 
         // check if overwritten block is dirty
         if (dirty_flags[cur_bus_request.cache_line]) {
-            uploadCacheLine();
+            uploadCacheLine(mshr);
         } else {
-            downloadCacheLine();
+            downloadCacheLine(mshr);
         }
 
         dirty_flags[cur_bus_request.cache_line] = false;
+        return false;
     }
+
     // if cur request is ongoing, check if read/write data can be read/written
-    else if (cur_bus_request.is_waiting_for_bus) {
-        if (burst_wait_counter > 0) {
-            burst_wait_counter--;
-            if (burst_wait_counter == 0) {
-                if (!cur_bus_request.is_waiting_for_wdata) {
-                    // download finished
-                    cur_bus_request.is_done = true;
-                    cur_bus_request.is_waiting_for_bus = false;
-                    valid_flags[cur_bus_request.cache_line] = true;
-                    tag_memory[cur_bus_request.cache_line] = cur_bus_request.tag;
-                } else {
-                    // upload of dirty cache line finished
-                    cur_bus_request.is_waiting_for_wdata = false;
-                    dirty_flags[cur_bus_request.cache_line] = false;
-                    // download new cache line
-                    downloadCacheLine();
-                }
-            }
-        } else {
-            Statistics::get().getDCMAStat()->counters.bus_wait_cycles++;
+    if (burst_wait_counter > 0) {
+        burst_wait_counter--;
+        if (burst_wait_counter == 0) {
             if (!cur_bus_request.is_waiting_for_wdata) {
-                if (bus->isReadDataAvailable(initiator_id)) {
-                    // read complete cache line from bus to buffer
-                    bus->readData(&bus_buffer[0], initiator_id);
-
-                    // write bus data from buffer to cache
-                    uint32_t bram_idx;
-                    uint32_t bram_addr;
-                    for (int i = 0; i < config.line_size; i = i + dma_dataword_length_byte) {
-                        bram_idx = getBramIdx(
-                            mergeAddr(cur_bus_request.cache_line, i / dma_dataword_length_byte));
-                        bram_addr = getBramAddr(
-                            mergeAddr(cur_bus_request.cache_line, i / dma_dataword_length_byte));
-                        brams[bram_idx].write(bram_addr, &bus_buffer[i]);
-                    }
-
-                    burst_wait_counter = config.line_size / bus_dataword_length_byte;
-
-                    Statistics::get().getDCMAStat()->counters.bus_read_cycles += burst_wait_counter;
-                    Statistics::get().getDCMAStat()->counters.bus_wait_cycles--;
-                }
+                // download finished
+                read_channel_mshr = none;
+                cur_bus_request.is_done = true;
+                cur_bus_request.is_waiting_for_bus = false;
+                valid_flags[cur_bus_request.cache_line] = true;
+                tag_memory[cur_bus_request.cache_line] = cur_bus_request.tag;
+                prefetched_flags[cur_bus_request.cache_line] = cur_bus_request.is_prefetch;
+                uint32_t set_offset = cur_bus_request.set * config.associativity;
+                touchLine(set_offset, cur_bus_request.cache_line - set_offset, true);
             } else {
-                if (bus->isWriteDataReady(initiator_id)) {
-                    burst_wait_counter = config.line_size / bus_dataword_length_byte;
-                    Statistics::get().getDCMAStat()->counters.bus_write_cycles +=
-                        burst_wait_counter;
-                    Statistics::get().getDCMAStat()->counters.bus_wait_cycles--;
-                }
+                // upload of dirty cache line finished
+                write_channel_mshr = none;
+                cur_bus_request.is_waiting_for_wdata = false;
+                dirty_flags[cur_bus_request.cache_line] = false;
+                // download new cache line
+                downloadCacheLine(mshr);
             }
         }
+        return false;
     }
+
+    if (!cur_bus_request.is_waiting_for_wdata) {
+        if (read_channel_mshr == none && bus->isReadDataAvailable(mshr)) {
+            // read complete cache line from bus to buffer
+            auto& bus_buffer = cur_bus_request.bus_buffer;
+            bus->readData(&bus_buffer[0], mshr);
+
+            // write bus data from buffer to cache
+            uint32_t bram_idx;
+            uint32_t bram_addr;
+            for (int i = 0; i < config.line_size; i = i + dma_dataword_length_byte) {
+                bram_idx = getBramIdx(
+                    mergeAddr(cur_bus_request.cache_line, i / dma_dataword_length_byte));
+                bram_addr = getBramAddr(
+                    mergeAddr(cur_bus_request.cache_line, i / dma_dataword_length_byte));
+                brams[bram_idx].write(bram_addr, &bus_buffer[i]);
+            }
+
+            burst_wait_counter = config.line_size / bus_dataword_length_byte;
+            read_channel_mshr = mshr;
+
+            Statistics::get().getDCMAStat()->counters.bus_read_cycles += burst_wait_counter;
+            return false;
+        }
+    } else {
+        if (write_channel_mshr == none && bus->isWriteDataReady(mshr)) {
+            burst_wait_counter = config.line_size / bus_dataword_length_byte;
+            write_channel_mshr = mshr;
+            Statistics::get().getDCMAStat()->counters.bus_write_cycles += burst_wait_counter;
+            return false;
+        }
+    }
+    return true;
 }
 
 /**
@@ -420,56 +525,85 @@ uint32_t Cache::getReplaceLine(uint32_t addr) {
 
     uint32_t set_offset = set * config.associativity;
 
+    // lines of outstanding line fills (other mshrs) can not be replaced
+    uint32_t free_lines = 0;
+    for (int i = 0; i < config.associativity; ++i) {
+        if (!isReserved(set_offset + i)) free_lines++;
+    }
+    if (free_lines == 0) return none;
+
     // if there is an unused block, return that
     for (int i = 0; i < config.associativity; ++i) {
-        if (!valid_flags[set_offset + i]) return set_offset + i;
+        if (!valid_flags[set_offset + i] && !isReserved(set_offset + i)) return set_offset + i;
     }
 
     // else use replacement policy
     if (replacement_policy == ReplacementPolicy::FIFO) {
-        uint32_t cur_pointer = replacement_memory[set];
+        uint32_t cur_pointer;
+        do {
+            cur_pointer = replacement_memory[set];
 
-        if (cur_pointer == config.associativity - 1)
-            replacement_memory[set] = 0;
-        else
-            replacement_memory[set]++;
+            if (cur_pointer == config.associativity - 1)
+                replacement_memory[set] = 0;
+            else
+                replacement_memory[set]++;
+        } while (isReserved(set_offset + cur_pointer));
 
         return set_offset + cur_pointer;
     } else if (replacement_policy == ReplacementPolicy::LRU) {
         // get least recently used cache line in a set
-        uint32_t lru_line = 0;
-        for (int i = 1; i < config.associativity; ++i) {
-            if (replacement_memory[set_offset + i] > replacement_memory[set_offset + lru_line])
-                lru_line = i;
-        }
-
-        // increment replacement memory of other lines in a set
+        uint32_t lru_line = none;
         for (int i = 0; i < config.associativity; ++i) {
-            if (i == lru_line)
-                replacement_memory[set_offset + lru_line] = 0;
-            else
-                replacement_memory[set_offset + i]++;
+            if (isReserved(set_offset + i)) continue;
+            if (lru_line == none ||
+                replacement_memory[set_offset + i] > replacement_memory[set_offset + lru_line])
+                lru_line = i;
         }
 
         return set_offset + lru_line;
     } else if (replacement_policy == ReplacementPolicy::LFU) {
         // get least frequently used cache line in a set
-        uint32_t lfu_line = 0;
-        for (int i = 1; i < config.associativity; ++i) {
-            if (replacement_memory[set_offset + i] < replacement_memory[set_offset + lfu_line])
+        uint32_t lfu_line = none;
+        for (int i = 0; i < config.associativity; ++i) {
+            if (isReserved(set_offset + i)) continue;
+            if (lfu_line == none ||
+                replacement_memory[set_offset + i] < replacement_memory[set_offset + lfu_line])
                 lfu_line = i;
         }
 
-        replacement_memory[set_offset + lfu_line] = 0;
-
         return set_offset + lfu_line;
     } else if (replacement_policy == ReplacementPolicy::Random) {
-        std::random_device rd;   // obtain a random number from hardware
-        std::mt19937 gen(rd());  // seed the generator
-        std::uniform_int_distribution<> distr(0, config.associativity - 1);  // define the range
-        return set_offset + distr(gen);
+        std::uniform_int_distribution<> distr(0, free_lines - 1);  // define the range
+        int pick = distr(random_generator);
+        for (int i = 0; i < config.associativity; ++i) {
+            if (!isReserved(set_offset + i) && pick-- == 0) return set_offset + i;
+        }
+    }
+    return none;
+}
+
+void Cache::touchLine(uint32_t set_offset, uint32_t line, bool filled) {
+    if (replacement_policy == ReplacementPolicy::LRU) {
+        // age of the other lines in the set (the line itself is the most recently used)
+        for (int i = 0; i < config.associativity; ++i) {
+            if (i == line)
+                replacement_memory[set_offset + line] = 0;
+            else
+                replacement_memory[set_offset + i]++;
+        }
+    } else if (replacement_policy == ReplacementPolicy::LFU) {
+        if (filled)
+            replacement_memory[set_offset + line] = 1;
+        else
+            replacement_memory[set_offset + line]++;
+    }
+}
+
+void Cache::countAccess(uint32_t cache_line) {
+    if (prefetched_flags[cache_line]) {
+        prefetched_flags[cache_line] = false;
+        Statistics::get().getDCMAStat()->counters.prefetch_useful++;
     }
-    return -1;
 }
 
 /**
@@ -498,6 +632,7 @@ uint32_t Cache::getBramAddr(uint32_t addr) {
  */
 void Cache::reset() {
     valid_flags = std::vector<bool>(config.nr_lines, false);
+    prefetched_flags = std::vector<bool>(config.nr_lines, false);
     dirty_flags = std::vector<bool>(config.nr_lines, false);
     tag_memory = std::vector<uint32_t>(config.nr_lines, 0);
 
@@ -513,6 +648,39 @@ void Cache::reset() {
     }
 }
 
+void Cache::saveState(Checkpoint::Writer& w) {
+    w.data(tag_memory.data(), tag_memory.size() * sizeof(uint32_t));
+    for (uint32_t i = 0; i < config.nr_lines; ++i) {
+        w.value(uint8_t(valid_flags[i] | dirty_flags[i] << 1 | prefetched_flags[i] << 2));
+    }
+    w.value(uint32_t(replacement_memory.size()));
+    w.data(replacement_memory.data(), replacement_memory.size() * sizeof(uint32_t));
+    for (auto& bram : brams) {
+        w.data(bram.getMemory(), bram.getByteSize());
+    }
+}
+
+void Cache::restoreState(Checkpoint::Reader& r) {
+    r.data(tag_memory.data(), tag_memory.size() * sizeof(uint32_t));
+    for (uint32_t i = 0; i < config.nr_lines; ++i) {
+        uint8_t flags = 0;
+        r.value(flags);
+        valid_flags[i] = flags & 0b01;
+        dirty_flags[i] = flags & 0b10;
+        prefetched_flags[i] = flags & 0b100;  // prefetch statistics
+    }
+    uint32_t replacement_size = 0;
+    r.value(replacement_size);
+    if (replacement_size != replacement_memory.size()) {
+        r.fail("cache replacement policy differs");
+        return;
+    }
+    r.data(replacement_memory.data(), replacement_memory.size() * sizeof(uint32_t));
+    for (auto& bram : brams) {
+        r.data(bram.getMemory(), bram.getByteSize());
+    }
+}
+
 /**
  * flushes cache
  */
@@ -520,5 +688,5 @@ void Cache::flush() {
     flush_counter = 0;
     flush_flag = true;
     flush_last = false;
-    cur_bus_request.is_done = false;
+    mshrs[0].is_done = false;
 }
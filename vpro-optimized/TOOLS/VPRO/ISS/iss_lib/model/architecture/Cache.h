@@ -24,6 +24,11 @@
 #include "bram.h"
 #include "stats/Statistics.h"
 
+namespace Checkpoint {
+class Writer;
+class Reader;
+}  // namespace Checkpoint
+
 #ifdef ISS_STANDALONE
 
 #include "NonBlockingMainMemory.h"
@@ -32,23 +37,79 @@
 
 class Cache {
    public:
+    enum ReplacementPolicy : uint32_t {
+        FIFO,  // First In First Out
+        LRU,   // Least Recently Used
+        LFU,   // Least Frequently Used
+        Random
+    };
+
+    /**
+     * replacement policy of the cache and prefetcher of the DCMA (see DCMAPrefetcher)
+     */
+    struct Policy {
+        uint32_t replacement = FIFO;
+        uint32_t prefetch = 0;  // DCMAPrefetcher::Mode, 0: off
+        uint32_t prefetch_degree = 1;
+    };
+
+    /**
+     * parallelism of the cache model (default: one line fill at a time, as the DCMA hardware)
+     */
+    struct Concurrency {
+        uint32_t mshrs = 1;           // outstanding line fills (miss status holding registers)
+        uint32_t bram_ports = 1;      // 128-bit accesses per bram and cycle
+        uint32_t hit_under_miss = 1;  // 0: no hit is serviced while a line fill is outstanding
+    };
+
     Cache(ISS* core,
         uint32_t line_size,
         uint32_t associativity,
         uint32_t nr_brams,
         uint32_t bram_size_byte,
-        NonBlockingBusSlaveInterface* bus);
+        NonBlockingBusSlaveInterface* bus,
+        const Concurrency& concurrency,
+        const Policy& policy);
 
     void dmaReadDataHit(uint32_t addr, uint8_t* data_ptr);
 
     void dmaWriteDataHit(uint32_t addr, uint8_t* data_ptr);
 
-    void dmaRequestDownloadCacheLine(uint32_t byte_addr, uint32_t initiator_id);
+    /**
+     * start a cache line download in a free mshr (see hasFreeMshr)
+     * @param prefetch line is not requested by a dma yet (statistics)
+     */
+    void dmaRequestDownloadCacheLine(uint32_t byte_addr, uint32_t initiator_id, bool prefetch = false);
+
+    /**
+     * a new line fill can be started (free mshr, no flush)
+     */
+    bool hasFreeMshr();
+
+    /**
+     * the line of addr is already requested by a mshr
+     */
+    bool isPending(uint32_t addr);
+
+    /**
+     * number of mshrs with an outstanding line fill / upload
+     */
+    uint32_t activeMshrs();
+
+    uint32_t getMshrs() const {
+        return uint32_t(mshrs.size());
+    }
 
     void flush();
 
     void reset();
 
+    /**
+     * tags, flags, replacement memory and data of the brams (only valid if not busy)
+     */
+    void saveState(Checkpoint::Writer& w);
+    void restoreState(Checkpoint::Reader& r);
+
     bool isBusy();
 
     bool isAccessReady(uint32_t addr_in);
@@ -57,20 +118,26 @@ class Cache {
 
     void tick();
 
-   private:
-    enum ReplacementPolicy {
-        FIFO,  // First In First Out
-        LRU,   // Least Recently Used
-        LFU,   // Least Frequently Used
-        Random
-    };
+    /**
+     * next event scheduling (see DCMA::ticksToNextEvent): number of ticks before the tick that
+     * completes a burst, 0 if the next tick starts a line fill / bus transfer or flushes,
+     * UINT64_MAX if the mshrs only wait for the bus (its event) or none is active
+     */
+    uint64_t ticksToNextEvent();
 
+    /**
+     * replaces tick() for the given number of clock cycles (only valid if < ticksToNextEvent())
+     */
+    void skipTicks(uint64_t ticks);
+
+   private:
     // constants
     constexpr static int dma_dataword_length_byte = 16 / 8;
     constexpr static int dcma_dataword_length_byte = 128 / 8;
     constexpr static int bus_dataword_length_byte = 512 / 8;
-    constexpr static uint32_t initiator_id = 0;
-    ReplacementPolicy replacement_policy = FIFO;
+    constexpr static uint32_t none = UINT32_MAX;  // no mshr / line
+    uint32_t replacement_policy = FIFO;
+    std::mt19937 random_generator{0};  // fixed seed, reproducible simulations
 
     struct Config {
         uint32_t nr_lines;   // cache size = nr_lines * lines_size
@@ -93,9 +160,23 @@ class Cache {
         uint32_t cache_line;           // resulting cache line calculated from byte_addr
         bool is_read;
         bool is_waiting_for_bus = false;
-        bool is_waiting_for_wdata;
+        bool is_waiting_for_wdata = false;
         bool is_done = true;
-    } cur_bus_request;
+        bool is_prefetch = false;
+
+        // virtual buffer for cache line, this will not be in hardware
+        std::vector<uint8_t> bus_buffer;
+        uint32_t
+            burst_wait_counter{0};  // memory gives/takes complete burst word, with this counter we wait the burst delay
+    };
+
+    // line fills, the index is the bus initiator id (mshr 0 is used by the flush)
+    std::vector<Request> mshrs;
+    bool hit_under_miss;
+
+    // mshr transferring on the bus read / write data channel (one burst at a time)
+    uint32_t read_channel_mshr = none;
+    uint32_t write_channel_mshr = none;
 
     // object pointers// object pointers
     NonBlockingBusSlaveInterface* bus;
@@ -107,15 +188,11 @@ class Cache {
     std::vector<uint32_t> tag_memory;
     std::vector<bool> dirty_flags;
     std::vector<bool> valid_flags;
+    std::vector<bool> prefetched_flags;  // filled by a prefetch, not accessed yet (statistics)
 
     // memory for cache replacement policies
     std::vector<uint32_t> replacement_memory;  // stores information for replacement algorithms
 
-    // virtual buffer for cache line, this will not be in hardware
-    std::vector<uint8_t> bus_buffer;
-    uint32_t
-        burst_wait_counter{0};  // memory gives/takes complete burst word, with this counter we wait the burst delay
-
     // flush
     bool flush_flag = false;
     bool flush_last = false;
@@ -126,14 +203,40 @@ class Cache {
 
     uint32_t mergeAddr(uint32_t cache_line, uint32_t word);
 
-    void uploadCacheLine();
+    void uploadCacheLine(uint32_t mshr);
+
+    void downloadCacheLine(uint32_t mshr);
 
-    void downloadCacheLine();
+    /**
+     * @return whether the mshr waits for the bus (no data transfer this cycle)
+     */
+    bool tickMshr(uint32_t mshr);
+
+    void tickFlush();
+
+    /**
+     * line is the victim of another outstanding line fill
+     */
+    bool isReserved(uint32_t cache_line);
 
     uint32_t calcLineAlignedAddr(uint32_t addr);
 
+    /**
+     * @return cache line to replace, none if all lines of the set are reserved
+     */
     uint32_t getReplaceLine(uint32_t addr);
 
+    /**
+     * update the replacement memory of an accessed or newly filled line
+     * @param line within the set
+     */
+    void touchLine(uint32_t set_offset, uint32_t line, bool filled);
+
+    /**
+     * statistics of a dma access to a line
+     */
+    void countAccess(uint32_t cache_line);
+
     uint32_t getBramIdx(uint32_t addr);
 
     uint32_t getBramAddr(uint32_t addr);
@@ -10,6 +10,7 @@
 #include <limits>  // std::numeric_limits
 
 #include "../../simulator/ISS.h"
+#include "../../simulator/helper/checkpoint.h"
 #include "../../simulator/helper/debugHelper.h"
 #include "../../simulator/helper/typeConversion.h"
 #include "Cluster.h"
@@ -60,8 +61,24 @@ void Cluster::memory_access_callback(
 };
 #endif
 
+void Cluster::saveState(Checkpoint::Writer& w) {
+    w.value(vpro_time);
+    w.value(dma_time);
+    for (auto& unit : units) {
+        unit->saveState(w);
+    }
+}
+
+void Cluster::restoreState(Checkpoint::Reader& r) {
+    r.value(vpro_time);
+    r.value(dma_time);
+    for (auto& unit : units) {
+        unit->restoreState(r);
+    }
+}
+
 bool Cluster::isBusy() {
-    for (auto unit : units) {
+    for (auto& unit : units) {
         if (unit->isBusy()) return true;
     }
 
@@ -72,47 +89,102 @@ bool Cluster::isBusy() {
  * Clock tick
  */
 void Cluster::tick() {
+    tickDMA();
+    if (tickVPRO() && cluster_id == VPRO_CFG::CLUSTERS - 1)
+        Statistics::get().tick(Statistics::clock_domains::VPRO);
+}
+
+void Cluster::tickDMA() {
     // cascade to DMAs
-    if (dma_time <= time) {
-        if (debug & DEBUG_TICK)
-            printf("DMA Clock Cycle %.2lf (DMA Time: %.2lf ns) in Cluster %i\n",
-                dma_time / core->getDMAClockPeriod(),
-                dma_time,
-                cluster_id);
-        dma_time += core->getDMAClockPeriod();
-        dma->tick();
+    if (tickDMALocal()) {
+        dma->tickTransfer();
         if (cluster_id == VPRO_CFG::CLUSTERS - 1)
             Statistics::get().tick(Statistics::clock_domains::DMA);
     }
+}
+
+bool Cluster::tickDMALocal() {
+    if (dma_time > time) return false;
+    if (if_debug(DEBUG_TICK))
+        printf("DMA Clock Cycle %.2lf (DMA Time: %.2lf ns) in Cluster %i\n",
+            dma_time / core->getDMAClockPeriod(),
+            dma_time,
+            cluster_id);
+    dma_time += core->getDMAClockPeriod();
+    dma->tickLocal();
+    return true;
+}
 
+bool Cluster::tickVPRO() {
     // check if time for clock tick is up
     if (vpro_time <= time) {
-        if (debug & DEBUG_TICK)
+        if (if_debug(DEBUG_TICK))
             printf("VPRO Clock Cycle %.2lf (VPRO Time: %.2lf ns) in Cluster %i\n",
                 vpro_time / core->getVPROClockPeriod(),
                 vpro_time,
                 cluster_id);
         vpro_time += core->getVPROClockPeriod();
         // cascade tick to units -> lanes
-
-        for (auto unit : units) {
-            unit->tick();
+        if (core->isIdleSkipAllowed() && isVPROIdle()) {
+            for (auto& unit : units) {
+                unit->idleTick();
+            }
+        } else {
+            for (auto& unit : units) {
+                unit->tick();
+            }
+            for (auto& unit : units) {
+                unit->update();
+            }
         }
-        for (auto unit : units) {
-            unit->update();
+        return true;
+    }
+    return false;
+}
+
+bool Cluster::isVPROIdle() {
+    // units exchange chain data (LS), skip only if all of them are idle
+    for (auto& unit : units) {
+        if (!unit->isIdle()) return false;
+    }
+    return true;
+}
+
+bool Cluster::isIdle() {
+    return isVPROIdle() && !dma->isBusy();
+}
+
+uint64_t Cluster::ticksToNextEvent() {
+    if (!isVPROIdle()) return 0;
+    return dma->ticksToNextEvent();
+}
+
+/**
+ * skip the dma/vpro clock ticks until (including) the given time.
+ * Only valid before the next event (see ticksToNextEvent()), a dma tick only polls the dcma then
+ * @param until sim time of last skipped tick
+ */
+void Cluster::skipTicks(const double& until) {
+    uint64_t dma_ticks = ISS::skipClockEdges(dma_time, core->getDMAClockPeriod(), time, until);
+    uint64_t vpro_ticks = ISS::skipClockEdges(vpro_time, core->getVPROClockPeriod(), time, until);
+    if (vpro_ticks > 0) {
+        for (auto& unit : units) {
+            unit->idleTick(vpro_ticks);
         }
-        if (cluster_id == VPRO_CFG::CLUSTERS - 1)
-            Statistics::get().tick(Statistics::clock_domains::VPRO);
+    }
+    if (cluster_id == VPRO_CFG::CLUSTERS - 1) {
+        Statistics::get().skipTicks(Statistics::clock_domains::DMA, dma_ticks);
+        Statistics::get().skipTicks(Statistics::clock_domains::VPRO, vpro_ticks);
     }
 }
 
 bool Cluster::isReadyForCommand() {
-    for (auto unit : units) {
+    for (auto& unit : units) {
         if (unit->isCmdQueueFull()) return false;
     }
     if (waitBusy) {
         bool busy = false;
-        for (auto unit : units) {
+        for (auto& unit : units) {
             busy |= unit->isBusy();
         }
         if (!busy) waitBusy = false;
@@ -148,13 +220,13 @@ void Cluster::setWaitingForVPRO(bool vpro) {
 bool Cluster::sendCMD(std::shared_ptr<CommandBase> cmd) {
     if (cmd->class_type == CommandBase::VPRO) {
         auto vprocmd = std::dynamic_pointer_cast<CommandVPRO>(cmd);
-        if (debug & DEBUG_INSTRUCTION_SCHEDULING || debug & DEBUG_INSTRUCTION_SCHEDULING_BASIC) {
+        if (if_debug(DEBUG_INSTRUCTION_SCHEDULING | DEBUG_INSTRUCTION_SCHEDULING_BASIC)) {
             printf("Cluster %i Got a new VPRO command (@time = %.2lf):", cluster_id, time);
             printf("\n\t");
             print_cmd(vprocmd.get());
         }
         uint32_t ret = 0;
-        for (auto unit : units) {
+        for (auto& unit : units) {
             //*********************************************
             // Check global mask (for this unit)
             //*********************************************
@@ -173,7 +245,7 @@ bool Cluster::sendCMD(std::shared_ptr<CommandBase> cmd) {
         return (ret == 0);
     } else if (cmd->class_type == CommandBase::DMA) {
         auto dmacmd = std::dynamic_pointer_cast<CommandDMA>(cmd);
-        if (debug & DEBUG_INSTRUCTION_SCHEDULING) {
+        if (if_debug(DEBUG_INSTRUCTION_SCHEDULING)) {
             printf("Cluster %i Got a new DMA command (@time = %.2lf):\n", cluster_id, time);
             printf("\t");
             print_cmd(dmacmd.get());
@@ -187,6 +259,45 @@ bool Cluster::sendCMD(std::shared_ptr<CommandBase> cmd) {
     }
 }
 
+void Cluster::executeFunctional(const std::shared_ptr<CommandBase>& cmd) {
+    if (cmd->class_type == CommandBase::VPRO) {
+        CommandVPRO vprocmd(std::dynamic_pointer_cast<CommandVPRO>(cmd).get());
+        if (if_debug(DEBUG_INSTRUCTION_SCHEDULING | DEBUG_INSTRUCTION_SCHEDULING_BASIC)) {
+            printf("Cluster %i executes a VPRO command (functional):", cluster_id);
+            printf("\n\t");
+            print_cmd(&vprocmd);
+        }
+        vprocmd.decode();
+        for (auto& unit : units) {
+            uint32_t unit_mask = 1u << unit->id();
+            if (unit_mask & architecture_state->unit_mask_global) {
+                unit->issueFunctional(vprocmd);
+            }
+        }
+        // LS lanes chain across units -> run until no unit makes progress
+        bool progress = true;
+        while (progress) {
+            progress = false;
+            for (auto& unit : units) {
+                progress |= unit->runFunctional();
+            }
+        }
+        // one element per cycle, lanes and units in parallel
+        functional_vpro_cycles +=
+            uint64_t(vprocmd.x_end + 1) * (vprocmd.y_end + 1) * (vprocmd.z_end + 1);
+    } else if (cmd->class_type == CommandBase::DMA) {
+        auto dmacmd = std::dynamic_pointer_cast<CommandDMA>(cmd);
+        if (if_debug(DEBUG_INSTRUCTION_SCHEDULING)) {
+            printf("Cluster %i executes a DMA command (functional):\n", cluster_id);
+            printf("\t");
+            print_cmd(dmacmd.get());
+        }
+        functional_dma_cycles += dma->execute_cmd_functional(dmacmd);
+    } else {
+        printf_warning("Unknown Command type in Cluster %i received (functional)!\n", cluster_id);
+    }
+}
+
 void Cluster::dumpQueue(uint32_t unit) {
     this->units[unit]->dumpQueue();
 }
@@ -18,7 +18,6 @@
 #include <list>
 #include <vector>
 
-#include <QMutex>
 #include <QThread>
 
 #include <vpro/vpro_special_register_enums.h>
@@ -38,28 +37,59 @@ class Cluster : public QThread {
     DMA* dma;
     ISS* core;
 
-#ifdef THREAD_CLUSTER
-    QMutex tick_en;
-    QMutex tick_done;
-#endif
-
     Cluster(ISS* core,
         int id,
         std::shared_ptr<ArchitectureState> architecture_state,
         DCMA* dcma,
         double& time);
 
-#ifdef THREAD_CLUSTER
-    [[noreturn]] void run() override {
-        while (true) {
-            tick_en.lock();
-            tick();
-            tick_done.unlock();
-        }
+    void tick();
+
+    /**
+     * dma clock domain (tickDMALocal() + the transfer of the dma through the shared DCMA)
+     */
+    void tickDMA();
+
+    /**
+     * dma clock edge: cluster local part of the dma tick (see DMA::tickLocal()), may run in parallel
+     * to other clusters. The transfer (DMA::tickTransfer()) and the DMA statistic tick follow in
+     * cluster order
+     * @return whether a dma clock edge was processed
+     */
+    bool tickDMALocal();
+
+    /**
+     * vpro clock domain (units + lanes). Cluster local, may run in parallel to other clusters.
+     * The VPRO statistic tick is not included (done by tick() of the last cluster)
+     * @return whether a vpro clock edge was processed
+     */
+    bool tickVPRO();
+
+    [[nodiscard]] bool isVPROClockEdge() const {
+        return vpro_time <= time;
     }
-#endif
 
-    void tick();
+    [[nodiscard]] bool isDMAClockEdge() const {
+        return dma_time <= time;
+    }
+
+    /**
+     * all units idle (see Unit::VectorUnit::isIdle())
+     */
+    bool isVPROIdle();
+
+    /**
+     * units and dma idle
+     */
+    bool isIdle();
+
+    /**
+     * next event scheduling (see ISS::skipToNextEvent): 0 if the units or the dma change their state
+     * in the next tick, else UINT64_MAX (idle, or the dma waits for the dcma)
+     */
+    uint64_t ticksToNextEvent();
+
+    void skipTicks(const double& until);
 
 #ifndef ISS_STANDALONE
     // FK: Callback for accessing core methods
@@ -73,6 +103,23 @@ class Cluster : public QThread {
      */
     bool sendCMD(std::shared_ptr<CommandBase> cmd);
 
+    /**
+     * functional mode (see FUNCTIONAL_MODE): vpro commands are executed until all lanes are done or
+     * wait for chaining data of a following command, dma commands are transferred at once
+     * @param cmd vpro or dma command
+     */
+    void executeFunctional(const std::shared_ptr<CommandBase>& cmd);
+
+    // functional mode: estimated cycles of the executed vpro (vpro clock) and dma (dma clock) commands
+    uint64_t functional_vpro_cycles{0};
+    uint64_t functional_dma_cycles{0};
+
+    /**
+     * clock domain times and the units state (LM, RF, accu) of an idle cluster (see ISS::checkpointSave)
+     */
+    void saveState(Checkpoint::Writer& w);
+    void restoreState(Checkpoint::Reader& r);
+
     void dumpLocalMemory(uint32_t unit);
 
     void dumpQueue(uint32_t unit);
@@ -0,0 +1,96 @@
+/**
+ * @file ClusterWorkerPool.cpp
+ *
+ * Parallel vpro tick of the clusters
+ */
+
+#include "ClusterWorkerPool.h"
+
+#include <chrono>
+
+#include "Cluster.h"
+#include "DMA.h"
+
+ClusterWorkerPool::ClusterWorkerPool(
+    std::vector<Cluster*>& clusters, int threads, bool parallel_dma)
+    : clusters(clusters),
+      threads(threads),
+      parallel_dma(parallel_dma) {
+    // thread 0 is the caller of tickDMA() / tickVPRO()
+    for (int i = 1; i < threads; i++) {
+        workers.emplace_back(&ClusterWorkerPool::work, this, i);
+    }
+}
+
+ClusterWorkerPool::~ClusterWorkerPool() {
+    stop.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ClusterWorkerPool::tickDMA() {
+    if (parallel_dma) {
+        run(Domain::DMA);
+    } else {
+        for (auto cluster : clusters) {
+            cluster->tickDMALocal();
+        }
+    }
+    // shared dcma (bram ports, line replacement, statistics): same order as the sequential tick
+    for (auto cluster : clusters) {
+        cluster->dma->tickTransfer();
+    }
+}
+
+void ClusterWorkerPool::tickVPRO() {
+    run(Domain::VPRO);
+}
+
+void ClusterWorkerPool::run(Domain tick_domain) {
+    domain = tick_domain;
+    pending.store(threads - 1, std::memory_order_relaxed);
+    generation.fetch_add(1, std::memory_order_release);
+
+    tickPartition(0);
+
+    uint32_t spins = 0;
+    while (pending.load(std::memory_order_acquire) > 0) {
+        backoff(spins);
+    }
+}
+
+void ClusterWorkerPool::work(int thread_id) {
+    uint64_t done_generation = 0;
+    while (true) {
+        uint32_t spins = 0;
+        while (generation.load(std::memory_order_acquire) == done_generation) {
+            if (stop.load(std::memory_order_acquire)) return;
+            backoff(spins);
+        }
+        done_generation++;
+
+        tickPartition(thread_id);
+
+        pending.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void ClusterWorkerPool::tickPartition(int thread_id) {
+    for (size_t c = thread_id; c < clusters.size(); c += threads) {
+        if (domain == Domain::DMA)
+            clusters[c]->tickDMALocal();
+        else
+            clusters[c]->tickVPRO();
+    }
+}
+
+void ClusterWorkerPool::backoff(uint32_t& spins) {
+    spins++;
+    if (spins < 4096) return;
+    if (spins < 65536) {
+        std::this_thread::yield();
+    } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(20));
+    }
+}
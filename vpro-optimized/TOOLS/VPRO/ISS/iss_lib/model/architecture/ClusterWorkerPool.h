@@ -0,0 +1,83 @@
+/**
+ * @file ClusterWorkerPool.h
+ *
+ * Fixed pool of threads to tick the clusters in parallel: the vpro domain (units + lanes) and the
+ * cluster local part of the dma tick (command start, padding, burst request to the dcma port).
+ * The clusters are statically partitioned to the threads (cluster i -> thread i % threads).
+ * The calling (simulator) thread processes partition 0, the workers are started by a
+ * generation counter and synchronized by a spin barrier once per clock cycle of the domain.
+ * The dma transfers through the shared dcma follow the barrier in cluster order.
+ */
+
+#ifndef VPRO_CPP_CLUSTERWORKERPOOL_H
+#define VPRO_CPP_CLUSTERWORKERPOOL_H
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+class Cluster;
+
+class ClusterWorkerPool {
+   public:
+    /**
+     * @param parallel_dma the dma requests are cluster local (DCMA::hasClusterPorts()), else the
+     * dma ticks stay sequential
+     */
+    ClusterWorkerPool(std::vector<Cluster*>& clusters, int threads, bool parallel_dma);
+
+    ~ClusterWorkerPool();
+
+    ClusterWorkerPool(ClusterWorkerPool const&) = delete;
+    void operator=(ClusterWorkerPool const&) = delete;
+
+    /**
+     * tick the dma domain of all clusters: the cluster local part in parallel (barrier), then the
+     * transfers in cluster order. The DMA statistic tick is not included
+     */
+    void tickDMA();
+
+    /**
+     * tick the vpro domain of all clusters (in parallel)
+     * returns after all clusters are done (barrier)
+     */
+    void tickVPRO();
+
+    [[nodiscard]] int getThreads() const {
+        return threads;
+    }
+
+   private:
+    std::vector<Cluster*>& clusters;
+    int threads;
+    bool parallel_dma;
+
+    enum class Domain { DMA, VPRO };
+    // domain of the current tick (written before the generation increment)
+    Domain domain{Domain::VPRO};
+
+    std::vector<std::thread> workers;
+
+    // incremented to start a new tick in all workers
+    std::atomic<uint64_t> generation{0};
+    // workers not yet done with the current tick
+    std::atomic<int> pending{0};
+    std::atomic<bool> stop{false};
+
+    /**
+     * tick the domain in all partitions, returns after all workers are done
+     */
+    void run(Domain tick_domain);
+
+    void work(int thread_id);
+
+    void tickPartition(int thread_id);
+
+    /**
+     * busy wait with backoff (yield, sleep) to not block the host on long risc phases
+     */
+    static void backoff(uint32_t& spins);
+};
+
+#endif  //VPRO_CPP_CLUSTERWORKERPOOL_H
@@ -3,6 +3,7 @@
 //
 
 #include "DCMA.h"
+#include "../../simulator/helper/checkpoint.h"
 
 DCMA::DCMA(ISS* core,
     NonBlockingBusSlaveInterface* bus,
@@ -10,10 +11,17 @@ DCMA::DCMA(ISS* core,
     uint32_t line_size,
     uint32_t associativity,
     uint32_t nr_brams,
-    uint32_t bram_size)
+    uint32_t bram_size,
+    const Cache::Concurrency& concurrency,
+    const Cache::Policy& policy)
     : core(core),
-      cache(core, line_size, associativity, nr_brams, bram_size, bus),
-      dcma_dma_mode(bus, number_cluster) {
+      cache(core, line_size, associativity, nr_brams, bram_size, bus, concurrency, policy),
+      dcma_dma_mode(bus, number_cluster),
+      // one mshr is kept for demand misses (see tick()): no prefetching with a single one
+      prefetcher(cache.getMshrs() >= 2 ? policy.prefetch : uint32_t(DCMAPrefetcher::OFF),
+          policy.prefetch_degree,
+          line_size,
+          number_cluster) {
     this->bus = bus;
     this->dmaRequests = std::vector<Request>(number_cluster);
     this->number_cluster = number_cluster;
@@ -23,6 +31,8 @@ DCMA::DCMA(ISS* core,
     this->params.bram_size = bram_size;
     this->params.line_size = line_size;
     this->params.associativity = associativity;
+    if (policy.prefetch != DCMAPrefetcher::OFF && cache.getMshrs() < 2)
+        printf_warning("[DCMA] Prefetcher disabled: it needs a second MSHR (--dcma-mshrs=2 or more)\n");
 }
 
 /**
@@ -43,6 +53,8 @@ void DCMA::requestDmaReadTransfer(
     cur_request.is_done = false;
     cur_request.latency_wait_counter = 6 * dcma_dataword_length_byte / dma_dataword_length_byte;
 
+    cur_request.observe = dcma_mode == REALISTIC && isCacheable(byte_addr);
+
     dmaRequests[initiator_id] = cur_request;
 }
 
@@ -61,12 +73,22 @@ void DCMA::requestDmaWriteTransfer(
     cur_request.id = initiator_id;
     cur_request.byte_addr = byte_addr;
     cur_request.burst_length = burst_length;
+    cur_request.is_read = false;
     cur_request.is_done = false;
     cur_request.latency_wait_counter = 9 * dcma_dataword_length_byte / dma_dataword_length_byte;
 
     dmaRequests[initiator_id] = cur_request;
 }
 
+void DCMA::commitRequests() {
+    for (auto& request : dmaRequests) {
+        if (!request.observe) continue;
+        request.observe = false;
+        prefetcher.observe(
+            request.id, request.byte_addr, request.burst_length * dma_dataword_length_byte);
+    }
+}
+
 /**
  * interface function for dma to read data if the data is ready
  * @param initiator_id cluster id
@@ -287,38 +309,89 @@ bool DCMA::isBusy(uint32_t initiator_id) {
  */
 void DCMA::tick() {
     if (dcma_mode == DMA) return dcma_dma_mode.tick();
-    if (!cache.isBusy()) {
+    if (cache.hasFreeMshr()) {
         // check if there are outstanding cache misses and request cache download
+        // (one per cycle, a line already requested by another cluster is not requested again)
         uint32_t cur_dma_id = pointer_nxt_dma_miss;
         Request* cur_req = &dmaRequests[cur_dma_id];
         intptr_t cur_addr =
             cur_req->byte_addr + cur_req->current_burst_iter * dma_dataword_length_byte;
-        if (!cur_req->is_done && !cache.isHit(cur_addr)) {
-#ifdef ISS_STANDALONE
-            if (cur_req->byte_addr <
-                reinterpret_cast<NonBlockingMainMemory*>(bus)->getMemByteSize())
-                cache.dmaRequestDownloadCacheLine(cur_addr, cur_dma_id);
-#else
+        bool requested = false;
+        if (!cur_req->is_done && !cache.isHit(cur_addr) && !cache.isPending(cur_addr) &&
+            isCacheable(cur_req->byte_addr)) {
             cache.dmaRequestDownloadCacheLine(cur_addr, cur_dma_id);
-#endif
+            requested = true;
         }
 
         pointer_nxt_dma_miss++;
         if (pointer_nxt_dma_miss >= number_cluster) pointer_nxt_dma_miss = 0;
+
+        // prefetches use mshrs not needed by a miss: none of the clusters waits for a line fill and
+        // one mshr stays free for the next demand miss
+        if (!requested && !hasDemandMiss() && cache.activeMshrs() + 1 < cache.getMshrs())
+            issuePrefetch();
     }
 
     cache.tick();
 }
 
+bool DCMA::hasDemandMiss() {
+    for (auto& req : dmaRequests) {
+        intptr_t addr = req.byte_addr + req.current_burst_iter * dma_dataword_length_byte;
+        if (!req.is_done && isCacheable(req.byte_addr) && !cache.isHit(addr) && !cache.isPending(addr))
+            return true;
+    }
+    return false;
+}
+
+void DCMA::issuePrefetch() {
+    while (!prefetcher.empty()) {
+        uint32_t addr = prefetcher.front();
+        prefetcher.pop();
+        if (isCacheable(addr) && !cache.isHit(addr) && !cache.isPending(addr)) {
+            cache.dmaRequestDownloadCacheLine(addr, 0, true);
+            return;
+        }
+    }
+}
+
+bool DCMA::isCacheable(intptr_t byte_addr) {
+#ifdef ISS_STANDALONE
+    return uint64_t(byte_addr) < reinterpret_cast<NonBlockingMainMemory*>(bus)->getMemByteSize();
+#else
+    return true;
+#endif
+}
+
 /**
  * resets cache by reseting all valid flags to false
  */
 void DCMA::reset() {
     cache.reset();
+    prefetcher.reset();
 
 //    Statistics::get().getDCMAStat()->reset();
 }
 
+void DCMA::saveState(Checkpoint::Writer& w) {
+    w.value(params);
+    w.value(pointer_nxt_dma_miss);
+    cache.saveState(w);
+}
+
+void DCMA::restoreState(Checkpoint::Reader& r) {
+    Params p;
+    r.value(p);
+    if (p.DCMA_OFF != params.DCMA_OFF || p.nr_brams != params.nr_brams ||
+        p.bram_size != params.bram_size || p.line_size != params.line_size ||
+        p.associativity != params.associativity) {
+        r.fail("dcma configuration differs");
+        return;
+    }
+    r.value(pointer_nxt_dma_miss);
+    cache.restoreState(r);
+}
+
 /**
  * flushes cache, make sure to call dma_wait_finish() before
  */
@@ -334,6 +407,42 @@ bool DCMA::isBusy() {
     return cache.isBusy();
 }
 
+bool DCMA::isIdle() {
+    if (dcma_mode == DMA) return false;  // no idle detection for this mode
+    if (cache.isBusy() || !prefetcher.empty()) return false;
+    for (auto& req : dmaRequests) {
+        if (!req.is_done) return false;
+    }
+    return true;
+}
+
+uint64_t DCMA::ticksToNextEvent() {
+    if (dcma_mode != REALISTIC) return isIdle() ? UINT64_MAX : 0;
+    // open dma requests poll a line which is neither available nor requested by them (pending)
+    for (auto& req : dmaRequests) {
+        if (req.is_done) continue;
+        intptr_t addr = req.byte_addr + req.current_burst_iter * dma_dataword_length_byte;
+        if (req.latency_wait_counter > 0 || req.is_new_access || !isCacheable(req.byte_addr) ||
+            cache.isHit(addr) || !cache.isPending(addr))
+            return 0;
+    }
+    if (cache.hasFreeMshr() && !prefetcher.empty() && cache.activeMshrs() + 1 < cache.getMshrs())
+        return 0;
+    return cache.ticksToNextEvent();
+}
+
+void DCMA::skipTicks(uint64_t ticks) {
+    if (ticks == 0) return;
+    // no miss to request: the round robin pointer moves on while a mshr is free
+    if (cache.hasFreeMshr()) pointer_nxt_dma_miss = (pointer_nxt_dma_miss + ticks) % number_cluster;
+    cache.skipTicks(ticks);
+}
+
+bool DCMA::isStalled(uint32_t initiator_id, bool is_read) {
+    auto& req = dmaRequests[initiator_id];
+    return !req.is_done && req.is_read == is_read;
+}
+
 bool DCMA::getDCMAOff() {
     if (this->params.DCMA_OFF)
         printf("DCMA is OFF\n");
@@ -357,3 +466,12 @@ uint32_t DCMA::getLineSize() {
 uint32_t DCMA::getAssociativity() {
     return this->params.associativity;
 }
+
+uint32_t DCMA::getMshrs() {
+    return cache.getMshrs();
+}
+
+uint32_t DCMA::getActiveMshrs() {
+    if (dcma_mode == DMA) return 0;
+    return cache.activeMshrs();
+}
@@ -11,6 +11,7 @@
 #include <queue>
 #include "../../simulator/helper/debugHelper.h"
 #include "Cache.h"
+#include "DCMAPrefetcher.h"
 #include "DCMA_DMA_mode.h"
 #include "NonBlockingBusSlaveInterface.h"
 #include "stats/Statistics.h"
@@ -36,7 +37,9 @@ class DCMA {
         uint32_t line_size,
         uint32_t associativity,
         uint32_t nr_brams,
-        uint32_t bram_size);
+        uint32_t bram_size,
+        const Cache::Concurrency& concurrency = Cache::Concurrency(),
+        const Cache::Policy& policy = Cache::Policy());
 
     void tick();
 
@@ -49,6 +52,20 @@ class DCMA {
         uint32_t burst_length,
         uint32_t initiator_id);  // burst_length in bus_word_length
 
+    /**
+     * the request functions only access the port (request) of the initiating cluster, the dmas may
+     * call them in parallel (see DMA::tickLocal). Not in DMA mode (one shared transfer unit)
+     */
+    bool hasClusterPorts() const {
+        return dcma_mode != DMA;
+    }
+
+    /**
+     * requests posted to the ports since the last call are observed by the prefetcher, in cluster order.
+     * Called after the dma tick of all clusters
+     */
+    void commitRequests();
+
     bool isReadDataAvailable(const uint32_t initiator_id);
 
     bool isWriteDataReady(const uint32_t initiator_id);
@@ -63,8 +80,38 @@ class DCMA {
 
     void flush();
 
+    /**
+     * cache content (only valid if idle, see ISS::checkpointSave)
+     */
+    void saveState(Checkpoint::Writer& w);
+    void restoreState(Checkpoint::Reader& r);
+
     bool isBusy();
 
+    /**
+     * no cache download/upload and no dma request open
+     */
+    bool isIdle();
+
+    /**
+     * next event scheduling (see ISS::skipToNextEvent): number of ticks before the next state change
+     * (completion of a line fill burst), 0 if the next tick or a poll of a dma changes the state,
+     * UINT64_MAX if idle or all line fills wait for the main memory (its event)
+     */
+    uint64_t ticksToNextEvent();
+
+    /**
+     * replaces tick() and the polls of the stalled dmas for the given number of clock cycles
+     * (only valid if < ticksToNextEvent())
+     */
+    void skipTicks(uint64_t ticks);
+
+    /**
+     * the read / write request of the cluster waits for a line fill (in a skipped tick, every open
+     * request does, see ticksToNextEvent())
+     */
+    bool isStalled(uint32_t initiator_id, bool is_read);
+
     bool getDCMAOff();
 
     uint32_t getNrRams();
@@ -75,6 +122,13 @@ class DCMA {
 
     uint32_t getAssociativity();
 
+    uint32_t getMshrs();
+
+    /**
+     * number of outstanding line fills (statistics)
+     */
+    uint32_t getActiveMshrs();
+
    private:
     // definitions
     enum DCMA_Mode {
@@ -83,14 +137,17 @@ class DCMA {
         DMA  // no cache, all DMA accesses are serviced sequentially as 512-bit burst transfers, no parallel DMA access
     };
 
-    struct Request {
+    // port of a cluster (one cache line each, written by the dma threads)
+    struct alignas(64) Request {
         uint32_t id{};
         uint32_t burst_length{};          // in dma datawords
         uint32_t current_burst_iter = 0;  // counts number of words already transfered to/from dma
         intptr_t byte_addr{};
         uint32_t latency_wait_counter{};
+        bool is_read = true;
         bool is_new_access = true;  // for hit/miss counter
         bool is_done = true;
+        bool observe = false;  // not yet observed by the prefetcher (see commitRequests())
     };
 
     struct Params {
@@ -108,6 +165,7 @@ class DCMA {
     NonBlockingBusSlaveInterface* bus;
     Cache cache;
     DCMA_DMA_mode dcma_dma_mode;
+    DCMAPrefetcher prefetcher;
 
     // local register/memory
     std::vector<uint8_t> buffer;
@@ -116,6 +174,21 @@ class DCMA {
 
     // DMA
     std::vector<Request> dmaRequests;
+
+    /**
+     * a cluster waits for a line which is not requested yet
+     */
+    bool hasDemandMiss();
+
+    /**
+     * line fill of the oldest queued prefetch (if a mshr is free)
+     */
+    void issuePrefetch();
+
+    /**
+     * addr in the main memory (else: host memory, not cached)
+     */
+    bool isCacheable(intptr_t byte_addr);
 };
 
 #endif  //TEMPLATE_DCMA_H
@@ -0,0 +1,58 @@
+/**
+ * @file DCMAPrefetcher.cpp
+ */
+
+#include "DCMAPrefetcher.h"
+
+#include <algorithm>
+
+DCMAPrefetcher::DCMAPrefetcher(uint32_t mode, uint32_t degree, uint32_t line_size, uint32_t streams)
+    : mode(mode),
+      degree(std::max(degree, 1u)),
+      line_size(line_size),
+      streams(streams) {}
+
+void DCMAPrefetcher::observe(uint32_t stream, uint32_t byte_addr, uint32_t bytes) {
+    if (mode == OFF || bytes == 0) return;
+
+    if (mode == NEXT_LINE) {
+        uint32_t last_line = (byte_addr + bytes - 1) / line_size * line_size;
+        enqueue(int64_t(last_line) + line_size, degree * line_size);
+        return;
+    }
+
+    // stride
+    if (stream >= streams.size()) streams.resize(stream + 1);
+    auto& s = streams[stream];
+    if (s.valid) {
+        int64_t stride = int64_t(byte_addr) - s.last_addr;
+        if (stride != 0 && stride == s.stride) {
+            s.confidence++;
+        } else {
+            s.confidence = 0;
+            s.stride = stride;
+        }
+    }
+    s.last_addr = byte_addr;
+    s.valid = true;
+
+    if (s.confidence == 0) return;
+    for (uint32_t k = 1; k <= degree; ++k) {
+        enqueue(int64_t(byte_addr) + k * s.stride, bytes);
+    }
+}
+
+void DCMAPrefetcher::enqueue(int64_t byte_addr, uint32_t bytes) {
+    if (byte_addr < 0 || byte_addr + bytes > int64_t(UINT32_MAX)) return;
+    int64_t first = byte_addr / line_size * line_size;
+    for (int64_t line = first; line < byte_addr + bytes; line += line_size) {
+        if (std::find(queue.begin(), queue.end(), uint32_t(line)) != queue.end()) continue;
+        if (queue.size() == max_queue_size) queue.pop_front();
+        queue.push_back(uint32_t(line));
+    }
+}
+
+void DCMAPrefetcher::reset() {
+    queue.clear();
+    std::fill(streams.begin(), streams.end(), Stream());
+}
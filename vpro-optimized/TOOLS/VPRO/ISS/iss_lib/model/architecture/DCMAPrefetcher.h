@@ -0,0 +1,76 @@
+/**
+ * @file DCMAPrefetcher.h
+ *
+ * Prefetcher of the DCMA cache model. Observes the DMA read requests of each cluster (one stream
+ * per cluster) and queues cache lines which are likely read next:
+ *  - next-line: the lines following the requested block
+ *  - stride: the block of the next request(s) if the distance of the last requests repeats
+ *    (e.g. the rows of a 2D transfer)
+ * The DCMA fills queued lines with free MSHRs if no cluster waits for a line fill. One MSHR is
+ * kept free for demand misses, i.e. prefetching needs --dcma-mshrs=2 or more.
+ */
+
+#ifndef VPRO_CPP_DCMAPREFETCHER_H
+#define VPRO_CPP_DCMAPREFETCHER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <deque>
+#include <vector>
+
+class DCMAPrefetcher {
+   public:
+    enum Mode : uint32_t { OFF = 0, NEXT_LINE = 1, STRIDE = 2 };
+
+    /**
+     * @param degree lines (next-line) / requests (stride) ahead
+     * @param streams number of initiators (clusters)
+     */
+    DCMAPrefetcher(uint32_t mode, uint32_t degree, uint32_t line_size, uint32_t streams);
+
+    /**
+     * dma read request of an initiator
+     */
+    void observe(uint32_t stream, uint32_t byte_addr, uint32_t bytes);
+
+    [[nodiscard]] bool empty() const {
+        return queue.empty();
+    }
+
+    /**
+     * oldest queued line address
+     */
+    [[nodiscard]] uint32_t front() const {
+        return queue.front();
+    }
+
+    void pop() {
+        queue.pop_front();
+    }
+
+    void reset();
+
+   private:
+    // queued lines (older are dropped if a stream runs ahead)
+    static constexpr size_t max_queue_size = 32;
+
+    struct Stream {
+        uint32_t last_addr = 0;
+        int64_t stride = 0;
+        uint32_t confidence = 0;  // number of repeated strides
+        bool valid = false;
+    };
+
+    uint32_t mode;
+    uint32_t degree;
+    uint32_t line_size;
+    std::vector<Stream> streams;
+    std::deque<uint32_t> queue;
+
+    /**
+     * queues the lines of [byte_addr, byte_addr + bytes)
+     */
+    void enqueue(int64_t byte_addr, uint32_t bytes);
+};
+
+#endif  //VPRO_CPP_DCMAPREFETCHER_H
@@ -5,10 +5,12 @@
 #include "DMA.h"
 #include "../../simulator/ISS.h"
 #include "../../simulator/helper/debugHelper.h"
+#include "../../simulator/helper/trace.h"
 #include "Cluster.h"
 #include "unit/VectorUnit.h"
 
 //## Integration
+#include <cstring>
 #include <iostream>
 
 DMA::DMA(Cluster* cluster,
@@ -28,22 +30,9 @@ DMA::DMA(Cluster* cluster,
 
     ext_addr_base_lst = -1;
     //    printf_info("SIM: \tInstanziated new DMA\n");
-
-    if (DMA_gen_trace) {
-        std::stringstream ss;
-        ss << "DMA_" << cluster->cluster_id << ".trace";
-        openTraceFile(ss.str().c_str());
-        std::stringstream ss2;
-        ss2 << "DMA_" << cluster->cluster_id << "_cmd.trace";
-        cmd_trace = std::ofstream(ss2.str().c_str());
-    }
 }
 
-DMA::~DMA() {
-    if (DMA_gen_trace) {
-        trace.close();
-    }
-}
+DMA::~DMA() = default;
 
 std::shared_ptr<CommandDMA> DMA::getCmd() {
     return command;
@@ -53,6 +42,12 @@ bool DMA::isBusy() {
     return !command->is_done() || !cmd_queue.empty() || dcma->isBusy(DMA::cluster->cluster_id);
 }
 
+uint64_t DMA::ticksToNextEvent() {
+    if (command->is_done()) return cmd_queue.empty() ? UINT64_MAX : 0;
+    // else the next burst is requested / a padding element is written
+    return cur_iteration.remaining_req_elements > 0 ? UINT64_MAX : 0;
+}
+
 void DMA::execute_cmd(const std::shared_ptr<CommandDMA>& cmd) {
     cmd->id = id_counter;
     id_counter++;
@@ -61,13 +56,14 @@ void DMA::execute_cmd(const std::shared_ptr<CommandDMA>& cmd) {
     auto command = cmd;
 
     if (DMA_gen_trace) {
-        uint32_t cycle_stamp = cluster->core->getTime() / cluster->core->getDMAClockPeriod();
-        cmd_trace << command->id << "," << cycle_stamp << "," << command->ext_base << ",";
-        if (is_read_transfer(*command))
-            cmd_trace << "r\n";
-        else
-            cmd_trace << "w\n";
-        cmd_trace.flush();
+        Trace::Writer::get().record(
+            is_read_transfer(*command) ? Trace::DMA_CMD_READ : Trace::DMA_CMD_WRITE,
+            cluster->cluster_id,
+            Trace::NONE,
+            Trace::NONE,
+            command->id,
+            command->ext_base,
+            command->loc_base);
     }
 
     if (cmd->x_size <= 0 || cmd->y_size <= 0) {
@@ -79,6 +75,76 @@ void DMA::execute_cmd(const std::shared_ptr<CommandDMA>& cmd) {
     }
 }
 
+uint64_t DMA::execute_cmd_functional(const std::shared_ptr<CommandDMA>& cmd) {
+    if (cmd->x_size <= 0 || cmd->y_size <= 0) {
+        cmd->print();
+        printf_error(
+            "[DMA] Command cannot transfer 0 elements! -> endless loop (hardware). At least one "
+            "elements required!\n");
+        exit(1);
+    }
+    cmd->id = id_counter;
+    id_counter++;
+    command = cmd;
+    Statistics::get().getDMAStat()->addExecutedCommand(command.get(), cluster->cluster_id);
+
+    // same iteration as tick(): padding elements one by one, the remaining row as one burst
+    const bool is_read = is_read_transfer(*command);
+    const uint32_t words_per_cycle = DCMA_DATA_WIDTH / DMA_DATA_WIDTH;
+    uint32_t nr_padding_pixels = 0;
+    if (command->type == CommandDMA::EXT_2D_TO_LOC_1D) {
+        if (command->pad[CommandDMA::PAD::LEFT])
+            nr_padding_pixels += architecture_state->dma_pad_left;
+        if (command->pad[CommandDMA::PAD::RIGHT])
+            nr_padding_pixels += architecture_state->dma_pad_right;
+    }
+    const uint32_t burst_length = command->x_size - nr_padding_pixels;
+
+    uint64_t cycles = 0;
+    Iteration it;
+    it.loc_addr = command->loc_base & 0x000fffffu;
+    it.ext_addr = command->ext_base;
+    for (it.y = 0; it.y < command->y_size; it.y++) {
+        it.x = 0;
+        while (it.x < command->x_size) {
+            if (is_padding_region(*command, it)) {
+                write_to_LM(it.loc_addr, (uint8_t*)(&architecture_state->dma_pad_value));
+                it.loc_addr++;
+                it.x++;
+                cycles++;
+                continue;
+            }
+            for (uint32_t i = 0; i < burst_length; i++) {
+                uint8_t data[DMA_DATA_WIDTH / 8];
+                if (is_read) {
+                    cluster->core->dbgMemRead(it.ext_addr + 2 * i, data, DMA_DATA_WIDTH / 8);
+                    write_to_LM(it.loc_addr, data);
+                } else {
+                    // loc to ext dma commands have only 1 unit
+                    auto word = units[command->unit.first()]->getLocalMemoryData(
+                        it.loc_addr, (DMA_DATA_WIDTH / 8));
+                    std::memcpy(data, &word, DMA_DATA_WIDTH / 8);
+                    cluster->core->dbgMemWrite(it.ext_addr + 2 * i, data, DMA_DATA_WIDTH / 8);
+                }
+                it.loc_addr++;
+            }
+            it.ext_addr += 2 * (burst_length + command->y_leap - 1);
+            it.x += burst_length;
+            // request + data words of the burst
+            cycles += 1 + (burst_length + words_per_cycle - 1) / words_per_cycle;
+        }
+    }
+    command->done = true;
+
+    if (if_debug(DEBUG_DMA)) {
+        printf_info("[DMA C%i] functional: %s [~%lu cycles]\n",
+            cluster->cluster_id,
+            command->get_string().toStdString().c_str(),
+            cycles);
+    }
+    return cycles;
+}
+
 uint32_t DMA::io_read(uint32_t addr) {
     printf_warning("Inside NOT IMPLEMENTED DMA:io_read \n");
 
@@ -145,6 +211,11 @@ void DMA::io_write(uint32_t addr, uint32_t value) {
 }
 
 void DMA::tick() {
+    tickLocal();
+    tickTransfer();
+}
+
+void DMA::tickLocal() {
     // check if cmd available
     // execute next iteration of cmd if not (already done and remaining_elements > 0)
     // if padding, write padding value to LM
@@ -167,7 +238,7 @@ void DMA::tick() {
         cur_iteration.ext_addr_index = command->ext_base;
         cur_iteration.total_remaining_elements = command->x_size * command->y_size;
 
-        if (debug & DEBUG_DMA) {
+        if (if_debug(DEBUG_DMA)) {
             printf_info("[DMA] new Command: %s\n", command->get_string().toStdString().c_str());
             for (auto u : command->unit) {
                 //                command->print();
@@ -192,101 +263,14 @@ void DMA::tick() {
         }
     }
 
-    // check if a transfer is ongoing
-    if (cur_iteration.remaining_req_elements > 0) {
-        // poll DCMA if req is finished
-        // if read: write data to lm
-        uint32_t dataword_counter = 0;
-        while (dataword_counter < DCMA_DATA_WIDTH / DMA_DATA_WIDTH &&
-               cur_iteration.remaining_req_elements > 0 && !command->done) {
-            if (is_read_transfer(*command)) {
-                if (dcma->isReadDataAvailable(cluster->cluster_id)) {
-                    uint8_t readdata[DMA_DATA_WIDTH / 8];
-                    dcma->readData(cluster->cluster_id, &readdata[0]);
-                    write_to_LM(cur_iteration.loc_addr, readdata);
-
-                    //debug
-                    if (debug & DEBUG_DMA_DETAIL) {
-                        for (auto u : command->unit) {
-                            printf_info(
-                                "[DMA C%iU%i] E2L (Load  %i/%i): Ext Addr = 0x%08X, LM Addr = "
-                                "0x%08X, data: %i = 0x%04X \n",
-                                cluster->cluster_id,
-                                u,
-                                command->x_size * command->y_size -
-                                    cur_iteration.total_remaining_elements + 1,
-                                command->x_size * command->y_size,
-                                cur_iteration.ext_addr + cur_iteration.ext_addr_index * 2,
-                                cur_iteration.loc_addr,
-                                *((int16_t*)readdata),
-                                *((int16_t*)readdata));
-                        }
-                    }
-
-                    cur_iteration.loc_addr++;
-                    cur_iteration.remaining_req_elements--;
-                    cur_iteration.total_remaining_elements--;
-                    cur_iteration.ext_addr_index++;
-                    if (cur_iteration.remaining_req_elements == 0 &&
-                        cur_iteration.total_remaining_elements == 0) {
-                        command->done = true;
-                        if (debug & DEBUG_DMA) {
-                            for (auto u : command->unit) {
-                                printf_info("[DMA C%iU%i] E2L Done\n", cluster->cluster_id, u);
-                            }
-                        }
-                    }
-                }
-
-            } else {
-                if (dcma->isWriteDataReady(cluster->cluster_id)) {
-                    // write a 16bit word to dcma
-                    // loc to ext dma commands have only 1 unit
-                    auto data = units[command->unit.first()]->getLocalMemoryData(
-                        cur_iteration.loc_addr, (DMA_DATA_WIDTH / 8));
-                    dcma->writeData(cluster->cluster_id, reinterpret_cast<const uint8_t*>(&data));
-
-                    //debug
-                    if (debug & DEBUG_DMA_DETAIL) {
-                        for (auto u : command->unit) {
-                            printf_info(
-                                "[DMA C%iU%i] L2E (Store  %i/%i): Ext Addr = 0x%08X, LM Addr = "
-                                "0x%08X, data: %i = 0x%04X \n",
-                                cluster->cluster_id,
-                                u,
-                                command->x_size * command->y_size -
-                                    cur_iteration.total_remaining_elements + 1,
-                                command->x_size * command->y_size,
-                                cur_iteration.ext_addr + cur_iteration.ext_addr_index * 2,
-                                cur_iteration.loc_addr,
-                                int16_t(data),
-                                int16_t(data));
-                        }
-                    }
-
-                    cur_iteration.loc_addr++;
-                    cur_iteration.remaining_req_elements--;
-                    cur_iteration.total_remaining_elements--;
-                    cur_iteration.ext_addr_index++;
-                    if (cur_iteration.remaining_req_elements == 0 &&
-                        cur_iteration.total_remaining_elements == 0) {
-                        command->done = true;
-                        if (debug & DEBUG_DMA) {
-                            for (auto u : command->unit) {
-                                printf_info("[DMA C%iU%i] L2E Done\n", cluster->cluster_id, u);
-                            }
-                        }
-                    }
-                }
-            }
-            dataword_counter++;
-        }
-    } else {  // request new block (from dcma)
+    // check if a transfer is ongoing (tickTransfer())
+    transfer_due = cur_iteration.remaining_req_elements > 0;
+    if (!transfer_due) {  // request new block (from dcma)
         if (!command->is_done()) {
             if (is_padding_region(*command, cur_iteration)) {
                 // transfer padding value to LM
                 write_to_LM(cur_iteration.loc_addr, (uint8_t*)(&architecture_state->dma_pad_value));
-                if (debug & DEBUG_DMA_DETAIL) {
+                if (if_debug(DEBUG_DMA_DETAIL)) {
                     for (auto u : command->unit) {
                         printf_info(
                             "[DMA C%iU%i] E2L (Load %i/%i): Ext Addr = ----------, LM Addr = "
@@ -325,15 +309,15 @@ void DMA::tick() {
                 }
 
                 if (DMA_gen_trace) {
-                    uint32_t cycle_stamp =
-                        cluster->core->getTime() / cluster->core->getDMAClockPeriod();
-                    trace << command->id << "," << cycle_stamp << "," << cur_iteration.ext_addr
-                          << "," << burst_length * DMA_DATA_WIDTH / 8 << ",";
-                    if (is_read_transfer(*command))
-                        trace << "r\n";
-                    else
-                        trace << "w\n";
-                    trace.flush();
+                    Trace::Writer::get().record(is_read_transfer(*command)
+                                                    ? Trace::DMA_BURST_READ
+                                                    : Trace::DMA_BURST_WRITE,
+                        cluster->cluster_id,
+                        Trace::NONE,
+                        Trace::NONE,
+                        command->id,
+                        cur_iteration.ext_addr,
+                        burst_length * DMA_DATA_WIDTH / 8);
                 }
 
                 increment_iteration(burst_length, false);
@@ -343,6 +327,99 @@ void DMA::tick() {
     }
 }
 
+void DMA::tickTransfer() {
+    if (!transfer_due) return;
+    transfer_due = false;
+
+    // poll DCMA if req is finished
+    // if read: write data to lm
+    uint32_t dataword_counter = 0;
+    while (dataword_counter < DCMA_DATA_WIDTH / DMA_DATA_WIDTH &&
+           cur_iteration.remaining_req_elements > 0 && !command->done) {
+        if (is_read_transfer(*command)) {
+            if (dcma->isReadDataAvailable(cluster->cluster_id)) {
+                uint8_t readdata[DMA_DATA_WIDTH / 8];
+                dcma->readData(cluster->cluster_id, &readdata[0]);
+                write_to_LM(cur_iteration.loc_addr, readdata);
+
+                //debug
+                if (if_debug(DEBUG_DMA_DETAIL)) {
+                    for (auto u : command->unit) {
+                        printf_info(
+                            "[DMA C%iU%i] E2L (Load  %i/%i): Ext Addr = 0x%08X, LM Addr = "
+                            "0x%08X, data: %i = 0x%04X \n",
+                            cluster->cluster_id,
+                            u,
+                            command->x_size * command->y_size -
+                                cur_iteration.total_remaining_elements + 1,
+                            command->x_size * command->y_size,
+                            cur_iteration.ext_addr + cur_iteration.ext_addr_index * 2,
+                            cur_iteration.loc_addr,
+                            *((int16_t*)readdata),
+                            *((int16_t*)readdata));
+                    }
+                }
+
+                cur_iteration.loc_addr++;
+                cur_iteration.remaining_req_elements--;
+                cur_iteration.total_remaining_elements--;
+                cur_iteration.ext_addr_index++;
+                if (cur_iteration.remaining_req_elements == 0 &&
+                    cur_iteration.total_remaining_elements == 0) {
+                    command->done = true;
+                    if (if_debug(DEBUG_DMA)) {
+                        for (auto u : command->unit) {
+                            printf_info("[DMA C%iU%i] E2L Done\n", cluster->cluster_id, u);
+                        }
+                    }
+                }
+            }
+
+        } else {
+            if (dcma->isWriteDataReady(cluster->cluster_id)) {
+                // write a 16bit word to dcma
+                // loc to ext dma commands have only 1 unit
+                auto data = units[command->unit.first()]->getLocalMemoryData(
+                    cur_iteration.loc_addr, (DMA_DATA_WIDTH / 8));
+                dcma->writeData(cluster->cluster_id, reinterpret_cast<const uint8_t*>(&data));
+
+                //debug
+                if (if_debug(DEBUG_DMA_DETAIL)) {
+                    for (auto u : command->unit) {
+                        printf_info(
+                            "[DMA C%iU%i] L2E (Store  %i/%i): Ext Addr = 0x%08X, LM Addr = "
+                            "0x%08X, data: %i = 0x%04X \n",
+                            cluster->cluster_id,
+                            u,
+                            command->x_size * command->y_size -
+                                cur_iteration.total_remaining_elements + 1,
+                            command->x_size * command->y_size,
+                            cur_iteration.ext_addr + cur_iteration.ext_addr_index * 2,
+                            cur_iteration.loc_addr,
+                            int16_t(data),
+                            int16_t(data));
+                    }
+                }
+
+                cur_iteration.loc_addr++;
+                cur_iteration.remaining_req_elements--;
+                cur_iteration.total_remaining_elements--;
+                cur_iteration.ext_addr_index++;
+                if (cur_iteration.remaining_req_elements == 0 &&
+                    cur_iteration.total_remaining_elements == 0) {
+                    command->done = true;
+                    if (if_debug(DEBUG_DMA)) {
+                        for (auto u : command->unit) {
+                            printf_info("[DMA C%iU%i] L2E Done\n", cluster->cluster_id, u);
+                        }
+                    }
+                }
+            }
+        }
+        dataword_counter++;
+    }
+}
+
 bool DMA::is_read_transfer(const CommandDMA& dma_command) const {
     return (dma_command.type == CommandDMA::EXT_1D_TO_LOC_1D ||
             dma_command.type == CommandDMA::EXT_2D_TO_LOC_1D);
@@ -385,7 +462,3 @@ void DMA::write_to_LM(const uint32_t& element_addr, const uint8_t* byte_data) {
         units[u]->writeLocalMemoryData(element_addr, byte_data, 2);
     }
 }
-
-void DMA::openTraceFile(const char* tracefilename) {
-    trace = std::ofstream(tracefilename);
-}
@@ -47,6 +47,12 @@ class DMA {
      */
     bool isBusy();
 
+    /**
+     * next event scheduling (see ISS::skipToNextEvent): UINT64_MAX if idle or a transfer polls the
+     * dcma (stalls on a line fill, see DCMA::ticksToNextEvent), else 0 (next tick changes the state)
+     */
+    uint64_t ticksToNextEvent();
+
     /**
      * push to DMA's cmd queue
      * @param cmd
@@ -54,10 +60,29 @@ class DMA {
     void execute_cmd(const std::shared_ptr<CommandDMA>& cmd);
 
     /**
-     * clock tick to process queues front command
+     * functional mode: transfers the complete command at once (main memory <-> LM, bypassing the DCMA)
+     * @param cmd
+     * @return estimated dma cycles (ideal DCMA, every access a hit)
+     */
+    uint64_t execute_cmd_functional(const std::shared_ptr<CommandDMA>& cmd);
+
+    /**
+     * clock tick to process queues front command (tickLocal() + tickTransfer())
      */
     void tick();
 
+    /**
+     * first part of tick(): start of the next command, padding and burst request to the dcma port of
+     * the cluster. Cluster local, may run in parallel to the other clusters (see ClusterWorkerPool)
+     */
+    void tickLocal();
+
+    /**
+     * second part of tick(): data words of the ongoing burst (shared dcma: bram ports, line
+     * replacement, hit / miss statistics). Called in cluster order
+     */
+    void tickTransfer();
+
     std::shared_ptr<CommandDMA> getCmd();
 
     void setExternalVariableInfo(QMap<uint64_t, QMap<int, QString>>* map) {
@@ -96,6 +121,9 @@ class DMA {
         uint32_t ext_addr_index = 0;  // ext_addr + index = burst element (for debug)
     } cur_iteration;
 
+    // tickLocal() found a burst in progress, tickTransfer() polls the dcma
+    bool transfer_due = false;
+
     // to detect new access to an external memory segment.
     // Could cause memory overflow (access to extern instead of main memory if address too large)
     uint64_t ext_addr_base_lst;
@@ -126,10 +154,7 @@ class DMA {
     std::shared_ptr<CommandDMA> noneCmd;
     std::list<std::shared_ptr<CommandDMA>> cmd_queue;
 
-    bool DMA_gen_trace{false};
-
-    std::ofstream trace;
-    std::ofstream cmd_trace;
+    static constexpr bool DMA_gen_trace = GENERATE_DMA_TRACE;
 
     int id_counter = 0;
 
@@ -150,8 +175,6 @@ class DMA {
     bool is_padding_region(const CommandDMA& dma_command, const Iteration& iteration) const;
 
     bool is_read_transfer(const CommandDMA& dma_command) const;
-
-    void openTraceFile(const char* tracefilename);
 };
 
 #endif  //VPRO_CPP_DMA_H
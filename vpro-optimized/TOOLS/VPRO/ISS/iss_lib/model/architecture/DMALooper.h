@@ -29,6 +29,11 @@ class DMALooper {
         return busy;
     };
 
+    // a command of the risc is processed at the next tick (busy is set then)
+    [[nodiscard]] bool hasInput() const {
+        return input_register.is_filled;
+    };
+
     void new_dcache_input(const uint8_t dcache_data_struct[32]);
 
     void tick();
@@ -0,0 +1,105 @@
+/**
+ * @file MainMemoryTiming.cpp
+ */
+
+#include "MainMemoryTiming.h"
+
+#include <algorithm>
+
+std::unique_ptr<MainMemoryTiming> MainMemoryTiming::create(const Config& config) {
+    if (config.model == DRAM) return std::make_unique<DramTiming>(config);
+    return std::make_unique<FixedLatencyTiming>(config);
+}
+
+// ***********************************************************************
+// fixed latency
+// ***********************************************************************
+MainMemoryTiming::Access FixedLatencyTiming::schedule(
+    uint64_t now, uint64_t addr, uint64_t bytes, bool is_write) {
+    Access a{};
+    a.done = now + (is_write ? config.write_latency : config.read_latency);
+    if (config.bytes_per_cycle > 0) {
+        uint64_t& channel_free = is_write ? write_channel_free : read_channel_free;
+        a.transfer_cycles = transferCycles(bytes, config.bytes_per_cycle);
+        a.done = std::max(a.done, channel_free) + a.transfer_cycles;
+        channel_free = a.done;
+    }
+    return a;
+}
+
+std::string FixedLatencyTiming::description() const {
+    std::string s = "fixed, read / write latency " + std::to_string(config.read_latency) + " / " +
+                    std::to_string(config.write_latency) + " AXI cycles, ";
+    if (config.bytes_per_cycle > 0)
+        s += std::to_string(config.bytes_per_cycle) + " bytes per AXI cycle and channel";
+    else
+        s += "unlimited bandwidth";
+    return s;
+}
+
+// ***********************************************************************
+// dram
+// ***********************************************************************
+DramTiming::DramTiming(const Config& config)
+    : MainMemoryTiming(config),
+      banks(std::max(config.banks, 1u)) {
+    if (this->config.row_size == 0) this->config.row_size = 1;
+}
+
+MainMemoryTiming::Access DramTiming::schedule(
+    uint64_t now, uint64_t addr, uint64_t bytes, bool is_write) {
+    Access a{};
+    uint64_t start = now;
+
+    // wait for a free outstanding slot (oldest burst in flight completes)
+    while (!outstanding.empty() && outstanding.top() <= now) outstanding.pop();
+    if (config.max_outstanding > 0 && outstanding.size() >= config.max_outstanding) {
+        start = outstanding.top();
+        outstanding.pop();
+        a.outstanding_stall = start - now;
+    }
+
+    // consecutive rows are interleaved over the banks
+    uint64_t row_index = addr / config.row_size;
+    Bank& bank = banks[row_index % banks.size()];
+    uint64_t row = row_index / banks.size();
+
+    start = std::max(start, bank.ready);
+    a.row_hit = bank.open_row == row;
+    a.row_miss = !a.row_hit;
+    bank.open_row = row;
+    uint64_t data = start + (a.row_hit ? config.row_hit_latency : config.row_miss_latency);
+
+    // shared data bus
+    uint64_t bus = bus_free;
+    if (bus_write != is_write && bus_free > 0) {
+        bus += config.turnaround;
+        a.turnaround = true;
+    }
+    bus_write = is_write;
+    data = std::max(data, bus);
+    a.transfer_cycles = transferCycles(bytes, config.bytes_per_cycle);
+    a.done = data + a.transfer_cycles;
+    bus_free = a.done;
+    // accesses to the open row are pipelined: next column command after this burst's transfer
+    uint64_t activate = a.row_hit ? 0 : std::max(config.row_miss_latency, config.row_hit_latency) -
+                                            config.row_hit_latency;
+    bank.ready = start + activate + std::max<uint64_t>(a.transfer_cycles, 1);
+
+    outstanding.push(a.done);
+    return a;
+}
+
+std::string DramTiming::description() const {
+    return "dram, " + std::to_string(banks.size()) + " banks x " +
+           std::to_string(config.row_size) + " byte rows, row hit / miss latency " +
+           std::to_string(config.row_hit_latency) + " / " +
+           std::to_string(config.row_miss_latency) + ", turnaround " +
+           std::to_string(config.turnaround) + ", " +
+           (config.bytes_per_cycle > 0 ? std::to_string(config.bytes_per_cycle)
+                                       : std::string("unlimited")) +
+           " bytes per AXI cycle, max. " +
+           (config.max_outstanding > 0 ? std::to_string(config.max_outstanding)
+                                       : std::string("unlimited")) +
+           " outstanding bursts";
+}
@@ -0,0 +1,109 @@
+/**
+ * @file MainMemoryTiming.h
+ *
+ * Timing models of the NonBlockingMainMemory. A model gets each burst at its request and returns
+ * the AXI cycle of its completion (read data available / write done). Selected at startup
+ * (--mm-model=fixed|dram, see ISS::setHardwareParameter):
+ *  - fixed: constant read / write latency, optional bandwidth per channel (default, as before)
+ *  - dram: banks with open row buffers (row hit / miss latency), one shared data bus with
+ *          bandwidth and read/write turnaround, limited number of outstanding bursts
+ */
+
+#ifndef VPRO_CPP_MAINMEMORYTIMING_H
+#define VPRO_CPP_MAINMEMORYTIMING_H
+
+#include <stdint.h>
+#include <memory>
+#include <queue>
+#include <string>
+#include <vector>
+
+class MainMemoryTiming {
+   public:
+    enum Model : uint32_t { FIXED = 0, DRAM = 1 };
+
+    /**
+     * all values in AXI cycles / bytes
+     */
+    struct Config {
+        uint32_t model = FIXED;
+        // fixed
+        uint32_t read_latency = 36;
+        uint32_t write_latency = 6;
+        uint32_t bytes_per_cycle = 0;  // fixed: per channel, 0: unlimited. dram: data bus
+        // dram
+        uint32_t banks = 8;
+        uint32_t row_size = 2048;        // bytes per row and bank (consecutive rows: next bank)
+        uint32_t row_hit_latency = 20;   // CAS
+        uint32_t row_miss_latency = 40;  // precharge + activate + CAS
+        uint32_t turnaround = 4;         // data bus direction change
+        uint32_t max_outstanding = 16;   // bursts in flight (0: unlimited)
+    };
+
+    /**
+     * timing of one burst (for the statistics)
+     */
+    struct Access {
+        uint64_t done;               // completion cycle
+        uint64_t transfer_cycles;    // data bus / channel occupied
+        uint64_t outstanding_stall;  // cycles waiting for a free outstanding slot
+        bool row_hit, row_miss, turnaround;
+    };
+
+    static std::unique_ptr<MainMemoryTiming> create(const Config& config);
+
+    virtual ~MainMemoryTiming() = default;
+
+    /**
+     * @param now current AXI cycle (request)
+     * @param addr byte address of the burst
+     * @param bytes size of the burst
+     */
+    virtual Access schedule(uint64_t now, uint64_t addr, uint64_t bytes, bool is_write) = 0;
+
+    virtual std::string description() const = 0;
+
+   protected:
+    explicit MainMemoryTiming(const Config& config) : config(config) {}
+
+    static uint64_t transferCycles(uint64_t bytes, uint32_t bytes_per_cycle) {
+        return bytes_per_cycle == 0 ? 0 : (bytes + bytes_per_cycle - 1) / bytes_per_cycle;
+    }
+
+    Config config;
+};
+
+class FixedLatencyTiming : public MainMemoryTiming {
+   public:
+    explicit FixedLatencyTiming(const Config& config) : MainMemoryTiming(config) {}
+
+    Access schedule(uint64_t now, uint64_t addr, uint64_t bytes, bool is_write) override;
+    std::string description() const override;
+
+   private:
+    // first free cycle of the read / write data channel (bytes_per_cycle)
+    uint64_t read_channel_free = 0, write_channel_free = 0;
+};
+
+class DramTiming : public MainMemoryTiming {
+   public:
+    explicit DramTiming(const Config& config);
+
+    Access schedule(uint64_t now, uint64_t addr, uint64_t bytes, bool is_write) override;
+    std::string description() const override;
+
+   private:
+    struct Bank {
+        uint64_t open_row = ~uint64_t(0);
+        uint64_t ready = 0;  // next column command
+    };
+    std::vector<Bank> banks;
+
+    uint64_t bus_free = 0;
+    bool bus_write = false;  // direction of the last transfer
+
+    // completion cycles of the bursts in flight (max_outstanding)
+    std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<>> outstanding;
+};
+
+#endif  //VPRO_CPP_MAINMEMORYTIMING_H
@@ -5,6 +5,7 @@
 #ifndef TEMPLATE_NONBLOCKINGBUSSLAVEINTERFACE_H
 #define TEMPLATE_NONBLOCKINGBUSSLAVEINTERFACE_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <bitset>
 #include <iostream>
@@ -32,6 +33,19 @@ class NonBlockingBusSlaveInterface {
     virtual void dbgWrite(intptr_t dst_addr, uint8_t* data_ptr) = 0;
 
     virtual void dbgRead(intptr_t dst_addr, uint8_t* data_ptr) = 0;
+
+    // debug access of a continuous block (default: byte wise dbgWrite / dbgRead)
+    virtual void dbgWriteBlock(intptr_t dst_addr, const uint8_t* data_ptr, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            dbgWrite(dst_addr + intptr_t(i), const_cast<uint8_t*>(data_ptr + i));
+        }
+    }
+
+    virtual void dbgReadBlock(intptr_t src_addr, uint8_t* data_ptr, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            dbgRead(src_addr + intptr_t(i), data_ptr + i);
+        }
+    }
 };
 
 #endif  //TEMPLATE_NONBLOCKINGBUSSLAVEINTERFACE_H
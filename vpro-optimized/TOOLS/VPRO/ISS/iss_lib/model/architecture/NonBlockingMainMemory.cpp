@@ -5,9 +5,18 @@
 #include "NonBlockingMainMemory.h"
 #include <errno.h>
 #include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "../../simulator/helper/checkpoint.h"
 #include "../../simulator/helper/debugHelper.h"
+#include "../../simulator/helper/trace.h"
+#include "stats/Statistics.h"
 
-NonBlockingMainMemory::NonBlockingMainMemory(uint64_t memory_byte_size) {
+NonBlockingMainMemory::NonBlockingMainMemory(uint64_t memory_byte_size, uint32_t initiators)
+    : readSlots(initiators),
+      writeSlots(initiators) {
     printf("# [NonBlockingMainMemory] Allocating memory... (Size: %lu Bytes)\n", memory_byte_size);
     this->memory = (uint8_t*)(mmap(
         NULL, memory_byte_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0));
@@ -17,40 +26,132 @@ NonBlockingMainMemory::NonBlockingMainMemory(uint64_t memory_byte_size) {
         perror("NonBlockingMainMemory");
     }
     this->memory_byte_size = memory_byte_size;
+    setTiming(MainMemoryTiming::Config());
+}
 
-    if (gen_mem_trace) {
-        std::stringstream ss;
-        ss << "main_mem.trace";
-        mem_trace = std::ofstream(ss.str().c_str());
+void NonBlockingMainMemory::setTiming(const MainMemoryTiming::Config& config) {
+    if (!isIdle()) {
+        printf_error("[NonBlockingMainMemory] Timing changed with pending requests!\n");
     }
+    timing = MainMemoryTiming::create(config);
+
+    // one turn covers the latencies: without queueing, each request is visited once
+    uint64_t size = 64;
+    while (size <= std::max({config.read_latency,
+                       config.write_latency,
+                       config.row_miss_latency + config.turnaround}))
+        size *= 2;
+    wheel.assign(size, {});
+    wheel_entries = 0;
+    wheel_mask = size - 1;
+}
+
+NonBlockingMainMemory::Request& NonBlockingMainMemory::slot(
+    std::vector<Request>& requests, uint32_t initiator_id) {
+    if (initiator_id >= requests.size()) requests.resize(initiator_id + 1);
+    return requests[initiator_id];
+}
+
+void NonBlockingMainMemory::schedule(Request& request, uint32_t initiator_id, bool is_write) {
+    // completes during the tick of this cycle (latency ticks after the request)
+    uint64_t bytes = uint64_t(dataword_length_byte) * request.burst_length;
+    auto access = timing->schedule(tick_counter, uint64_t(request.byte_addr), bytes, is_write);
+    uint64_t cycle = access.done;
+
+    if (!axi_stat) axi_stat = Statistics::get().getAXIStat();  // once the statistics are set up
+    if (axi_stat) {
+        auto& counters = axi_stat->counters;
+        (is_write ? counters.write_bursts : counters.read_bursts)++;
+        (is_write ? counters.write_bytes : counters.read_bytes) += bytes;
+        (is_write ? counters.write_latency_cycles : counters.read_latency_cycles) +=
+            cycle - tick_counter;
+        counters.transfer_cycles += access.transfer_cycles;
+        counters.outstanding_stall_cycles += access.outstanding_stall;
+        counters.row_hits += access.row_hit;
+        counters.row_misses += access.row_miss;
+        counters.turnarounds += access.turnaround;
+    }
+
+    if (!request.is_done) pending--;  // replaced, its completion is ignored
+    request.seq = next_seq++;
+    request.is_done = false;
+    request.done_cycle = cycle;
+    wheel[cycle & wheel_mask].push_back({cycle, initiator_id, request.seq, is_write});
+    wheel_entries++;
+    pending++;
 }
 
 void NonBlockingMainMemory::tick() {
-    for (auto& kr : incomingReadTransfers) {
-        if (kr.second.cycle_counter == cycles_read_latency) kr.second.is_done = true;
-        kr.second.cycle_counter++;
+    auto& bucket = wheel[tick_counter & wheel_mask];
+    if (!bucket.empty()) {
+        size_t kept = 0;
+        for (auto& c : bucket) {
+            if (c.cycle != tick_counter) {
+                bucket[kept++] = c;  // next turn of the wheel
+                continue;
+            }
+            auto& request = c.is_write ? writeSlots[c.initiator_id] : readSlots[c.initiator_id];
+            if (request.seq == c.seq && !request.is_done) {  // else replaced by a newer request
+                request.is_done = true;
+                pending--;
+            }
+        }
+        wheel_entries -= bucket.size() - kept;
+        bucket.resize(kept);
     }
+    tick_counter++;
+}
+
+bool NonBlockingMainMemory::isIdle() const {
+    return pending == 0;
+}
 
-    for (auto& kr : incomingWriteTransfers) {
-        if (kr.second.cycle_counter == cycles_write_latency) kr.second.is_done = true;
-        kr.second.cycle_counter++;
+uint64_t NonBlockingMainMemory::ticksToNextEvent() const {
+    if (pending == 0) return UINT64_MAX;
+    uint64_t next = UINT64_MAX;
+    for (auto* requests : {&readSlots, &writeSlots}) {
+        for (auto& request : *requests) {
+            if (!request.is_done) next = std::min(next, request.done_cycle);
+        }
     }
+    return next - tick_counter;
+}
 
-    tick_counter++;
+void NonBlockingMainMemory::skipTicks(uint64_t ticks) {
+    // no request completes in the skipped cycles: their entries belong to replaced requests (never
+    // matched again), drop them instead of keeping them in the buckets forever
+    if (wheel_entries > pending) {
+        uint64_t end = tick_counter + ticks;
+        for (auto& bucket : wheel) {
+            size_t kept = 0;
+            for (auto& c : bucket) {
+                if (c.cycle >= end) bucket[kept++] = c;
+            }
+            wheel_entries -= bucket.size() - kept;
+            bucket.resize(kept);
+        }
+    }
+    tick_counter += ticks;
+}
+
+bool NonBlockingMainMemory::isRequestDone(uint32_t initiator_id, bool is_write) const {
+    auto& requests = is_write ? writeSlots : readSlots;
+    return initiator_id >= requests.size() || requests[initiator_id].is_done;
 }
 
 bool NonBlockingMainMemory::isReadDataAvailable(uint32_t initiator_id) {
-    return incomingReadTransfers[initiator_id].is_done;
+    return initiator_id >= readSlots.size() || readSlots[initiator_id].is_done;
 }
 
 bool NonBlockingMainMemory::isWriteDataReady(uint32_t initiator_id) {
-    bool result = incomingWriteTransfers[initiator_id].is_done;
-    if (result) incomingWriteTransfers.erase(initiator_id);
+    if (initiator_id >= writeSlots.size()) return true;
+    bool result = writeSlots[initiator_id].is_done;
+    if (result) writeSlots[initiator_id] = Request();
     return result;
 }
 
 bool NonBlockingMainMemory::readData(uint8_t* data_ptr, const uint32_t initiator_id) {
-    auto& cur_req = incomingReadTransfers[initiator_id];
+    auto& cur_req = slot(readSlots, initiator_id);
 
     if (!cur_req.is_done) {
         printf_error("ERROR: VPRO Main Memory Not Ready for Read Data\n");
@@ -58,14 +159,14 @@ bool NonBlockingMainMemory::readData(uint8_t* data_ptr, const uint32_t initiator
     }
 
     if (cur_req.byte_addr < memory_byte_size) {
-        if (debug & DEBUG_EXT_MEM)
+        if (if_debug(DEBUG_EXT_MEM))
             printf_info(
                 "[MM] read from ext to loc (addr = 0x%08X) burst_length in 512bit-words: %i\n",
                 cur_req.byte_addr,
                 cur_req.burst_length);
         for (int i = 0; i < dataword_length_byte * cur_req.burst_length; ++i) {
             data_ptr[i] = memory[cur_req.byte_addr + i];
-            if (debug & DEBUG_EXT_MEM && i % 2 == 0)
+            if (if_debug(DEBUG_EXT_MEM) && i % 2 == 0)
                 printf_info("\tread data at ext addr (0x%08X): %i = 0x%04X \n",
                     cur_req.byte_addr + i,
                     ((int16_t*)data_ptr)[i / 2],
@@ -76,21 +177,26 @@ bool NonBlockingMainMemory::readData(uint8_t* data_ptr, const uint32_t initiator
             memcpy(&data_ptr[i], (uint8_t*)(cur_req.byte_addr + i), 1);
     }
 
-    incomingReadTransfers.erase(initiator_id);
+    cur_req = Request();
     return true;
 }
 
 bool NonBlockingMainMemory::requestReadTransfer(
     intptr_t dst_addr_ptr, const uint32_t burst_length, const uint32_t initiator_id) {
-    Request cur_request;
+    auto& cur_request = slot(readSlots, initiator_id);
     cur_request.byte_addr = dst_addr_ptr;
     cur_request.burst_length = burst_length;
-    cur_request.is_done = false;
-    incomingReadTransfers[initiator_id] = cur_request;
+    cur_request.data_ptr = nullptr;
+    schedule(cur_request, initiator_id, false);
 
     if (gen_mem_trace) {
-        mem_trace << tick_counter << "," << dst_addr_ptr << "," << burst_length << ",r\n";
-        mem_trace.flush();
+        Trace::Writer::get().record(Trace::MM_READ,
+            Trace::NONE,
+            Trace::NONE,
+            Trace::NONE,
+            initiator_id,
+            dst_addr_ptr,
+            burst_length);
     }
 
     return true;
@@ -100,22 +206,21 @@ bool NonBlockingMainMemory::requestWriteTransfer(intptr_t dst_addr_ptr,
     const uint8_t* data_ptr,
     const uint32_t burst_length,
     const uint32_t initiator_id) {
-    Request cur_request;
+    auto& cur_request = slot(writeSlots, initiator_id);
     cur_request.byte_addr = dst_addr_ptr;
     cur_request.data_ptr = const_cast<uint8_t*>(data_ptr);
     cur_request.burst_length = burst_length;
-    cur_request.is_done = false;
-    incomingWriteTransfers[initiator_id] = cur_request;
+    schedule(cur_request, initiator_id, true);
 
     if (dst_addr_ptr < memory_byte_size) {
-        if (debug & DEBUG_EXT_MEM)
+        if (if_debug(DEBUG_EXT_MEM))
             printf_info(
                 "[MM] write from loc to ext (addr = 0x%08X) burst_length in 512bit-words: %i\n",
                 cur_request.byte_addr,
                 cur_request.burst_length);
         for (int i = 0; i < dataword_length_byte * cur_request.burst_length; ++i) {
             memory[cur_request.byte_addr + i] = data_ptr[i];
-            if (debug & DEBUG_EXT_MEM && i % 2 == 0)
+            if (if_debug(DEBUG_EXT_MEM) && i % 2 == 0)
                 printf_info("\t write data at ext addr (0x%08X): %i = 0x%04X \n",
                     cur_request.byte_addr + i,
                     *((int16_t*)&data_ptr[i]),
@@ -127,8 +232,13 @@ bool NonBlockingMainMemory::requestWriteTransfer(intptr_t dst_addr_ptr,
     }
 
     if (gen_mem_trace) {
-        mem_trace << tick_counter << "," << dst_addr_ptr << "," << burst_length << ",w\n";
-        mem_trace.flush();
+        Trace::Writer::get().record(Trace::MM_WRITE,
+            Trace::NONE,
+            Trace::NONE,
+            Trace::NONE,
+            initiator_id,
+            dst_addr_ptr,
+            burst_length);
     }
 
     return true;
@@ -142,6 +252,93 @@ void NonBlockingMainMemory::dbgRead(intptr_t dst_addr, uint8_t* data_ptr) {
     data_ptr[0] = memory[dst_addr];
 }
 
+void NonBlockingMainMemory::dbgWriteBlock(intptr_t dst_addr, const uint8_t* data_ptr, size_t size) {
+    size = clipBlock(dst_addr, size, "Write");
+    if (size > 0) memcpy(memory + dst_addr, data_ptr, size);
+}
+
+void NonBlockingMainMemory::dbgReadBlock(intptr_t src_addr, uint8_t* data_ptr, size_t size) {
+    size_t valid = clipBlock(src_addr, size, "Read");
+    if (valid > 0) memcpy(data_ptr, memory + src_addr, valid);
+    memset(data_ptr + valid, 0, size - valid);  // beyond the end: zeros
+}
+
+size_t NonBlockingMainMemory::clipBlock(intptr_t addr, size_t size, const char* access) const {
+    if (uint64_t(addr) + size <= memory_byte_size) return size;
+    size_t valid = (uint64_t(addr) < memory_byte_size) ? size_t(memory_byte_size - uint64_t(addr)) : 0;
+    printf_warning(
+        "[NonBlockingMainMemory] %s beyond the end of memory clipped! (Address: 0x%lx, Size: %lu, "
+        "%lu byte outside)\n",
+        access,
+        addr,
+        size,
+        size - valid);
+    return valid;
+}
+
 uint64_t NonBlockingMainMemory::getMemByteSize() const {
     return memory_byte_size;
 }
+
+void NonBlockingMainMemory::saveState(Checkpoint::Writer& w) {
+    constexpr uint64_t page = Checkpoint::PAGE_ALIGN;
+    const uint64_t pages = (memory_byte_size + page - 1) / page;
+
+    // resident host pages (never accessed pages are zero)
+    const uint64_t host_page = std::max(uint64_t(sysconf(_SC_PAGESIZE)), page);
+    std::vector<unsigned char> resident((memory_byte_size + host_page - 1) / host_page, 1);
+    if (mincore(memory, memory_byte_size, resident.data()) != 0) {
+        std::fill(resident.begin(), resident.end(), 1);
+    }
+
+    static const uint8_t zeros[page]{};
+    std::vector<uint64_t> used;
+    for (uint64_t p = 0; p < pages; ++p) {
+        if (!(resident[p * page / host_page] & 1)) continue;
+        auto size = std::min(page, memory_byte_size - p * page);
+        if (memcmp(memory + p * page, zeros, size) != 0) used.push_back(p);
+    }
+
+    w.value(memory_byte_size);
+    w.value(uint64_t(used.size()));
+    w.data(used.data(), used.size() * sizeof(uint64_t));
+    w.section("MMPAGES", Checkpoint::PAGE_ALIGN);
+    for (auto p : used) {
+        auto size = std::min(page, memory_byte_size - p * page);
+        w.data(memory + p * page, size);
+        if (size < page) w.data(zeros, page - size);
+    }
+}
+
+void NonBlockingMainMemory::restoreState(Checkpoint::Reader& r) {
+    constexpr uint64_t page = Checkpoint::PAGE_ALIGN;
+    uint64_t size = 0, count = 0;
+    r.value(size);
+    r.value(count);
+    if (size != memory_byte_size) {
+        r.fail("main memory size differs");
+        return;
+    }
+    if (count > (memory_byte_size + page - 1) / page) {  // before the allocation below
+        r.fail("main memory page count out of range");
+        return;
+    }
+    std::vector<uint64_t> used(count);
+    r.data(used.data(), count * sizeof(uint64_t));
+    if (!r.section("MMPAGES", Checkpoint::PAGE_ALIGN)) return;
+
+    // release the current content (shared anonymous mapping reads as zero afterwards)
+    if (madvise(memory, memory_byte_size, MADV_REMOVE) != 0) {
+        memset(memory, 0, memory_byte_size);
+    }
+    static uint8_t padding[page];
+    for (auto p : used) {
+        if (p * page >= memory_byte_size) {
+            r.fail("main memory page out of range");
+            return;
+        }
+        auto bytes = std::min(page, memory_byte_size - p * page);
+        r.data(memory + p * page, bytes);
+        if (bytes < page) r.data(padding, page - bytes);
+    }
+}
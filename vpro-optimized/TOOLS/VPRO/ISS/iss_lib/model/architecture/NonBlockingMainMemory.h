@@ -6,14 +6,35 @@
 #define TEMPLATE_NONBLOCKINGMAINMEMORY_H
 
 #include <stdio.h>
-#include <fstream>
-#include <map>
-#include <sstream>
+#include <memory>
+#include <vector>
+#include "../../simulator/setting.h"
+#include "MainMemoryTiming.h"
 #include "NonBlockingBusSlaveInterface.h"
 
+class StatisticAxi;
+
+namespace Checkpoint {
+class Writer;
+class Reader;
+}  // namespace Checkpoint
+
 class NonBlockingMainMemory : public NonBlockingBusSlaveInterface {
    public:
-    explicit NonBlockingMainMemory(uint64_t memory_byte_size);
+    /**
+     * @param initiators number of initiator ids (slots are added if a higher id requests)
+     */
+    explicit NonBlockingMainMemory(uint64_t memory_byte_size, uint32_t initiators = 1);
+
+    /**
+     * timing model of the bursts (see MainMemoryTiming), default: fixed read / write latency.
+     * only valid if isIdle()
+     */
+    void setTiming(const MainMemoryTiming::Config& config);
+
+    [[nodiscard]] std::string timingDescription() const {
+        return timing->description();
+    }
 
     uint8_t* getMemory() {
         return memory;
@@ -21,6 +42,28 @@ class NonBlockingMainMemory : public NonBlockingBusSlaveInterface {
 
     void tick();
 
+    /**
+     * no read/write request waiting for its latency
+     */
+    bool isIdle() const;
+
+    /**
+     * next event scheduling (see ISS::skipToNextEvent): number of ticks before the tick completing
+     * the earliest pending request, UINT64_MAX if idle
+     */
+    [[nodiscard]] uint64_t ticksToNextEvent() const;
+
+    /**
+     * replaces tick() for the given number of clock cycles (only valid if < ticksToNextEvent())
+     */
+    void skipTicks(uint64_t ticks);
+
+    /**
+     * the request of the initiator is completed, the data can be read / the write is done
+     * (isReadDataAvailable / isWriteDataReady without consuming the write response)
+     */
+    [[nodiscard]] bool isRequestDone(uint32_t initiator_id, bool is_write) const;
+
     bool requestReadTransfer(
         intptr_t dst_addr_ptr, uint32_t burst_length, uint32_t initiator_id) override;
 
@@ -39,29 +82,65 @@ class NonBlockingMainMemory : public NonBlockingBusSlaveInterface {
 
     void dbgRead(intptr_t dst_addr, uint8_t* data_ptr) override;
 
+    // memcpy from / to the memory, blocks running past its end are clipped (warning, reads return zeros)
+    void dbgWriteBlock(intptr_t dst_addr, const uint8_t* data_ptr, size_t size) override;
+
+    void dbgReadBlock(intptr_t src_addr, uint8_t* data_ptr, size_t size) override;
+
     [[nodiscard]] uint64_t getMemByteSize() const;
 
+    /**
+     * memory content (only valid if idle). Only non-zero pages are stored (page aligned in the file),
+     * never touched pages are skipped without mapping them
+     */
+    void saveState(Checkpoint::Writer& w);
+    void restoreState(Checkpoint::Reader& r);
+
    private:
+    // taken on the first burst after Statistics::initialize (called after the components are created)
+    StatisticAxi* axi_stat = nullptr;
+
     uint8_t* memory;
     uint64_t memory_byte_size;
-    uint32_t cycles_read_latency = 36;
-    uint32_t cycles_write_latency = 6;
+    std::unique_ptr<MainMemoryTiming> timing;
 
     struct Request {
         uint32_t burst_length{};
         intptr_t byte_addr{};
         uint8_t* data_ptr{};
-        uint32_t cycle_counter = 0;
+        uint32_t seq{};  // of the request in the timing wheel (a new request replaces the previous)
+        uint64_t done_cycle{};  // tick completing the request
         bool is_done = true;
     };
 
-    std::map<uint32_t, Request> incomingReadTransfers, incomingWriteTransfers;
+    // one read + one write request per initiator id
+    std::vector<Request> readSlots, writeSlots;
+
+    /**
+     * timing wheel: requests in the bucket of their completion cycle (modulo its size). Each tick
+     * processes the current bucket only, requests with a later completion cycle (one or more
+     * wheel turns, e.g. queued behind other bursts) stay in it
+     */
+    struct Completion {
+        uint64_t cycle;
+        uint32_t initiator_id;
+        uint32_t seq;
+        bool is_write;
+    };
+    std::vector<std::vector<Completion>> wheel;
+    uint64_t wheel_mask{};
+    uint32_t pending = 0;  // requests in the wheel
+    uint64_t wheel_entries = 0;  // incl. the stale entries of replaced requests
+    uint32_t next_seq = 0;
 
-    bool gen_mem_trace{false};
+    Request& slot(std::vector<Request>& requests, uint32_t initiator_id);
+    // number of bytes of the block inside the memory, warns if it is clipped
+    size_t clipBlock(intptr_t addr, size_t size, const char* access) const;
+    void schedule(Request& request, uint32_t initiator_id, bool is_write);
 
-    std::ofstream mem_trace;
+    static constexpr bool gen_mem_trace = GENERATE_MM_TRACE;
 
-    uint32_t tick_counter = 0;
+    uint64_t tick_counter = 0;
 };
 
 #endif  //TEMPLATE_NONBLOCKINGMAINMEMORY_H
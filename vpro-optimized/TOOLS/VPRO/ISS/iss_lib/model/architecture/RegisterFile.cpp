@@ -1,65 +1,43 @@
 #include "RegisterFile.h"
 
-#include <sstream>
 #include <string>
+#include "../../simulator/helper/checkpoint.h"
 #include "../../simulator/helper/debugHelper.h"
+#include "../../simulator/helper/trace.h"
 #include "../../simulator/helper/typeConversion.h"
 #include "Cluster.h"
 
 namespace RegisterFile {
 
-void Register::initArrays() {
+void Register::initArrays(uint32_t* storage) {
     if (!is_disabled("initArrays", false)) {
-        auto alloc_size = size_t(4 * ceil(double(register_file_size * 3) / 4));   // make size dividable by 4
-        rf_data = new uint8_t[alloc_size]();
-        rf_flag[0] = new bool[register_file_size]();
-        rf_flag[1] = new bool[register_file_size]();
-        is_uninitialized = new bool[register_file_size]();
+        owns_storage = (storage == nullptr);
+        rf = owns_storage ? new uint32_t[register_file_size] : storage;
         for (int i = 0; i < register_file_size; ++i) {
-            is_uninitialized[i] = true;
+            rf[i] = UNINITIALIZED;  // each register in the begin is not initialized!
         }
     }
-    if (!isLS && rf_generate_trace) {
-        std::stringstream ss;
-        ss << "c" << cluster_id << "u" << vector_unit_id << "l" << vector_lane_id << "rf.trace";
-        openTraceFile(ss.str().c_str());
-    }
 }
 
-bool Register::is_disabled(std::string func, bool print_msg) const {
+bool Register::is_disabled(const char* func, bool print_msg) const {
     if (register_file_size <= 0 || isLS) {
         if (print_msg)
-            printf_error(
-                ">>> RF was disabled (lane: %i) executed by; %s\n", vector_lane_id, func.c_str());
+            printf_error(">>> RF was disabled (lane: %i) executed by; %s\n", vector_lane_id, func);
         return true;
     }
     return false;
 }
 
 /**
-     * on accessing data from the register file. checks adress
+     * checks of a data access to the register file (debug builds)
      * @param addr rf-address
      * @param size [optional] = 3 for 24-bit
-     * @return uint8_t[3] data
+     * @return whether the access is valid
      */
-uint32_t Register::get_rf_data(int addr, int size) const {
-    // check if this accesses a valid register file
-    if (is_disabled("get_rf_data")) {
-        return 0;
-    }
-    if (addr * 3 + size > 3 * register_file_size) {
-        printf_error(
-            "[Get] Access Register File out of range! (lane: %i, addr: %d, access size: %d)\n",
-            vector_lane_id,
-            addr,
-            size);
-        return 0;
-    }
-    if (size != 3) {
-        printf_error("RF Read for size != 3 [NOT IMPLEMENTED!]\n");
-    }
+bool Register::check_read(int addr, const char* func, int size) const {
+    if (!check_write(addr, func, size)) return false;
 
-    if (CHECK_RF_UNINITIALIZED_ACCESS && is_uninitialized[addr]) {
+    if (CHECK_RF_UNINITIALIZED_ACCESS && (rf[addr] & UNINITIALIZED)) {
         printf_error("[RF] Uninitialized Access! (RF Addr: %i, Cluster: %i, Unit: %i, Lane: %i)\n",
             addr,
             cluster_id,
@@ -67,133 +45,75 @@ uint32_t Register::get_rf_data(int addr, int size) const {
             vector_lane_id);
         assert(!EXIT_ON_RF_UNINITIALIZED_ACCESS);
     }
-
-    auto a = (*((uint32_t*)&rf_data[addr * 3])) & 0x00ffffffu;
-
-    return a;
-}
-
-Register::Register(
-    int cluster_id, int vector_unit_id, int vector_lane_id, int register_file_size, bool isLS)
-    : cluster_id(cluster_id),
-      vector_unit_id(vector_unit_id),
-      register_file_size(register_file_size),
-      vector_lane_id(vector_lane_id),
-      isLS(isLS),
-      rf0_inst(0),
-      rf1_inst(1) {
-    if (!isLS) initArrays();
-}
-
-Register::~Register() {
-    if (!is_disabled("Destructor", false)) {
-        delete rf_data;
-        delete rf_flag[0];
-        delete rf_flag[1];
-    }
-    if (!isLS && rf_generate_trace) {
-        trace.flush();
-        trace.close();
-    }
+    return true;
 }
 
-/**
-     * on setting data from the register file. checks adress
-     * @param addr rf-address
-     * @param data uint8_t[3] data
-     * @param size [optional] = 3 for 24-bit
-     */
-void Register::set_rf_data(int addr, uint32_t data, int size) {
+bool Register::check_write(int addr, const char* func, int size) const {
     // check if this accesses a valid register file
-    if (is_disabled("set_rf_data")) {
-        return;
+    if (is_disabled(func)) {
+        return false;
     }
-    if (addr * 3 + size > 3 * register_file_size) {
-        printf_error(
-            "[Set] Access Register File out of range! (lane: %i, addr: %d, access size: %d)\n",
+    if (addr < 0 || addr >= register_file_size) {
+        printf_error("[%s] Access Register File out of range! (lane: %i, addr: %d, access size: %d)\n",
+            func,
             vector_lane_id,
             addr,
             size);
-        return;
-    }
-
-    if (rf_generate_trace) {
-        trace << "RF[" << std::dec << addr << "] ";
-        if (is_uninitialized[addr]) {
-            trace << "uuuuuu";
-        } else {
-            is_uninitialized[addr] = false;
-            trace << std::uppercase << std::setfill('0') << std::setw(6) << std::hex
-                  << (get_rf_data(addr, size) & 0xffffff);
-        }
-        trace << " > ";
-        trace << std::uppercase << std::setfill('0') << std::setw(6) << std::hex
-              << (data & 0xffffff);
-        trace << "\n";
+        return false;
     }
-
-    is_uninitialized[addr] = false;
-
-    for (int i = 0; i < size; i++) {
-        rf_data[addr * 3 + i] = uint8_t(data >> (i * 8));
+    if (size != 3) {
+        printf_error("RF Access for size != 3 [NOT IMPLEMENTED!]\n");
     }
+    return true;
 }
 
-bool Register::get_rf_flag(int addr, int select) const {
-    if (is_disabled("get_rf_flag")) {
+bool Register::check_flag(int addr, int select, const char* func) const {
+    if (is_disabled(func)) {
         return false;
     }
-    if (addr > register_file_size) {
-        printf_error("RF Flag Address access out of range; (addr: %i > %i)[Select; %i]",
+    if (addr < 0 || addr >= register_file_size || select < 0 || select > 1) {
+        printf_error("RF Flag access out of range; (addr: %i, size: %i)[Select; %i]\n",
             addr,
             register_file_size,
             select);
         return false;
     }
-    if (select > 1) {
-        printf_error("RF Flag Select access out of range; (addr: %i > %i)[Select; %i]",
-            addr,
-            register_file_size,
-            select);
-        return false;
-    }
-    return rf_flag[select][addr];
+    return true;
 }
 
-void Register::set_rf_flag(int addr, int select, bool value) {
-    if (is_disabled("set_rf_flag")) {
-        return;
-    }
-    if (addr > register_file_size) {
-        printf_error("RF Flag Address access out of range; (addr: %i > %i)[Select; %i]",
-            addr,
-            register_file_size,
-            select);
-        return;
-    }
-    if (select > 1) {
-        printf_error("RF Flag Select access out of range; (addr: %i > %i)[Select; %i]",
-            addr,
-            register_file_size,
-            select);
-        return;
-    }
-    rf_flag[select][addr] = value;
+Register::Register(int cluster_id,
+    int vector_unit_id,
+    int vector_lane_id,
+    int register_file_size,
+    bool isLS,
+    uint32_t* storage)
+    : cluster_id(cluster_id),
+      vector_unit_id(vector_unit_id),
+      register_file_size(register_file_size),
+      vector_lane_id(vector_lane_id),
+      isLS(isLS),
+      rf0_inst(0),
+      rf1_inst(1) {
+    if (!isLS) initArrays(storage);
 }
 
-Register::Register(Register const& reg)
-    : Register(reg.cluster_id,
-          reg.vector_unit_id,
-          reg.vector_lane_id,
-          reg.register_file_size,
-          reg.isLS) {
-    if (!reg.is_disabled("Constructor")) {
-        memcpy(rf_data, reg.rf_data, sizeof(int) * reg.register_file_size * 3);
-        memcpy(rf_flag[0], reg.rf_flag[0], sizeof(int) * reg.register_file_size);
-        memcpy(rf_flag[1], reg.rf_flag[1], sizeof(int) * reg.register_file_size);
+Register::~Register() {
+    if (owns_storage) {
+        delete[] rf;
     }
 }
 
+void Register::traceWrite(int addr, uint32_t data) {
+    if (isLS) return;  // as in the hw: no rf (trace) in the LS lane
+    Trace::Writer::get().record(Trace::RF_WRITE,
+        cluster_id,
+        vector_unit_id,
+        vector_lane_id,
+        addr,
+        (rf[addr] & UNINITIALIZED) ? Trace::UNINITIALIZED : (rf[addr] & DATA_MASK),
+        data & DATA_MASK);
+}
+
 void Register::update() {
     if (rf_inst.nxt) {
         set_rf_data(rf_inst.addr, rf_inst.data, rf_inst.size);
@@ -209,6 +129,19 @@ void Register::update() {
     }
 }
 
+void Register::saveState(Checkpoint::Writer& w) const {
+    if (is_disabled("saveState", false)) return;
+    w.data(rf, register_file_size * sizeof(uint32_t));
+}
+
+void Register::restoreState(Checkpoint::Reader& r) {
+    if (is_disabled("restoreState", false)) return;
+    r.data(rf, register_file_size * sizeof(uint32_t));
+    rf_inst.nxt = false;
+    rf0_inst.nxt = false;
+    rf1_inst.nxt = false;
+}
+
 void Register::set_rf_data_nxt(int addr, uint32_t data, int size) {
     if (rf_inst.nxt) printf_warning("[RegisterFile]: Override RF Nxt Value\n");
     rf_inst.addr = addr;
@@ -233,8 +166,4 @@ void Register::set_rf_flag_nxt(int addr, int select, bool value) {
     }
 }
 
-void Register::openTraceFile(const char* tracefilename) {
-    trace = std::ofstream(tracefilename);
-}
-
 }  // namespace RegisterFile
@@ -4,6 +4,12 @@
 #include <fstream>
 #include <string>
 #include "../../simulator/helper/typeConversion.h"
+#include "../../simulator/setting.h"
+
+namespace Checkpoint {
+class Writer;
+class Reader;
+}  // namespace Checkpoint
 
 namespace RegisterFile {
 
@@ -23,40 +29,106 @@ struct RegisterInstructionFlag {
     RegisterInstructionFlag(int flag) : flag(flag) {}
 };
 
+/**
+ * Register file of a lane. Each entry is packed into one 32-bit word:
+ *   [23:0] data, [24] zero flag, [25] negative flag, [26] uninitialized
+ * The storage of all lanes of a unit is one contiguous block (see VectorUnit), lane by lane.
+ *
+ * The *_unchecked accessors are used by the lane pipelines (address from the decoded command).
+ * The regular accessors add the range / disabled / uninitialized checks in debug builds only
+ * (see CHECKED_MEMORY_ACCESS), in release builds they map to the unchecked ones.
+ */
 class Register {
    public:
+    static constexpr uint32_t DATA_MASK = 0x00ffffffu;
+    static constexpr uint32_t ZERO_FLAG = 1u << 24;
+    static constexpr uint32_t NEGATIVE_FLAG = 1u << 25;
+    static constexpr uint32_t UNINITIALIZED = 1u << 26;
+
     Register() = delete;
-    Register(
-        int cluster_id, int vector_unit_id, int vector_lane_id, int register_file_size, bool isLS);
-    Register(Register const& reg);
+    /**
+     * @param storage register_file_size words (owned by the unit), nullptr: allocated by this register file
+     */
+    Register(int cluster_id,
+        int vector_unit_id,
+        int vector_lane_id,
+        int register_file_size,
+        bool isLS,
+        uint32_t* storage = nullptr);
+    Register(Register const& reg) = delete;
     ~Register();
 
-    uint8_t* getregister() {
-        return rf_data;
+    /**
+     * packed entries (see above)
+     */
+    uint32_t* getregister() {
+        return rf;
+    }
+
+    // unchecked access
+    [[nodiscard]] uint32_t get_rf_word_unchecked(int addr) const {
+        return rf[addr];
+    }
+    [[nodiscard]] uint32_t get_rf_data_unchecked(int addr) const {
+        return rf[addr] & DATA_MASK;
+    }
+    [[nodiscard]] bool get_rf_flag_unchecked(int addr, int select) const {
+        return (rf[addr] & (ZERO_FLAG << select)) != 0;
+    }
+    void set_rf_data_unchecked(int addr, uint32_t data) {
+        if constexpr (rf_generate_trace) traceWrite(addr, data);
+        rf[addr] = (rf[addr] & (ZERO_FLAG | NEGATIVE_FLAG)) | (data & DATA_MASK);
+    }
+    void set_rf_flag_unchecked(int addr, int select, bool value) {
+        auto flag = ZERO_FLAG << select;
+        rf[addr] = value ? (rf[addr] | flag) : (rf[addr] & ~flag);
+    }
+
+    // checked access in debug builds
+    [[nodiscard]] uint32_t get_rf_word(int addr) const {
+        if constexpr (CHECKED_MEMORY_ACCESS || CHECK_RF_UNINITIALIZED_ACCESS) {
+            if (!check_read(addr, "get_rf_word")) return 0;
+        }
+        return get_rf_word_unchecked(addr);
+    }
+    [[nodiscard]] uint32_t get_rf_data(int addr, int size = 3) const {
+        if constexpr (CHECKED_MEMORY_ACCESS || CHECK_RF_UNINITIALIZED_ACCESS) {
+            if (!check_read(addr, "get_rf_data", size)) return 0;
+        }
+        return get_rf_data_unchecked(addr);
     }
-    bool* getzeroflag() {
-        return rf_flag[0];
+    [[nodiscard]] bool get_rf_flag(int addr, int select) const {
+        if constexpr (CHECKED_MEMORY_ACCESS) {
+            if (!check_flag(addr, select, "get_rf_flag")) return false;
+        }
+        return get_rf_flag_unchecked(addr, select);
     }
-    bool* getnegativeflag() {
-        return rf_flag[1];
+    void set_rf_data(int addr, uint32_t data, int size = 3) {
+        if constexpr (CHECKED_MEMORY_ACCESS) {
+            if (!check_write(addr, "set_rf_data", size)) return;
+        }
+        set_rf_data_unchecked(addr, data);
+    }
+    void set_rf_flag(int addr, int select, bool value) {
+        if constexpr (CHECKED_MEMORY_ACCESS) {
+            if (!check_flag(addr, select, "set_rf_flag")) return;
+        }
+        set_rf_flag_unchecked(addr, select, value);
     }
 
-    uint32_t get_rf_data(int addr, int size = 3) const;
-    void set_rf_data(int addr, uint32_t data, int size = 3);
     void set_rf_data_nxt(int addr, uint32_t data, int size = 3);
-    bool get_rf_flag(int addr, int select) const;
-    void set_rf_flag(int addr, int select, bool value);
     void set_rf_flag_nxt(int addr, int select, bool value);
     void update();
 
+    // rf data, flags and initialization state (see ISS::checkpointSave)
+    void saveState(Checkpoint::Writer& w) const;
+    void restoreState(Checkpoint::Reader& r);
+
    private:
     int cluster_id, vector_unit_id;
 
-    uint8_t*
-        rf_data;  // each lane has a register file. 3 elements of this 8-bit array form an element of the rf! [0 - LSB][1][2 - MSB]
-    bool* rf_flag[2];  // each register file entry has two additional flags: is_zero, is_negative
-
-    bool* is_uninitialized;  // each register in the begin is not initialized!
+    uint32_t* rf{nullptr};  // packed entries of this lanes register file
+    bool owns_storage{false};
 
     int register_file_size;
 
@@ -68,13 +140,15 @@ class Register {
     RegisterInstructionFlag rf0_inst;
     RegisterInstructionFlag rf1_inst;
 
-    bool rf_generate_trace{false};
-    std::ofstream trace;
+    static constexpr bool rf_generate_trace = GENERATE_RF_TRACE;
 
-    bool is_disabled(std::string func, bool print_msg = true) const;
-    void initArrays();
+    bool is_disabled(const char* func, bool print_msg = true) const;
+    bool check_read(int addr, const char* func, int size = 3) const;
+    bool check_write(int addr, const char* func, int size = 3) const;
+    bool check_flag(int addr, int select, const char* func) const;
+    void initArrays(uint32_t* storage);
 
-    void openTraceFile(const char* tracefilename);
+    void traceWrite(int addr, uint32_t data);
 };
 
 }  // namespace RegisterFile
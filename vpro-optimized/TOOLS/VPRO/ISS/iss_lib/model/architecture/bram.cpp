@@ -6,7 +6,8 @@
 #include <sys/mman.h>
 #include "../../simulator/helper/debugHelper.h"
 
-Bram::Bram(uint32_t bram_size_byte, uint32_t bram_word_length) {
+Bram::Bram(uint32_t bram_size_byte, uint32_t bram_word_length, uint32_t ports) {
+    this->ports = ports > 0 ? ports : 1;
     this->bram_word_length = bram_word_length;
     this->bram_size_byte = bram_size_byte;
 //    printf("BRAM ... bram_word_length: %i, bram_size_byte: %i\n", bram_word_length, bram_size_byte);
@@ -35,7 +36,7 @@ void Bram::write(uint32_t addr, const uint8_t* data) {
 }
 
 bool Bram::get_accessed_this_cycle() {
-    return (accessed_this_cycle >= dcma_dataword_length_byte / dma_dataword_length_byte);
+    return (accessed_this_cycle >= ports * dcma_dataword_length_byte / dma_dataword_length_byte);
 }
 
 void Bram::set_accessed_this_cycle(bool access) {
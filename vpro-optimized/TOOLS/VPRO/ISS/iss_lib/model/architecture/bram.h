@@ -10,7 +10,10 @@
 
 class Bram {
    public:
-    Bram(uint32_t bram_size_byte, uint32_t bram_word_length);
+    /**
+     * @param ports 128-bit accesses per cycle
+     */
+    Bram(uint32_t bram_size_byte, uint32_t bram_word_length, uint32_t ports = 1);
 
     void read(uint32_t addr, uint8_t* data);
 
@@ -20,6 +23,14 @@ class Bram {
 
     void set_accessed_this_cycle(bool access);
 
+    uint8_t* getMemory() {
+        return memory;
+    }
+
+    [[nodiscard]] uint32_t getByteSize() const {
+        return bram_size_byte;
+    }
+
    private:
     constexpr static int dma_dataword_length_byte = 16 / 8;
     constexpr static int dcma_dataword_length_byte = 128 / 8;
@@ -27,6 +38,7 @@ class Bram {
     uint32_t bram_word_length;  // in bytes
     uint32_t bram_size_byte;         // in words
     uint32_t accessed_this_cycle = 0;
+    uint32_t ports;
 
 //    std::vector<std::vector<uint8_t>> memory;
     uint8_t *memory;
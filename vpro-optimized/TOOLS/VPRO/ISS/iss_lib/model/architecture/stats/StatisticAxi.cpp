@@ -4,6 +4,7 @@
 
 #include "StatisticAxi.h"
 #include "../../../simulator/ISS.h"
+#include "../../../simulator/helper/checkpoint.h"
 #include "../../../simulator/helper/debugHelper.h"
 
 #include "JSONHelpers.h"
@@ -22,6 +23,27 @@ void StatisticAxi::print(QString& output) {
     out << "[AXI]  Statistics, Clock: " << MAGENTA << 1000 / core->getAxiClockPeriod() << " MHz"
         << RESET_COLOR << ", Total Clock Ticks: " << total_ticks
         << ", Runtime: " << total_ticks * core->getAxiClockPeriod() << "ns \n";
+
+    auto avg = [](uint64_t sum, uint64_t count) { return count == 0 ? 0. : double(sum) / count; };
+    out << "  Main Memory Counters\n";
+    out << "      Read Bursts:          " << counters.read_bursts << "  [" << counters.read_bytes
+        << " bytes, avg. latency " << avg(counters.read_latency_cycles, counters.read_bursts)
+        << " cycles]\n";
+    out << "      Write Bursts:         " << counters.write_bursts << "  [" << counters.write_bytes
+        << " bytes, avg. latency " << avg(counters.write_latency_cycles, counters.write_bursts)
+        << " cycles]\n";
+    out << "      Bandwidth:            "
+        << avg(counters.read_bytes + counters.write_bytes, total_ticks) << " bytes per cycle\n";
+    out << "      Data Bus Busy:        " << 100 * avg(counters.transfer_cycles, total_ticks)
+        << "%\n";
+    if (counters.row_hits + counters.row_misses > 0) {
+        out << "      Row Buffer Hit Rate:  "
+            << 100 * avg(counters.row_hits, counters.row_hits + counters.row_misses) << "%  ["
+            << counters.row_hits << " hits, " << counters.row_misses << " misses]\n";
+        out << "      Turnarounds:          " << counters.turnarounds << "\n";
+        out << "      Outstanding Stalls:   " << counters.outstanding_stall_cycles
+            << " cycles\n";
+    }
     out << "\n";
 }
 
@@ -29,10 +51,32 @@ void StatisticAxi::print_json(QString& output) {
     QTextStream out(&output);
     out << JSON_OBJ_BEGIN;
     out << JSON_FIELD_FLOAT("clock_period", core->getAxiClockPeriod()) << ",";
-    out << JSON_FIELD_INT("total_ticks", total_ticks);
+    out << JSON_FIELD_INT("total_ticks", total_ticks) << ",";
+    out << JSON_FIELD_INT("mm_read_bursts", counters.read_bursts) << ",";
+    out << JSON_FIELD_INT("mm_write_bursts", counters.write_bursts) << ",";
+    out << JSON_FIELD_INT("mm_read_bytes", counters.read_bytes) << ",";
+    out << JSON_FIELD_INT("mm_write_bytes", counters.write_bytes) << ",";
+    out << JSON_FIELD_INT("mm_read_latency_cycles", counters.read_latency_cycles) << ",";
+    out << JSON_FIELD_INT("mm_write_latency_cycles", counters.write_latency_cycles) << ",";
+    out << JSON_FIELD_INT("mm_transfer_cycles", counters.transfer_cycles) << ",";
+    out << JSON_FIELD_INT("mm_outstanding_stall_cycles", counters.outstanding_stall_cycles) << ",";
+    out << JSON_FIELD_INT("mm_row_hits", counters.row_hits) << ",";
+    out << JSON_FIELD_INT("mm_row_misses", counters.row_misses) << ",";
+    out << JSON_FIELD_INT("mm_turnarounds", counters.turnarounds);
     out << JSON_OBJ_END;
 }
 
 void StatisticAxi::reset() {
     StatisticBase::reset();
+    counters = MainMemoryCounters();
+}
+
+void StatisticAxi::saveState(Checkpoint::Writer& w) {
+    StatisticBase::saveState(w);
+    w.value(counters);
+}
+
+void StatisticAxi::restoreState(Checkpoint::Reader& r) {
+    StatisticBase::restoreState(r);
+    r.value(counters);
 }
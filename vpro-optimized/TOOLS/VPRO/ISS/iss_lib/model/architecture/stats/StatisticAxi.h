@@ -7,8 +7,27 @@
 
 #include "StatisticBase.h"
 
+#include <cstdint>
+
 class StatisticAxi : public StatisticBase {
    public:
+    /**
+     * main memory bursts (NonBlockingMainMemory, see MainMemoryTiming), all cycles in AXI cycles
+     */
+    struct MainMemoryCounters {
+        uint64_t read_bursts = 0;
+        uint64_t write_bursts = 0;
+        uint64_t read_bytes = 0;
+        uint64_t write_bytes = 0;
+        uint64_t read_latency_cycles = 0;   // sum of request to completion
+        uint64_t write_latency_cycles = 0;  // sum of request to completion
+        uint64_t transfer_cycles = 0;       // data bus / channels occupied
+        uint64_t outstanding_stall_cycles = 0;
+        uint64_t row_hits = 0;
+        uint64_t row_misses = 0;
+        uint64_t turnarounds = 0;
+    } counters;
+
     explicit StatisticAxi(ISS* core);
 
     void tick() override;
@@ -17,6 +36,9 @@ class StatisticAxi : public StatisticBase {
     void print_json(QString& output) override;
 
     void reset() override;
+
+    void saveState(Checkpoint::Writer& w) override;
+    void restoreState(Checkpoint::Reader& r) override;
 };
 
 #endif  //CONV2DADD_STATISTICaxi_H
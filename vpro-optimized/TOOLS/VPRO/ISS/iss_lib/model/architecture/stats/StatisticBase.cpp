@@ -3,6 +3,7 @@
 //
 
 #include "StatisticBase.h"
+#include "../../../simulator/helper/checkpoint.h"
 #include "../../../simulator/helper/debugHelper.h"
 
 StatisticBase::StatisticBase() {}
@@ -13,6 +14,10 @@ void StatisticBase::tick() {
     total_ticks++;
 }
 
+void StatisticBase::skipTicks(uint64_t ticks) {
+    total_ticks += long(ticks);
+}
+
 void StatisticBase::print(QString& output) {
     output.asprintf("Total Clock Ticks: %li \n", total_ticks);
 }
@@ -20,3 +25,11 @@ void StatisticBase::print(QString& output) {
 void StatisticBase::reset() {
     total_ticks = 0;
 }
+
+void StatisticBase::saveState(Checkpoint::Writer& w) {
+    w.value(total_ticks);
+}
+
+void StatisticBase::restoreState(Checkpoint::Reader& r) {
+    r.value(total_ticks);
+}
@@ -6,9 +6,15 @@
 #define CONV2DADD_STATISTICBASE_H
 
 #include <QString>
+#include <cstdint>
 
 class ISS;
 
+namespace Checkpoint {
+class Writer;
+class Reader;
+}  // namespace Checkpoint
+
 class StatisticBase {
    public:
     StatisticBase();
@@ -16,11 +22,23 @@ class StatisticBase {
 
     virtual void tick();
 
+    /**
+     * account skipped ticks of the clock domain (no state change, see ISS::skipToNextEvent)
+     * @param ticks number of skipped clock ticks
+     */
+    virtual void skipTicks(uint64_t ticks);
+
     virtual void print(QString& output);
     virtual void print_json(QString& output){};
 
     virtual void reset();
 
+    /**
+     * counters of the clock domain (see ISS::checkpointSave)
+     */
+    virtual void saveState(Checkpoint::Writer& w);
+    virtual void restoreState(Checkpoint::Reader& r);
+
    protected:
     ISS* core;
 
@@ -4,6 +4,7 @@
 
 #include "StatisticDcma.h"
 #include "../../../simulator/ISS.h"
+#include "../../../simulator/helper/checkpoint.h"
 #include "../../../simulator/helper/debugHelper.h"
 
 #include "JSONHelpers.h"
@@ -24,6 +25,7 @@ StatisticDcma::StatisticDcma(ISS* core) : StatisticBase(core) {
     counters.read_miss_access_counter = 0;
     counters.write_hit_access_counter = 0;
     counters.write_miss_access_counter = 0;
+    counters.mshr_active_cycle_counter = std::vector<uint32_t>(core->dcma->getMshrs() + 1, 0);
     dma_access_counter.read_hit_cycles = std::vector<uint32_t>(num_cluster, 0);
     dma_access_counter.read_miss_cycles = std::vector<uint32_t>(num_cluster, 0);
     dma_access_counter.write_hit_cycles = std::vector<uint32_t>(num_cluster, 0);
@@ -74,6 +76,35 @@ void StatisticDcma::tick() {
     cycle_counters.did_dma_write_miss = std::vector<uint32_t>(number_cluster, 0);
 
     if (core->dcma->isBusy()) counters.dcma_busy_cycles++;
+    counters.mshr_active_cycle_counter[core->dcma->getActiveMshrs()]++;
+}
+
+void StatisticDcma::skipTicks(uint64_t ticks) {
+    StatisticBase::skipTicks(ticks);
+
+    // each cycle as tick(): the open dma requests miss (stall on a line fill), no hit
+    uint32_t read_stalls = 0, write_stalls = 0;
+    for (uint32_t i = 0; i < VPRO_CFG::CLUSTERS; ++i) {
+        if (core->dcma->isStalled(i, true)) {
+            read_stalls++;
+            dma_access_counter.read_miss_cycles[i] += ticks;
+        }
+        if (core->dcma->isStalled(i, false)) {
+            write_stalls++;
+            dma_access_counter.write_miss_cycles[i] += ticks;
+        }
+    }
+    counters.dma_read_hit_cycle_counter[0] += ticks;
+    counters.dma_read_stall_cycle_counter[0] += ticks;
+    counters.dma_read_stall_cycle_counter[read_stalls] += ticks;
+    counters.dma_write_hit_cycle_counter[0] += ticks;
+    counters.dma_write_stall_cycle_counter[0] += ticks;
+    counters.dma_write_stall_cycle_counter[write_stalls] += ticks;
+    counters.read_miss_cycle_counter += read_stalls * ticks;
+    counters.write_miss_cycle_counter += write_stalls * ticks;
+
+    if (core->dcma->isBusy()) counters.dcma_busy_cycles += ticks;
+    counters.mshr_active_cycle_counter[core->dcma->getActiveMshrs()] += ticks;
 }
 
 void StatisticDcma::reset() {
@@ -96,6 +127,7 @@ void StatisticDcma::reset() {
     counters.read_miss_access_counter = 0;
     counters.write_hit_access_counter = 0;
     counters.write_miss_access_counter = 0;
+    counters.mshr_active_cycle_counter = std::vector<uint32_t>(core->dcma->getMshrs() + 1, 0);
     dma_access_counter.read_hit_cycles = std::vector<uint32_t>(number_cluster, 0);
     dma_access_counter.read_miss_cycles = std::vector<uint32_t>(number_cluster, 0);
     dma_access_counter.write_hit_cycles = std::vector<uint32_t>(number_cluster, 0);
@@ -189,6 +221,20 @@ void StatisticDcma::print(QString& output) {
         << "-Bit-Words: " << float(counters.bus_read_cycles) / float(total_ticks) << "\n";
     out << "  Average send Bus Write Data per Cycle in " << core->dcma->bus_dataword_length_byte * 8
         << "-Bit-Words:    " << float(counters.bus_write_cycles) / float(total_ticks) << "\n";
+    out << "  Line Fills (Miss / Prefetch):                              " << counters.line_fills
+        << " / " << counters.prefetch_line_fills << "\n";
+    if (counters.prefetch_line_fills > 0) {
+        out << "  Prefetch Accuracy:                                         "
+            << 100 * float(counters.prefetch_useful) / float(counters.prefetch_line_fills)
+            << "%  [" << counters.prefetch_useful << " used, " << counters.prefetch_unused
+            << " evicted unused]\n";
+    }
+    if (counters.mshr_active_cycle_counter.size() > 2) {
+        out << "  Cycles with n outstanding Line Fills (MSHRs):             ";
+        for (size_t i = 0; i < counters.mshr_active_cycle_counter.size(); ++i)
+            out << " " << i << ": " << counters.mshr_active_cycle_counter[i];
+        out << "\n";
+    }
     out << "  Total Bytes read (Bus -> DCMA):                            "
         << counters.bus_read_cycles * core->dcma->bus_dataword_length_byte << "\n";
     out << "  Total Bytes written (DCMA -> Bus):                         "
@@ -204,6 +250,123 @@ void StatisticDcma::print_json(QString& output) {
     QTextStream out(&output);
     out << JSON_OBJ_BEGIN;
     out << JSON_FIELD_FLOAT("clock_period", core->getDCMAClockPeriod()) << ",";
-    out << JSON_FIELD_INT("total_ticks", total_ticks);
+    out << JSON_FIELD_INT("total_ticks", total_ticks) << ",";
+
+    // hit counters in dma words (as in print)
+    uint64_t read_hit = uint64_t(counters.read_hit_access_counter) *
+                        core->dcma->dma_dataword_length_byte /
+                        core->dcma->dcma_dataword_length_byte;
+    uint64_t write_hit = uint64_t(counters.write_hit_access_counter) *
+                         core->dcma->dma_dataword_length_byte /
+                         core->dcma->dcma_dataword_length_byte;
+    uint64_t read_total = read_hit + counters.read_miss_access_counter;
+    uint64_t write_total = write_hit + counters.write_miss_access_counter;
+
+    out << JSON_FIELD_INT("read_hit", read_hit) << ",";
+    out << JSON_FIELD_INT("read_miss", counters.read_miss_access_counter) << ",";
+    out << JSON_FIELD_INT("write_hit", write_hit) << ",";
+    out << JSON_FIELD_INT("write_miss", counters.write_miss_access_counter) << ",";
+    out << JSON_FIELD_FLOAT("read_hit_rate", read_total ? double(read_hit) / read_total : 0.)
+        << ",";
+    out << JSON_FIELD_FLOAT("write_hit_rate", write_total ? double(write_hit) / write_total : 0.)
+        << ",";
+
+    uint64_t mshr_cycles = 0;
+    for (size_t i = 0; i < counters.mshr_active_cycle_counter.size(); ++i)
+        mshr_cycles += i * counters.mshr_active_cycle_counter[i];
+    out << JSON_FIELD_INT("line_fills", counters.line_fills) << ",";
+    out << JSON_FIELD_INT("prefetch_line_fills", counters.prefetch_line_fills) << ",";
+    out << JSON_FIELD_INT("prefetch_useful", counters.prefetch_useful) << ",";
+    out << JSON_FIELD_INT("prefetch_unused", counters.prefetch_unused) << ",";
+    out << JSON_FIELD_FLOAT("prefetch_accuracy",
+               counters.prefetch_line_fills
+                   ? double(counters.prefetch_useful) / counters.prefetch_line_fills
+                   : 0.)
+        << ",";
+    out << JSON_FIELD_INT("mshrs", counters.mshr_active_cycle_counter.size() - 1) << ",";
+    out << JSON_FIELD_FLOAT("mshr_avg_active", total_ticks ? double(mshr_cycles) / total_ticks : 0.);
     out << JSON_OBJ_END;
 }
+
+void StatisticDcma::saveState(Checkpoint::Writer& w) {
+    StatisticBase::saveState(w);
+    w.vector(cycle_counters.did_dma_read_hit);
+    w.vector(cycle_counters.did_dma_read_hit_but_busy);
+    w.vector(cycle_counters.did_dma_read_miss);
+    w.vector(cycle_counters.did_dma_write_hit);
+    w.vector(cycle_counters.did_dma_write_hit_but_busy);
+    w.vector(cycle_counters.did_dma_write_miss);
+
+    w.value(counters.read_hit_cyle_counter);
+    w.value(counters.read_hit_but_busy_cycle_counter);
+    w.value(counters.read_miss_cycle_counter);
+    w.value(counters.write_hit_cycle_counter);
+    w.value(counters.write_hit_but_busy_cyle_counter);
+    w.value(counters.write_miss_cycle_counter);
+    w.vector(counters.dma_read_hit_cycle_counter);
+    w.vector(counters.dma_read_stall_cycle_counter);
+    w.vector(counters.dma_write_hit_cycle_counter);
+    w.vector(counters.dma_write_stall_cycle_counter);
+    w.value(counters.bus_write_cycles);
+    w.value(counters.bus_read_cycles);
+    w.value(counters.bus_wait_cycles);
+    w.value(counters.dcma_busy_cycles);
+    w.value(counters.read_hit_access_counter);
+    w.value(counters.read_miss_access_counter);
+    w.value(counters.write_hit_access_counter);
+    w.value(counters.write_miss_access_counter);
+    w.vector(counters.mshr_active_cycle_counter);
+    w.value(counters.line_fills);
+    w.value(counters.prefetch_line_fills);
+    w.value(counters.prefetch_useful);
+    w.value(counters.prefetch_unused);
+
+    w.vector(dma_access_counter.read_hit_cycles);
+    w.vector(dma_access_counter.read_miss_cycles);
+    w.vector(dma_access_counter.write_hit_cycles);
+    w.vector(dma_access_counter.write_miss_cycles);
+}
+
+void StatisticDcma::restoreState(Checkpoint::Reader& r) {
+    StatisticBase::restoreState(r);
+    r.vector(cycle_counters.did_dma_read_hit);
+    r.vector(cycle_counters.did_dma_read_hit_but_busy);
+    r.vector(cycle_counters.did_dma_read_miss);
+    r.vector(cycle_counters.did_dma_write_hit);
+    r.vector(cycle_counters.did_dma_write_hit_but_busy);
+    r.vector(cycle_counters.did_dma_write_miss);
+
+    r.value(counters.read_hit_cyle_counter);
+    r.value(counters.read_hit_but_busy_cycle_counter);
+    r.value(counters.read_miss_cycle_counter);
+    r.value(counters.write_hit_cycle_counter);
+    r.value(counters.write_hit_but_busy_cyle_counter);
+    r.value(counters.write_miss_cycle_counter);
+    r.vector(counters.dma_read_hit_cycle_counter);
+    r.vector(counters.dma_read_stall_cycle_counter);
+    r.vector(counters.dma_write_hit_cycle_counter);
+    r.vector(counters.dma_write_stall_cycle_counter);
+    r.value(counters.bus_write_cycles);
+    r.value(counters.bus_read_cycles);
+    r.value(counters.bus_wait_cycles);
+    r.value(counters.dcma_busy_cycles);
+    r.value(counters.read_hit_access_counter);
+    r.value(counters.read_miss_access_counter);
+    r.value(counters.write_hit_access_counter);
+    r.value(counters.write_miss_access_counter);
+    r.vector(counters.mshr_active_cycle_counter);
+    r.value(counters.line_fills);
+    r.value(counters.prefetch_line_fills);
+    r.value(counters.prefetch_useful);
+    r.value(counters.prefetch_unused);
+
+    r.vector(dma_access_counter.read_hit_cycles);
+    r.vector(dma_access_counter.read_miss_cycles);
+    r.vector(dma_access_counter.write_hit_cycles);
+    r.vector(dma_access_counter.write_miss_cycles);
+
+    // the vectors are indexed by cluster / mshr in tick()
+    if (cycle_counters.did_dma_read_hit.size() != size_t(VPRO_CFG::CLUSTERS) ||
+        counters.mshr_active_cycle_counter.size() != core->dcma->getMshrs() + 1)
+        r.fail("dcma statistics of a different configuration");
+}
@@ -42,6 +42,11 @@ class StatisticDcma : public StatisticBase {
         uint32_t read_miss_access_counter = 0;
         uint32_t write_hit_access_counter = 0;
         uint32_t write_miss_access_counter = 0;
+        std::vector<uint32_t> mshr_active_cycle_counter;  // cycles with [i] outstanding line fills
+        uint32_t line_fills = 0;           // by dma misses
+        uint32_t prefetch_line_fills = 0;  // by the prefetcher
+        uint32_t prefetch_useful = 0;      // prefetched lines accessed by a dma
+        uint32_t prefetch_unused = 0;      // prefetched lines evicted without access
     } counters;
 
     struct DmaAccessCounters {
@@ -54,11 +59,15 @@ class StatisticDcma : public StatisticBase {
     explicit StatisticDcma(ISS* core);
 
     void tick() override;
+    void skipTicks(uint64_t ticks) override;
 
     void print(QString& output) override;
     void print_json(QString& output) override;
 
     void reset() override;
+
+    void saveState(Checkpoint::Writer& w) override;
+    void restoreState(Checkpoint::Reader& r) override;
 };
 
 #endif  //CONV2DADD_STATISTICDCMA_H
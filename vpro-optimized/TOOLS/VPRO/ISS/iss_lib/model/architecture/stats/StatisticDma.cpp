@@ -4,14 +4,19 @@
 
 #include "StatisticDma.h"
 #include "../../../simulator/ISS.h"
+#include "../../../simulator/helper/checkpoint.h"
 #include "../../../simulator/helper/debugHelper.h"
 
 #include "JSONHelpers.h"
 
-StatisticDma::StatisticDma(ISS* core) : StatisticBase(core) {}
+StatisticDma::StatisticDma(ISS* core) : StatisticBase(core) {
+    startedCommands = std::vector<executedCommands_s>(VPRO_CFG::CLUSTERS);
+    started = std::vector<uint8_t>(VPRO_CFG::CLUSTERS, 0);
+}
 
 void StatisticDma::tick() {
     StatisticBase::tick();
+    mergeStartedCommands();
 
     bool DMAActive = false;
 
@@ -28,34 +33,59 @@ void StatisticDma::tick() {
     }
 }
 
+void StatisticDma::skipTicks(uint64_t ticks) {
+    StatisticBase::skipTicks(ticks);
+
+    // busy dmas wait for the dcma, none starts / finishes a command in the skipped cycles
+    uint64_t active = 0;
+    for (auto cluster : core->getClusters()) {
+        if (cluster->dma->isBusy()) active++;
+    }
+    totalDMAActive += ticks * active;
+    totalDMAInActive += ticks * (VPRO_CFG::CLUSTERS - active);
+    if (active > 0) anyDMAActive += ticks;
+}
+
 void StatisticDma::addExecutedCommand(const CommandDMA* cmd, const int& cluster) {
     uint32_t elements = cmd->x_size * cmd->y_size;
+    auto& executed = startedCommands[cluster];
 
     switch (cmd->type) {
         case CommandDMA::EXT_1D_TO_LOC_1D:
-            executedCommands[cluster].e2l_1d_transfer_cmds++;
-            executedCommands[cluster].e2l_elements_transferred += elements;
+            executed.e2l_1d_transfer_cmds++;
+            executed.e2l_elements_transferred += elements;
             break;
         case CommandDMA::EXT_2D_TO_LOC_1D:
-            executedCommands[cluster].e2l_2d_transfer_cmds++;
-            executedCommands[cluster].e2l_elements_transferred += elements;
+            executed.e2l_2d_transfer_cmds++;
+            executed.e2l_elements_transferred += elements;
             break;
         case CommandDMA::LOC_1D_TO_EXT_2D:
-            executedCommands[cluster].l2e_2d_transfer_cmds++;
-            executedCommands[cluster].l2e_elements_transferred += elements;
+            executed.l2e_2d_transfer_cmds++;
+            executed.l2e_elements_transferred += elements;
             break;
         case CommandDMA::LOC_1D_TO_EXT_1D:
-            executedCommands[cluster].l2e_1d_transfer_cmds++;
-            executedCommands[cluster].l2e_elements_transferred += elements;
+            executed.l2e_1d_transfer_cmds++;
+            executed.l2e_elements_transferred += elements;
             break;
         case CommandDMA::NONE:
         case CommandDMA::WAIT_FINISH:
         case CommandDMA::enumTypeEnd:
-            break;
+            return;
+    }
+    started[cluster] = 1;
+}
+
+void StatisticDma::mergeStartedCommands() {
+    for (uint32_t cluster = 0; cluster < started.size(); ++cluster) {
+        if (!started[cluster]) continue;
+        executedCommands[cluster] += startedCommands[cluster];
+        startedCommands[cluster] = executedCommands_s();
+        started[cluster] = 0;
     }
 }
 
 void StatisticDma::print(QString& output) {
+    mergeStartedCommands();
     unsigned long DMAsTotal = total_ticks * VPRO_CFG::CLUSTERS;
 
     QTextStream out(&output);
@@ -135,3 +165,31 @@ void StatisticDma::reset() {
     totalDMAInActive = 0;
     anyDMAActive = 0;
 }
+
+void StatisticDma::saveState(Checkpoint::Writer& w) {
+    StatisticBase::saveState(w);
+    mergeStartedCommands();
+    w.value(totalDMAActive);
+    w.value(totalDMAInActive);
+    w.value(anyDMAActive);
+    w.value(uint32_t(executedCommands.size()));
+    for (auto& it : executedCommands) {
+        w.value(it.first);
+        w.value(it.second);
+    }
+}
+
+void StatisticDma::restoreState(Checkpoint::Reader& r) {
+    StatisticBase::restoreState(r);
+    r.value(totalDMAActive);
+    r.value(totalDMAInActive);
+    r.value(anyDMAActive);
+    uint32_t clusters = 0;
+    r.value(clusters);
+    executedCommands.clear();
+    for (uint32_t i = 0; i < clusters && r.ok(); ++i) {
+        uint32_t cluster = 0;
+        r.value(cluster);
+        r.value(executedCommands[cluster]);
+    }
+}
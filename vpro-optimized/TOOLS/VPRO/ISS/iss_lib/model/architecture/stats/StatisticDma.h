@@ -6,6 +6,7 @@
 #define CONV2DADD_STATISTICDMA_H
 
 #include <map>
+#include <vector>
 #include "../../commands/CommandDMA.h"
 #include "StatisticBase.h"
 
@@ -35,6 +36,11 @@ class StatisticDma : public StatisticBase {
     explicit StatisticDma(ISS* core);
 
     void tick() override;
+    void skipTicks(uint64_t ticks) override;
+    /**
+     * counted for the cluster (staged per cluster: called by the dma threads, see DMA::tickLocal),
+     * merged by tick()
+     */
     void addExecutedCommand(const CommandDMA* cmd, const int& cluster);
 
     void print(QString& output) override;
@@ -42,6 +48,9 @@ class StatisticDma : public StatisticBase {
 
     void reset() override;
 
+    void saveState(Checkpoint::Writer& w) override;
+    void restoreState(Checkpoint::Reader& r) override;
+
    private:
     unsigned long totalDMAActive = 0;
     unsigned long totalDMAInActive = 0;
@@ -49,6 +58,12 @@ class StatisticDma : public StatisticBase {
 
     // for each cluster
     std::map<uint32_t, executedCommands_s> executedCommands{};
+
+    // commands started in the current dma tick, for each cluster (see addExecutedCommand())
+    std::vector<executedCommands_s> startedCommands;
+    std::vector<uint8_t> started;
+
+    void mergeStartedCommands();
 };
 
 #endif  //CONV2DADD_STATISTICDMA_H
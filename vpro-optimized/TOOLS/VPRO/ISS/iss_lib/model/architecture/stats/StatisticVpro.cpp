@@ -4,12 +4,15 @@
 
 #include "StatisticVpro.h"
 #include "../../../simulator/ISS.h"
+#include "../../../simulator/helper/checkpoint.h"
 #include "../../../simulator/helper/debugHelper.h"
 
 #include "JSONHelpers.h"
 
 StatisticVpro::StatisticVpro(ISS* core) : StatisticBase(core) {
     typeCount = std::vector<std::map<CommandVPRO::TYPE, double[2]>>(VPRO_CFG::LANES + 1);
+    clusterTypeCount = std::vector<std::vector<std::map<CommandVPRO::TYPE, double[2]>>>(
+        VPRO_CFG::CLUSTERS, typeCount);
 }
 
 void StatisticVpro::tick() {
@@ -80,6 +83,16 @@ void StatisticVpro::tick() {
     if (LSactive) anyLSLaneActive++;
 }
 
+void StatisticVpro::skipTicks(uint64_t ticks) {
+    StatisticBase::skipTicks(ticks);
+
+    // no lane busy
+    uint32_t parallelUnits = VPRO_CFG::UNITS * VPRO_CFG::CLUSTERS;
+    totalL0LanesInActive += ticks * parallelUnits;
+    totalL1LanesInActive += ticks * parallelUnits;
+    totalLSLanesInActive += ticks * parallelUnits;
+}
+
 double StatisticVpro::getCyclesNotNONE(int lane) {
     double sum = 0;
     for (auto& it : typeCount[lane]) {
@@ -94,15 +107,37 @@ double StatisticVpro::getCyclesNONE(int lane) {
     return typeCount[lane][CommandVPRO::NONE][1];
 }
 
-void StatisticVpro::addExecutedCmdQueue(CommandVPRO* cmd, int vector_lane_id) {
-    typeCount[vector_lane_id][cmd->type][0]++;
+void StatisticVpro::mergeTypeCount() {
+    typeCount = std::vector<std::map<CommandVPRO::TYPE, double[2]>>(VPRO_CFG::LANES + 1);
+    for (auto& cluster : clusterTypeCount) {
+        for (size_t lane = 0; lane < cluster.size(); ++lane) {
+            for (auto& it : cluster[lane]) {
+                typeCount[lane][it.first][0] += it.second[0];
+                typeCount[lane][it.first][1] += it.second[1];
+            }
+        }
+    }
+}
+
+void StatisticVpro::addExecutedCmdQueue(CommandVPRO* cmd, int cluster_id, int vector_lane_id) {
+    clusterTypeCount[cluster_id][vector_lane_id][cmd->type][0]++;
+}
+
+/**
+ * idle lane: the NONE cmd is ticked and finished (queue) each cycle
+ */
+void StatisticVpro::addIdleTicks(int cluster_id, int vector_lane_id, uint64_t ticks) {
+    auto& count = clusterTypeCount[cluster_id][vector_lane_id][CommandVPRO::NONE];
+    count[0] += double(ticks);
+    count[1] += double(ticks);
 }
 
-void StatisticVpro::addExecutedCmdTick(CommandVPRO* cmd, int vector_lane_id) {
-    typeCount[vector_lane_id][cmd->type][1]++;
+void StatisticVpro::addExecutedCmdTick(CommandVPRO* cmd, int cluster_id, int vector_lane_id) {
+    clusterTypeCount[cluster_id][vector_lane_id][cmd->type][1]++;
 }
 
 void StatisticVpro::print(QString& output) {
+    mergeTypeCount();
     uint32_t parallelUnits = VPRO_CFG::UNITS * VPRO_CFG::CLUSTERS;
     unsigned long LaneTotal = total_ticks * parallelUnits;
 
@@ -222,6 +257,7 @@ void StatisticVpro::print(QString& output) {
 }
 
 void StatisticVpro::print_json(QString& output) {
+    mergeTypeCount();
     QTextStream out(&output);
     out << JSON_OBJ_BEGIN;
     out << JSON_FIELD_FLOAT("clock_period", core->getVPROClockPeriod()) << ",";
@@ -352,4 +388,76 @@ void StatisticVpro::reset() {
 
     typeCount.clear();
     typeCount = std::vector<std::map<CommandVPRO::TYPE, double[2]>>(VPRO_CFG::LANES + 1);
+    clusterTypeCount = std::vector<std::vector<std::map<CommandVPRO::TYPE, double[2]>>>(
+        VPRO_CFG::CLUSTERS, typeCount);
+}
+
+/**
+ * the counters per cluster and lane (typeCount is merged from them)
+ */
+void StatisticVpro::saveState(Checkpoint::Writer& w) {
+    StatisticBase::saveState(w);
+    w.value(totalL0LanesSrcStall);
+    w.value(totalL1LanesSrcStall);
+    w.value(totalLSLanesSrcStall);
+    w.value(totalL0LanesDstStall);
+    w.value(totalL1LanesDstStall);
+    w.value(totalLSLanesDstStall);
+    w.value(totalL0LanesActive);
+    w.value(totalL1LanesActive);
+    w.value(totalLSLanesActive);
+    w.value(totalL0LanesInActive);
+    w.value(totalL1LanesInActive);
+    w.value(totalLSLanesInActive);
+    w.value(anyL0LaneActive);
+    w.value(anyL1LaneActive);
+    w.value(anyLSLaneActive);
+    w.value(totalL0LanesBlocking);
+    w.value(totalL1LanesBlocking);
+    w.value(totalLSLanesBlocking);
+
+    for (auto& cluster : clusterTypeCount) {
+        for (auto& lane : cluster) {
+            w.value(uint32_t(lane.size()));
+            for (auto& it : lane) {
+                w.value(uint32_t(it.first));
+                w.value(it.second);
+            }
+        }
+    }
+}
+
+void StatisticVpro::restoreState(Checkpoint::Reader& r) {
+    StatisticBase::restoreState(r);
+    r.value(totalL0LanesSrcStall);
+    r.value(totalL1LanesSrcStall);
+    r.value(totalLSLanesSrcStall);
+    r.value(totalL0LanesDstStall);
+    r.value(totalL1LanesDstStall);
+    r.value(totalLSLanesDstStall);
+    r.value(totalL0LanesActive);
+    r.value(totalL1LanesActive);
+    r.value(totalLSLanesActive);
+    r.value(totalL0LanesInActive);
+    r.value(totalL1LanesInActive);
+    r.value(totalLSLanesInActive);
+    r.value(anyL0LaneActive);
+    r.value(anyL1LaneActive);
+    r.value(anyLSLaneActive);
+    r.value(totalL0LanesBlocking);
+    r.value(totalL1LanesBlocking);
+    r.value(totalLSLanesBlocking);
+
+    for (auto& cluster : clusterTypeCount) {
+        for (auto& lane : cluster) {
+            uint32_t types = 0;
+            r.value(types);
+            lane.clear();
+            for (uint32_t i = 0; i < types && r.ok(); ++i) {
+                uint32_t type = 0;
+                r.value(type);
+                r.value(lane[CommandVPRO::TYPE(type)]);
+            }
+        }
+    }
 }
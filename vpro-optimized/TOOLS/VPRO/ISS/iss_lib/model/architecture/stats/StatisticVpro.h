@@ -40,6 +40,10 @@ class StatisticVpro : public StatisticBase {
 
     std::vector<std::map<CommandVPRO::TYPE, double[2]>> typeCount;  // queue + clockticks
 
+    // [cluster][lane] counters, clusters can be ticked by different threads (merged to typeCount)
+    std::vector<std::vector<std::map<CommandVPRO::TYPE, double[2]>>> clusterTypeCount;
+    void mergeTypeCount();
+
     double getCyclesNotNONE(int lane);
     double getCyclesNONE(int lane);
 
@@ -50,14 +54,19 @@ class StatisticVpro : public StatisticBase {
     explicit StatisticVpro(ISS* core);
 
     void tick() override;
+    void skipTicks(uint64_t ticks) override;
 
-    void addExecutedCmdTick(CommandVPRO* cmd, int vector_lane_id);
-    void addExecutedCmdQueue(CommandVPRO* cmd, int vector_lane_id);
+    void addExecutedCmdTick(CommandVPRO* cmd, int cluster_id, int vector_lane_id);
+    void addExecutedCmdQueue(CommandVPRO* cmd, int cluster_id, int vector_lane_id);
+    void addIdleTicks(int cluster_id, int vector_lane_id, uint64_t ticks);
 
     void print(QString& output) override;
     void print_json(QString& output) override;
 
     void reset() override;
+
+    void saveState(Checkpoint::Writer& w) override;
+    void restoreState(Checkpoint::Reader& r) override;
 };
 
 #endif  //CONV2DADD_STATISTICVPRO_H
@@ -8,6 +8,7 @@
 #include <QFile>
 #include <QTextStream>
 #include "../../../simulator/ISS.h"
+#include "../../../simulator/helper/checkpoint.h"
 
 #include "JSONHelpers.h"
 
@@ -46,6 +47,11 @@ void Statistics::tick(clock_domains clock) {
     }
 }
 
+void Statistics::skipTicks(clock_domains clock, uint64_t ticks) {
+    if (ticks == 0) return;
+    stats[clock]->skipTicks(ticks);
+}
+
 void Statistics::print() {
     QString output;
     print(output);
@@ -186,3 +192,15 @@ void Statistics::reset(Statistics::clock_domains clock) {
             stats[clock]->reset();
     }
 }
+
+void Statistics::saveState(Checkpoint::Writer& w) {
+    for (auto stat : stats) {
+        stat->saveState(w);
+    }
+}
+
+void Statistics::restoreState(Checkpoint::Reader& r) {
+    for (auto stat : stats) {
+        stat->restoreState(r);
+    }
+}
@@ -40,6 +40,10 @@ class Statistics {
     Statistics(Statistics const&) = delete;
     void operator=(Statistics const&) = delete;
 
+    StatisticAxi* getAXIStat() {
+        return dynamic_cast<StatisticAxi*>(stats[clock_domains::AXI]);
+    }
+
     StatisticDcma* getDCMAStat() {
         return dynamic_cast<StatisticDcma*>(stats[clock_domains::DCMA]);
     }
@@ -54,6 +58,13 @@ class Statistics {
 
     void tick(clock_domains clock);
 
+    /**
+     * bulk tick of a clock domain without state changes (idle or stalled)
+     * @param clock domain
+     * @param ticks number of skipped clock ticks
+     */
+    void skipTicks(clock_domains clock, uint64_t ticks);
+
     void print();
     void print(QString& output);
     void print(clock_domains clock, QString& output);
@@ -68,6 +79,12 @@ class Statistics {
     void reset();
     void reset(clock_domains clock);
 
+    /**
+     * counters of all clock domains (see ISS::checkpointSave)
+     */
+    void saveState(Checkpoint::Writer& w);
+    void restoreState(Checkpoint::Reader& r);
+
    private:
     StatisticBase* stats[clock_domains::end];
     ISS* core;
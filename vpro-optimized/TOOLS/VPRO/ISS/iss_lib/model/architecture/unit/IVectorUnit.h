@@ -24,18 +24,28 @@ class IVectorUnit {
     virtual void tick() = 0;
     virtual void update() = 0;
     [[nodiscard]] virtual bool isBusy() = 0;
+    [[nodiscard]] virtual bool isIdle() = 0;
+    virtual void idleTick(uint64_t cycles = 1) = 0;
 
     // Command Queue interface
     [[nodiscard]] virtual bool isCmdQueueFull() = 0;
     [[nodiscard]] virtual bool trySendCMD(std::shared_ptr<CommandVPRO> const& cmd) = 0;
     virtual std::deque<std::shared_ptr<CommandVPRO>> getCopyOfCommandQueue() = 0;
 
+    // Functional mode interface
+    virtual void issueFunctional(CommandVPRO const& cmd) = 0;
+    [[nodiscard]] virtual bool runFunctional() = 0;
+
     // Local memory interface
     virtual uint8_t* getLocalMemoryPtr() = 0;
     [[nodiscard]] virtual uint32_t getLocalMemoryData(uint32_t addr, int size = 2) = 0;
     virtual void writeLocalMemoryData(uint32_t addr, uint32_t data, int size = 2) = 0;
     virtual void writeLocalMemoryData(const uint32_t& addr, const uint8_t* data, int size = 2) = 0;
 
+    // Checkpoint interface (local memory and lanes of a drained unit)
+    virtual void saveState(Checkpoint::Writer& w) = 0;
+    virtual void restoreState(Checkpoint::Reader& r) = 0;
+
     // Debug helpers
     virtual void dumpLocalMemory(const std::string& prefix = "") = 0;
     virtual void dumpRegisterFile(uint32_t lane) = 0;
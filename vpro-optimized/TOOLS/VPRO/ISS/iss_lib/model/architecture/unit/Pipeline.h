@@ -18,12 +18,16 @@ namespace Unit {
 
 class VectorLane;  //fw declaration
 
+// whether any operand (src1, src2, dst) of cmd selects src_sel
+bool chains_from_src(const CommandVPRO& cmd, uint32_t src_sel);
+
 struct PipelineDate {
     // result (got in stage of alu finish)
     uint32_t data;
     // in sim the result is calc in one cycle / loaded in same. stored (tmp) here
     uint32_t pre_data;
-    std::shared_ptr<CommandVPRO> cmd;
+    // command of this stage. points to one of the command slots of the owning PipeObject
+    CommandVPRO* cmd;
 
     uint32_t opa, opb, opc;
     uint32_t res;
@@ -40,7 +44,7 @@ struct PipelineDate {
         rf_addr = 0;
         lm_addr = 0;
         move = false;
-        cmd = std::make_shared<CommandVPRO>();
+        cmd = nullptr;
         flag[0] = false;
         flag[1] = false;
         res = 0;
@@ -59,30 +63,96 @@ class PipeObject {
     // depth of current pipeline (in which step the wb is executed, may change with new commands...)
     // read in tick stage pipelinedepth + 5 (WB)
     // updated in tick() when a different pipeline depth cmd is received (stage 0/-1)
+    // only modified by setPipelineALUDepth()
     int pipelineALUDepth;
 
     //int pipeline_depth; //@Obsolete
 
     PipeObject() = delete;
     PipeObject(int size, int pipelineALUDepth);
-    PipelineDate& operator[](int index);
-    const PipelineDate& operator[](int index) const;
+    PipeObject(PipeObject const&) = delete;
+    void operator=(PipeObject const&) = delete;
+    PipelineDate& operator[](int index) {
+        return data[physicalIndex(index)];
+    }
+    const PipelineDate& operator[](int index) const {
+        return data[physicalIndex(index)];
+    }
+    void setPipelineALUDepth(int depth);
     void resetAccu(VectorLane& vl, int64_t value = 0);
     void resetMinMax(uint32_t value);
-    virtual void tick_pipeline(VectorLane& vl, int from, int until);
-    void process(std::shared_ptr<CommandVPRO> newElement);
+    void tick_pipeline(VectorLane& vl, int from, int until);
+    /**
+     * functional mode: processes the current element (x, y, z) of cmd through all stages at once.
+     * rf / fifo writes are set as in the pipeline (update of the lane required)
+     */
+    void execute_element(VectorLane& vl, const CommandVPRO& cmd);
+    void process(const CommandVPRO* newElement);
     void processInStall(int from);
-    bool isBusy() const;
+    bool isBusy() const {
+        return busy_stages > 0;
+    }
+    bool isEmpty() const {
+        return occupied_stages == 0;
+    }
     void update();
     bool isChaining() const;
     bool isBlocking(int chain_target_stage) const;
-    void check_indirect_addressing(CommandVPRO cmd);
+    void check_indirect_addressing(const CommandVPRO& cmd);
+
+    /**
+     * ALU operation of the command type (CommandVPRO::decode(), called by execute_cmd())
+     */
+    static AluKernel aluKernel(CommandVPRO::TYPE type);
 
    protected:
     // the processing needs PIPELINE_DEPTH cycles. each cycle the last entry from pipeline is written into rf_data!
     // on parsing a new command, a new pipeline entry is inserted with currently read data from rf
     // PipelineDate results_pipeline[11];
+    // ring buffer: stages 0 ... 5 + pipelineALUDepth + 1 start at data[head] (see physicalIndex()).
+    // stages behind are not shifted anymore (after a pipeline depth decrease) and stay in place
     std::vector<PipelineDate> data;
+    int head{0};
+    int length;  // stages in the ring (5 + pipelineALUDepth + 2)
+
+    // storage of the stage commands (one per stage, never reallocated).
+    // the slot of the command shifted out of the pipeline is reused for the new one -> no heap allocation per tick
+    std::vector<CommandVPRO> cmd_slots;
+
+    // incrementally updated on shift / insert
+    int busy_stages{0};      // stages 0 ... 5 + pipelineALUDepth with a cmd (isBusy)
+    int occupied_stages{0};  // stages 0 ... 5 + pipelineALUDepth + 1 with a cmd (isEmpty)
+    int blocking_stages{0};  // stages 0 ... 5 + pipelineALUDepth - 1 - blocking_target_stage with a blocking cmd
+    static constexpr int blocking_target_stage = 3;  // chain target stage of the lanes (see isBlocking)
+
+    // stages processed by tick_stage() (address calc 0, offsets 3, operands 4, alu 5, ls data 8, write back).
+    // the stages in between only delay the element, tick_pipeline() skips them
+    uint32_t work_stages{0};
+    static uint32_t workStages(int pipelineALUDepth) {
+        return (1u << 0) | (1u << 3) | (1u << 4) | (1u << 5) | (1u << 8) |
+               (1u << (5 + pipelineALUDepth + 1));
+    }
+
+    int physicalIndex(int stage) const {
+        if (stage >= length) return stage;
+        int i = head + stage;
+        return (i >= length) ? i - length : i;
+    }
+
+    /**
+     * shift the stages from ... end by one (ring rotation), stages before from keep their content (stall)
+     * @return the new (empty) stage from, using the cmd slot of the element shifted out
+     */
+    PipelineDate& shift(int from);
+    void countStage(const PipelineDate& pipe, int stage, int sign);
+    void recount();
+
+    // processing of a single stage, used by tick_pipeline() and execute_element()
+    virtual void tick_stage(VectorLane& vl, PipelineDate& pipe, int stage);
+
+    // element (and its cmd copy, stages modify offsets) of execute_element()
+    PipelineDate element;
+    CommandVPRO element_cmd;
 
    private:
     virtual void execute_cmd(VectorLane& vl, PipelineDate& pipe);
@@ -90,10 +160,12 @@ class PipeObject {
 
 class LSPipeObject : public PipeObject {
    public:
-    void tick_pipeline(VectorLane& vl, int from, int until) override;
     LSPipeObject() = delete;
     LSPipeObject(int size, int pipelineALUDepth) : PipeObject(size, pipelineALUDepth) {}
 
+   protected:
+    void tick_stage(VectorLane& vl, PipelineDate& pipe, int stage) override;
+
    private:
     void execute_cmd(VectorLane& vl, PipelineDate& pipe) override;
 };
@@ -12,6 +12,7 @@
 #include <iostream>
 #include "../../../core_wrapper.h"
 #include "../../../simulator/ISS.h"
+#include "../../../simulator/helper/checkpoint.h"
 #include "../../../simulator/helper/debugHelper.h"
 #include "../../../simulator/helper/typeConversion.h"
 #include "../../../simulator/setting.h"
@@ -48,10 +49,10 @@ VectorLane::VectorLane(int id,
           vector_unit->vector_unit_id,
           vector_lane_id,
           VPRO_CFG::RF_SIZE,
-          (id == 1 << VPRO_CFG::LANES)) {
-    current_cmd = std::make_shared<CommandVPRO>();
-    new_cmd = std::make_shared<CommandVPRO>();
-    noneCmd = std::make_shared<CommandVPRO>();
+          (id == 1 << VPRO_CFG::LANES),
+          vector_unit->getRegisterFileStorage(id)) {
+    current_cmd = &delay_cmd;
+    new_cmd = &fetched_cmd;
     pipeObj = std::make_unique<PipeObject>(5 + CommandVPRO::MAX_ALU_DEPTH, 3);
 }
 
@@ -60,13 +61,29 @@ VectorLane::VectorLane(int id,
  * @return bool
  */
 bool VectorLane::isBusy() const {
-    return isBlocking() || pipeObj->isBusy();
+    return isBlocking() || pipeObj->isBusy() || !functional_queue.empty();
 }
+void VectorLane::saveState(Checkpoint::Writer& w) const {
+    regFile.saveState(w);
+    w.value(pipeObj->accu);
+    w.value(pipeObj->minmax_index);
+    w.value(pipeObj->minmax_value);
+    w.value(clock_cycle);
+}
+
+void VectorLane::restoreState(Checkpoint::Reader& r) {
+    regFile.restoreState(r);
+    r.value(pipeObj->accu);
+    r.value(pipeObj->minmax_index);
+    r.value(pipeObj->minmax_value);
+    r.value(clock_cycle);
+}
+
 bool VectorLane::isBlocking() const {
     return blocking;
 }
 
-std::shared_ptr<CommandVPRO> VectorLane::getCmd() {
+CommandVPRO* VectorLane::getCmd() {
     return current_cmd;
 }
 
@@ -139,7 +156,7 @@ void VectorLane::check_stall_conditions() {  //kombinatorische
 void VectorLane::fetchCMD() {
     if (current_cmd->is_done()) {  // Get a new command if the "old" is done
         if (new_cmd->is_done()) {
-            new_cmd = vector_unit->getNextCommandForLane(vector_lane_id);
+            new_cmd = vector_unit->getNextCommandForLane(vector_lane_id, &fetched_cmd);
         }  // if there is already a new cmd fetched...
         if (new_cmd->pipelineALUDepth <
             pipeObj->pipelineALUDepth) {  // check whether to delay the start?
@@ -149,11 +166,12 @@ void VectorLane::fetchCMD() {
                     "pipeline Length has changed!]\n",
                     vector_lane_id);
             });
-            pipeObj->pipelineALUDepth--;  // maybe next tick
-            current_cmd = std::make_shared<CommandVPRO>();
-            current_cmd->id_mask = 1u << uint(vector_lane_id);
+            pipeObj->setPipelineALUDepth(pipeObj->pipelineALUDepth - 1);  // maybe next tick
+            delay_cmd = CommandVPRO();
+            delay_cmd.id_mask = 1u << uint(vector_lane_id);
+            current_cmd = &delay_cmd;
         } else {
-            pipeObj->pipelineALUDepth = new_cmd->pipelineALUDepth;
+            pipeObj->setPipelineALUDepth(int(new_cmd->pipelineALUDepth));
             current_cmd = new_cmd;
         }
     }
@@ -163,22 +181,64 @@ void VectorLane::fetchCMD() {
  * process X, Y and Z SEQ
  */
 void VectorLane::processCMD() {
-    current_cmd->x++;
-    if (current_cmd->x > current_cmd->x_end) {
-        current_cmd->x = 0;
-        current_cmd->y++;
-        if (current_cmd->y > current_cmd->y_end) {
-            current_cmd->y = 0;
-            current_cmd->z++;
-            if (current_cmd->z > current_cmd->z_end) {
+    nextElement(*current_cmd);
+}
+
+void VectorLane::nextElement(CommandVPRO& cmd) {
+    cmd.x++;
+    if (cmd.x > cmd.x_end) {
+        cmd.x = 0;
+        cmd.y++;
+        if (cmd.y > cmd.y_end) {
+            cmd.y = 0;
+            cmd.z++;
+            if (cmd.z > cmd.z_end) {
                 Statistics::get().getVPROStat()->addExecutedCmdQueue(
-                    current_cmd.get(), vector_lane_id);
-                current_cmd->done = true;
+                    &cmd, vector_unit->cluster_id, vector_lane_id);
+                cmd.done = true;
             }
         }
     }
 }
 
+int VectorLane::functional_sources(const CommandVPRO& cmd, VectorLane* sources[]) {
+    int n = 0;
+    // chained offsets (stage 3)
+    if (chains_from_src(cmd, SRC_SEL_INDIRECT_LS)) sources[n++] = &getLSLane();
+    if (chains_from_src(cmd, SRC_SEL_INDIRECT_NEIGHBOR)) sources[n++] = &getLeftNeighbor();
+    // chained data (stage 4)
+    if (is_src_chaining(cmd.src1)) sources[n++] = &get_lane_from_src(cmd.src1);
+    if (is_src_chaining(cmd.src2)) sources[n++] = &get_lane_from_src(cmd.src2);
+    return n;
+}
+
+bool VectorLane::isFunctionalReady() {
+    const CommandVPRO& cmd = functional_queue.front().cmd;
+    if (cmd.is_chain && !fifo._is_fillable()) return false;
+    functional_src_count = functional_sources(cmd, functional_src);
+    for (int i = 0; i < functional_src_count; i++) {
+        if (functional_src[i]->fifo._is_empty()) return false;
+    }
+    return true;
+}
+
+void VectorLane::executeFunctional() {
+    const CommandVPRO& cmd = functional_queue.front().cmd;
+    pipeObj->setPipelineALUDepth(int(cmd.pipelineALUDepth));
+    pipeObj->execute_element(*this, cmd);
+    regFile.update();
+}
+
+void VectorLane::commitFunctional() {
+    fifo.update();
+    for (int i = 0; i < functional_src_count; i++) {
+        functional_src[i]->fifo.update();
+    }
+    CommandVPRO& cmd = functional_queue.front().cmd;
+    nextElement(cmd);
+    if (cmd.done) functional_queue.pop_front();
+}
+
 /**
      * clock tick to process lanes command/pipeline
      */
@@ -190,26 +250,31 @@ void VectorLane::tick() {
     //*********************************************
 
     if (!adr_lane_stall && !src_lane_stall && !dst_lane_stall) {  // run all
-        Statistics::get().getVPROStat()->addExecutedCmdTick(current_cmd.get(), vector_lane_id);
+        Statistics::get().getVPROStat()->addExecutedCmdTick(
+            current_cmd, vector_unit->cluster_id, vector_lane_id);
         pipeObj->process(current_cmd);
         pipeObj->tick_pipeline(
             *this, 0, 5 + pipeObj->pipelineALUDepth + 1);  // execute ALL pipeline stages
     } else if (adr_lane_stall && !src_lane_stall && !dst_lane_stall) {  // run from stage 3
-        Statistics::get().getVPROStat()->addExecutedCmdTick(noneCmd.get(), vector_lane_id);
+        Statistics::get().getVPROStat()->addExecutedCmdTick(
+            &noneCmd, vector_unit->cluster_id, vector_lane_id);
         int from = chain_target_stage;
         pipeObj->processInStall(from);
         pipeObj->tick_pipeline(
             *this, from, 4 + pipeObj->pipelineALUDepth + 1);  // execute later pipeline stages
     } else if (src_lane_stall && !adr_lane_stall && !dst_lane_stall) {  // run from src if SRC wait
-        Statistics::get().getVPROStat()->addExecutedCmdTick(noneCmd.get(), vector_lane_id);
+        Statistics::get().getVPROStat()->addExecutedCmdTick(
+            &noneCmd, vector_unit->cluster_id, vector_lane_id);
         int from = chain_target_stage + 1;  // 3+1=4 the "fifth" pipeline stage
         pipeObj->processInStall(from);
         pipeObj->tick_pipeline(
             *this, from, 5 + pipeObj->pipelineALUDepth + 1);  // execute later pipeline stages
     } else if (src_lane_stall && dst_lane_stall) {            // run nothing if both stall
-        Statistics::get().getVPROStat()->addExecutedCmdTick(noneCmd.get(), vector_lane_id);
+        Statistics::get().getVPROStat()->addExecutedCmdTick(
+            &noneCmd, vector_unit->cluster_id, vector_lane_id);
     } else if (!src_lane_stall && dst_lane_stall) {  // run nothing if DST stall
-        Statistics::get().getVPROStat()->addExecutedCmdTick(noneCmd.get(), vector_lane_id);
+        Statistics::get().getVPROStat()->addExecutedCmdTick(
+            &noneCmd, vector_unit->cluster_id, vector_lane_id);
     }
 
     //*********************************************
@@ -249,8 +314,10 @@ void VectorLane::update() {
     }
 
     fetchCMD();
-    updateDebugMsg();
-    print_fifo();
+    if constexpr (INSTRUMENTED_BUILD) {
+        updateDebugMsg();
+        print_fifo();
+    }
     regFile.update();
     fifo.update();
 
@@ -264,6 +331,20 @@ void VectorLane::update() {
     blocking_nxt = false;
     lane_chaining_nxt = false;
     dst_lane_ready = false;
+
+    if (current_cmd->type == CommandVPRO::NONE && !blocking && !src_lane_stall &&
+        !dst_lane_stall && !adr_lane_stall && pipeObj->isEmpty()) {
+        if (idle_cycles <= idle_settle_cycles) idle_cycles++;
+    } else {
+        idle_cycles = 0;
+    }
+}
+
+void VectorLane::idleTick(uint64_t cycles) {
+    // an idle lane processes (and finishes) a NONE command each cycle
+    Statistics::get().getVPROStat()->addIdleTicks(
+        vector_unit->cluster_id, vector_lane_id, cycles);
+    clock_cycle += long(cycles);
 }
 
 bool VectorLane::is_src_chaining(addr_field_t src) const {
@@ -321,45 +402,69 @@ VectorLane& VectorLane::get_lane_from_src(addr_field_t src) {
      */
 std::tuple<word_t, bool, bool> VectorLane::get_operand(
     addr_field_t src, word_t x, word_t y, word_t z) {
-    word_t op_data = 0;
-    bool z_flag = false;
-    bool n_flag = false;
+    if (isLSLane() && (src.sel == SRC_SEL_NEIGHBOR || src.sel == SRC_SEL_LS)) {  // LS store data
+        VectorLane& src_lane = *vector_unit->getLanes()[src.gamma];
+        get_operand_debug_chaining_msg(src_lane);
+        return src_lane.fifo.pop();
+    }
+    return operandFetch(src.sel)(*this, src, x, y, z);
+}
 
-    switch (src.sel) {
+OperandFetch VectorLane::operandFetch(uint32_t sel) {
+    switch (sel) {
         case SRC_SEL_INDIRECT_LS:
         case SRC_SEL_INDIRECT_NEIGHBOR:
         case SRC_SEL_ADDR:
-            op_data =
-                regFile.get_rf_data(src.offset + src.alpha * x + src.beta * y + src.gamma * z);
-            z_flag =
-                regFile.get_rf_flag(src.offset + src.alpha * x + src.beta * y + src.gamma * z, 0);
-            n_flag =
-                regFile.get_rf_flag(src.offset + src.alpha * x + src.beta * y + src.gamma * z, 1);
-            break;
+            return fetch_rf;
         case SRC_SEL_IMM:
-            op_data = src.getImm();
-            if (uint8_t(op_data >> ISA_COMPLEX_LENGTH_3D) >
-                0)  // cannot happen. immediate is cut to ISA_COMPLEX_LENGTH_2D bit...
-                printf_warning(
-                    "using immediate as operand which is more than 24 bit! upper 8 bit got "
-                    "ignored!\n");
-            op_data = *__24to32signed(op_data);
-            break;
+            return fetch_imm;
         case SRC_SEL_NEIGHBOR:
+            return fetch_neighbor;
         case SRC_SEL_LS:
-            if (isLSLane()) {  // LS store data
-                get_operand_debug_chaining_msg(*vector_unit->getLanes()[src.gamma]);
-                std::tie(op_data, z_flag, n_flag) = vector_unit->getLanes()[src.gamma]->fifo.pop();
-            } else {  // processing lane
-                get_operand_debug_chaining_msg(get_lane_from_src(src));
-                std::tie(op_data, z_flag, n_flag) = get_lane_from_src(src).fifo.pop();
-            }
-            break;
+            return fetch_ls;
         default:
-            printf_error("VPRO_SIM ERROR: Invalid source selection! (src_sel=%d)\n", src.sel);
-            exit(1);
+            return fetch_invalid;
     }
-    return std::tie(op_data, z_flag, n_flag);
+}
+
+std::tuple<word_t, bool, bool> VectorLane::fetch_rf(
+    VectorLane& vl, const addr_field_t& src, word_t x, word_t y, word_t z) {
+    const auto addr = src.offset + src.alpha * x + src.beta * y + src.gamma * z;
+    const auto entry = vl.regFile.get_rf_word(addr);  // data + flags
+    return {entry & RegisterFile::Register::DATA_MASK,
+        (entry & RegisterFile::Register::ZERO_FLAG) != 0,
+        (entry & RegisterFile::Register::NEGATIVE_FLAG) != 0};
+}
+
+std::tuple<word_t, bool, bool> VectorLane::fetch_imm(
+    VectorLane&, const addr_field_t& src, word_t, word_t, word_t) {
+    word_t op_data = src.getImm();
+    if (uint8_t(op_data >> ISA_COMPLEX_LENGTH_3D) >
+        0)  // cannot happen. immediate is cut to ISA_COMPLEX_LENGTH_2D bit...
+        printf_warning(
+            "using immediate as operand which is more than 24 bit! upper 8 bit got "
+            "ignored!\n");
+    return {*__24to32signed(op_data), false, false};
+}
+
+std::tuple<word_t, bool, bool> VectorLane::fetch_neighbor(
+    VectorLane& vl, const addr_field_t&, word_t, word_t, word_t) {
+    VectorLane& src_lane = vl.getLeftNeighbor();
+    vl.get_operand_debug_chaining_msg(src_lane);
+    return src_lane.fifo.pop();
+}
+
+std::tuple<word_t, bool, bool> VectorLane::fetch_ls(
+    VectorLane& vl, const addr_field_t&, word_t, word_t, word_t) {
+    VectorLane& src_lane = vl.getLSLane();
+    vl.get_operand_debug_chaining_msg(src_lane);
+    return src_lane.fifo.pop();
+}
+
+std::tuple<word_t, bool, bool> VectorLane::fetch_invalid(
+    VectorLane&, const addr_field_t& src, word_t, word_t, word_t) {
+    printf_error("VPRO_SIM ERROR: Invalid source selection! (src_sel=%d)\n", src.sel);
+    exit(1);
 }
 
 void VectorLane::print_pipeline(const QString prefix) {
@@ -16,6 +16,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <deque>
 #include <memory>
 #include <string>
 #include <vector>
@@ -73,12 +74,26 @@ class VectorLane {
 
     virtual void dumpRegisterFile(std::string prefix = "");
 
-    std::shared_ptr<CommandVPRO> getCmd();
+    CommandVPRO* getCmd();
 
     bool isBusy() const;
 
     bool isBlocking() const;
 
+    /**
+     * lane is drained (no cmd, pipeline + fifo settled) for at least one complete pipeline pass.
+     * tick() + update() would then only count the cycle in the statistics
+     */
+    bool isIdle() const {
+        return idle_cycles > idle_settle_cycles;
+    }
+
+    /**
+     * replaces tick() + update() of an idle lane
+     * @param cycles number of skipped vpro clock cycles
+     */
+    void idleTick(uint64_t cycles = 1);
+
     VectorLane& getLeftNeighbor() const {
         return *left_lane;
     }
@@ -97,18 +112,13 @@ class VectorLane {
         ls_lane = ls;
     };
 
-    virtual uint8_t* getregister() {
+    /**
+     * packed register file entries: data + flags (see RegisterFile::Register)
+     */
+    virtual uint32_t* getregister() {
         return regFile.getregister();
     }
 
-    virtual bool* getzeroflag() {
-        return regFile.getzeroflag();
-    }
-
-    virtual bool* getnegativeflag() {
-        return regFile.getnegativeflag();
-    }
-
     bool is_src_chaining(addr_field_t src) const;
     bool is_indirect_addr(addr_field_t adr) const;
 
@@ -120,10 +130,59 @@ class VectorLane {
     void fetchCMD();
     void processCMD();
 
+    /**
+     * functional mode: append a command to this lanes queue
+     * @param seq issue number of the command in the unit (same for all selected lanes)
+     */
+    void issueFunctional(const CommandVPRO& cmd, uint64_t seq) {
+        functional_queue.push_back({cmd, seq});
+    }
+
+    [[nodiscard]] bool hasFunctionalCmd() const {
+        return !functional_queue.empty();
+    }
+
+    [[nodiscard]] const CommandVPRO& getFunctionalCmd() const {
+        return functional_queue.front().cmd;
+    }
+
+    [[nodiscard]] uint64_t getFunctionalSeq() const {
+        return functional_queue.front().seq;
+    }
+
+    /**
+     * functional mode: the current element of the front command can be executed
+     * (same conditions as the pipeline stalls: chain input fifos not empty, chain output fifo not full)
+     */
+    bool isFunctionalReady();
+
+    /**
+     * functional mode: executes the current element of the front command (all pipeline stages at once).
+     * fifo push / pop take effect in commitFunctional(), to execute the lanes of a command in lock step
+     */
+    void executeFunctional();
+
+    /**
+     * functional mode: updates the fifos accessed by executeFunctional() and steps to the next element
+     */
+    void commitFunctional();
+
     uint64_t* getAccu() {
         return &(pipeObj->accu);
     }
 
+    /**
+     * register file, accu and min/max registers of a drained lane (see ISS::checkpointSave)
+     */
+    void saveState(Checkpoint::Writer& w) const;
+    void restoreState(Checkpoint::Reader& r);
+
+    /**
+     * operand read of a processing lane for the source selection (resolved by CommandVPRO::decode(),
+     * the pipeline calls it instead of get_operand())
+     */
+    static OperandFetch operandFetch(uint32_t sel);
+
    protected:
     long clock_cycle;
 
@@ -131,9 +190,16 @@ class VectorLane {
     int consecutive_SRC_stall_counter;
     int consecutive_ADR_stall_counter;
 
+    // consecutive cycles without any command in this lane (see isIdle())
+    uint32_t idle_cycles{0};
+    static constexpr uint32_t idle_settle_cycles = 5 + CommandVPRO::MAX_ALU_DEPTH + 2;
+
     // reference to parent vector unit (needed for local mem and cmd queue acccess)
     VectorUnit* vector_unit;
-    std::shared_ptr<CommandVPRO> current_cmd, new_cmd, noneCmd;
+    // command buffers of this lane: copy of the fetched cmd, none cmd to delay on a pipeline length change, none cmd for stats
+    CommandVPRO fetched_cmd, delay_cmd, noneCmd;
+    // point to the buffers above (or to the none cmd of the unit)
+    CommandVPRO *current_cmd, *new_cmd;
 
     bool blocking, blocking_nxt;
 
@@ -161,6 +227,23 @@ class VectorLane {
     // in this stage, the chain input is read
     int chain_target_stage = 3;
 
+    // commands of the functional mode (front is processed)
+    struct FunctionalCmd {
+        CommandVPRO cmd;
+        uint64_t seq;
+    };
+    std::deque<FunctionalCmd> functional_queue;
+    // lanes whose fifo is read by the current functional element (see isFunctionalReady())
+    VectorLane* functional_src[4]{};
+    int functional_src_count{0};
+
+    /**
+     * lanes whose fifo is read by an element of cmd (chained data / offsets)
+     * @param sources filled with the lanes (max 4)
+     * @return number of lanes
+     */
+    virtual int functional_sources(const CommandVPRO& cmd, VectorLane* sources[]);
+
     // resolve address into data (3*8 bit = 24 bit datawidth)
     virtual std::tuple<uint32_t, bool, bool> get_operand(
         addr_field_t src, uint32_t x, uint32_t y, uint32_t z);
@@ -170,12 +253,27 @@ class VectorLane {
    private:
     bool additional_check();
 
+    // next x, y, z of cmd. sets done after the last element
+    void nextElement(CommandVPRO& cmd);
+
     void updateDebugMsg();
     void check_stall_conditions_msg(const int pipeline_src_read_stage);
     void check_stall_conditions_msg1() const;
     void check_stall_conditions_msg2(addr_field_t const& src);
     void get_operand_debug_chaining_msg(VectorLane const& src) const;
 
+    // operand fetchers (see operandFetch())
+    static std::tuple<uint32_t, bool, bool> fetch_rf(
+        VectorLane& vl, const addr_field_t& src, uint32_t x, uint32_t y, uint32_t z);
+    static std::tuple<uint32_t, bool, bool> fetch_imm(
+        VectorLane& vl, const addr_field_t& src, uint32_t x, uint32_t y, uint32_t z);
+    static std::tuple<uint32_t, bool, bool> fetch_neighbor(
+        VectorLane& vl, const addr_field_t& src, uint32_t x, uint32_t y, uint32_t z);
+    static std::tuple<uint32_t, bool, bool> fetch_ls(
+        VectorLane& vl, const addr_field_t& src, uint32_t x, uint32_t y, uint32_t z);
+    static std::tuple<uint32_t, bool, bool> fetch_invalid(
+        VectorLane& vl, const addr_field_t& src, uint32_t x, uint32_t y, uint32_t z);
+
     VectorLane* who();
     void whoami() const;
     void whoami(VectorLane const* v) const;
@@ -19,7 +19,7 @@ void VectorLane::updateDebugMsg() {
             printf("\tCMD: NONE \n");
         } else {
             printf("\tCMD: ");
-            print_cmd((*pipeObj)[0].cmd.get());
+            print_cmd((*pipeObj)[0].cmd);
         }
     }
     if (if_debug(DEBUG_PIPELINE) && additional_check()) {
@@ -414,29 +414,25 @@ void print_hex(uint32_t value, int char_cnt) {
  * Sim function to dump content of this lanes whole register file
  */
 void VectorLane::dumpRegisterFile(std::string prefix) {
-    auto rf_data = regFile.getregister();
-    auto rf_flag_0 = regFile.getzeroflag();
-    auto rf_flag_1 = regFile.getnegativeflag();
+    using RegisterFile::Register;
+    auto rf = regFile.getregister();
     printf("%s", prefix.c_str());
     printf("DUMP Register File (Vector Lane %i):\n", vector_lane_id);
     printf(LGREEN);
     int printLast = 0;
-    for (int r = 0; r < VPRO_CFG::RF_SIZE * 3; r += 16 * 3) {  // all elements in 16 element blocks
+    for (int r = 0; r < VPRO_CFG::RF_SIZE; r += 16) {  // all elements in 16 element blocks
         bool hasData = false;
-        for (int s = 0; s <= 15 * 3; s += 3) {  // each of the 16 blocks
-            auto data = ((uint32_t)(rf_data[r + s]) + (uint32_t)(rf_data[r + s + 1] << 8) +
-                         (uint32_t)(rf_data[r + s + 2] << 16));
-            hasData |= (data != 0);
+        for (int s = 0; s <= 15; s++) {  // each of the 16 blocks
+            hasData |= ((rf[r + s] & Register::DATA_MASK) != 0);
         }
         if (hasData) {
             printLast = std::min(printLast + 1, 1);
             printf(LGREEN);
             printf("%s", prefix.c_str());
-            uint address = (r / 3) & (~(16 - 1));
+            uint address = r & (~(16 - 1));
             printf("$%03x:  ", address);
-            for (int s = 0; s <= 15 * 3; s += 3) {  // each of the 16 blocks
-                auto data = ((uint32_t)(rf_data[r + s]) + (uint32_t)(rf_data[r + s + 1] << 8) +
-                             (uint32_t)(rf_data[r + s + 2] << 16));
+            for (int s = 0; s <= 15; s++) {  // each of the 16 blocks
+                auto data = rf[r + s] & Register::DATA_MASK;
                 if ((uint32_t(data >> 23u) & 1) == 1) data |= 0xFF000000;
 
                 if (data == 0) {
@@ -448,8 +444,8 @@ void VectorLane::dumpRegisterFile(std::string prefix) {
                     print_hex(data, 6);
                 }
                 if (if_debug(DEBUG_DUMP_FLAGS)) {
-                    auto neg = rf_flag_1[(r + s) / 3];
-                    auto zero = rf_flag_0[(r + s) / 3];
+                    auto neg = (rf[r + s] & Register::NEGATIVE_FLAG) != 0;
+                    auto zero = (rf[r + s] & Register::ZERO_FLAG) != 0;
                     printf("[%s%s]", neg ? "-" : "+", zero ? "z" : "d");
                 }
                 printf(" ");
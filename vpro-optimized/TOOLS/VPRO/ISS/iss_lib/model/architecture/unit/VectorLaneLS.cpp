@@ -23,21 +23,26 @@ VectorLaneLS::VectorLaneLS(VectorUnit* vector_unit,
     pipeObj = std::make_unique<LSPipeObject>(5 + CommandVPRO::MAX_ALU_DEPTH, 3);
 }
 
+int VectorLaneLS::functional_sources(const CommandVPRO& cmd, VectorLane* sources[]) {
+    int n = 0;
+    // chained offsets (stage 3)
+    if (chains_from_src(cmd, SRC_SEL_INDIRECT_LS_LANE0)) sources[n++] = &getLeftNeighbor();
+    if (chains_from_src(cmd, SRC_SEL_INDIRECT_LS_LANE1)) sources[n++] = &getRightNeighbor();
+    // store data of a processing lane (stage 4)
+    if (cmd.isWriteLM()) sources[n++] = vector_unit->getLanes()[cmd.dst.gamma].get();
+    // LS -> LS chain (stage 4)
+    if (cmd.dst.chain_ls && cmd.dst.chain_neighbor)
+        sources[n++] = &vector_unit->getLeftNeighbor()->getLSLane();
+    return n;
+}
+
 //***********************************************************//
 //                  Overload of Not Used Function            //
 //***********************************************************//
-uint8_t* VectorLaneLS::getregister() {
+uint32_t* VectorLaneLS::getregister() {
     printf_error("getregister on L/S LANE called! No RF exist!");
     return nullptr;
 }
-bool* VectorLaneLS::getzeroflag() {
-    printf_error("getzeroflag on L/S LANE called! No RF exist!");
-    return nullptr;
-}
-bool* VectorLaneLS::getnegativeflag() {
-    printf_error("getnegativeflag on L/S LANE called! No RF exist!");
-    return nullptr;
-}
 void VectorLaneLS::dumpRegisterFile(std::string prefix) {
     printf_error("dumpRegisterFile on L/S LANE called! No RF exist!");
 }
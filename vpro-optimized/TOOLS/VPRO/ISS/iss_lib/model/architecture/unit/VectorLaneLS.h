@@ -33,11 +33,12 @@ class VectorLaneLS : public VectorLane {
         return true;
     };
 
-    bool* getzeroflag() override;
-    bool* getnegativeflag() override;
-    uint8_t* getregister() override;
+    uint32_t* getregister() override;
 
     void dumpRegisterFile(std::string prefix) override;
+
+   protected:
+    int functional_sources(const CommandVPRO& cmd, VectorLane* sources[]) override;
 };
 
 }  // namespace Unit
@@ -4,7 +4,9 @@
 #include <QString>
 
 #include "../../../simulator/ISS.h"
+#include "../../../simulator/helper/checkpoint.h"
 #include "../../../simulator/helper/debugHelper.h"
+#include "../../../simulator/helper/trace.h"
 #include "../../../simulator/helper/typeConversion.h"
 #include "VectorUnit.h"
 
@@ -20,6 +22,8 @@ VectorUnit::VectorUnit(int id,
 
     // LM interpretated in 24-bit segments
     local_memory = new uint8_t[VPRO_CFG::LM_SIZE * (LOCAL_MEMORY_DATA_WIDTH / 8)]();
+    // RFs of all regular lanes in one block (lane by lane, packed entries see RegisterFile::Register)
+    register_files = new uint32_t[VPRO_CFG::LANES * VPRO_CFG::RF_SIZE]();
 
     // create regular Lanes
     for (int i = 0; i < VPRO_CFG::LANES; i++) {
@@ -41,7 +45,6 @@ VectorUnit::VectorUnit(int id,
     // init commands
     cmd_queue = std::deque<std::shared_ptr<CommandVPRO>>();
     clearCommands();
-    noneCmd = std::make_shared<CommandVPRO>();
 
     cmdQueueFetchedCmd = false;
 };
@@ -70,25 +73,68 @@ bool VectorUnit::trySendCMD(const std::shared_ptr<CommandVPRO>& cmd) {
         return false;
     }
 
+    cmd->decode();
     cmd_queue.push_back(cmd);
 
     return true;
 }
 
+void VectorUnit::issueFunctional(const CommandVPRO& cmd) {
+    if (cmd.type == CommandVPRO::NONE) return;
+    for (auto& lane : lanes) {
+        if (isLaneSelected(&cmd, lane->vector_lane_id)) {
+            lane->issueFunctional(cmd, functional_seq);
+        }
+    }
+    functional_seq++;
+}
+
+bool VectorUnit::runFunctional() {
+    bool progress = false;
+    VectorLane* group[VPRO_CFG::LANES + 1];
+    for (auto& lane : lanes) {
+        while (lane->hasFunctionalCmd()) {
+            // all lanes of this command need it in front (and their chain fifos ready)
+            const CommandVPRO& cmd = lane->getFunctionalCmd();
+            const uint64_t seq = lane->getFunctionalSeq();
+            int group_size = 0;
+            bool ready = true;
+            for (auto& l : lanes) {
+                if (!isLaneSelected(&cmd, l->vector_lane_id)) continue;
+                if (!l->hasFunctionalCmd() || l->getFunctionalSeq() != seq || !l->isFunctionalReady()) {
+                    ready = false;
+                    break;
+                }
+                group[group_size++] = l.get();
+            }
+            if (!ready) break;
+
+            for (int i = 0; i < group_size; i++) {
+                group[i]->executeFunctional();
+            }
+            for (int i = 0; i < group_size; i++) {
+                group[i]->commitFunctional();
+            }
+            progress = true;
+        }
+    }
+    return progress;
+}
+
 void VectorUnit::clearCommands() {
     cmd_queue.clear();
 }
 
 void VectorUnit::tick() {
     // cascade
-    for (auto lane : lanes) {
+    for (auto& lane : lanes) {
         lane->tick();
     }
 }
 
 void VectorUnit::update() {
     cmdQueueFetchedCmd = false;  // enable fetch of one new command in this cycle
-    for (auto lane : lanes) {
+    for (auto& lane : lanes) {
         lane->update();
     }
 }
@@ -98,20 +144,20 @@ void VectorUnit::update() {
  * @param id Lane
  * @return
  */
-std::shared_ptr<CommandVPRO> VectorUnit::getNextCommandForLane(int id) {
+CommandVPRO* VectorUnit::getNextCommandForLane(int id, CommandVPRO* buffer) {
     if (cmdQueueFetchedCmd) {  // FIFO can only fetch front cmd
-        return noneCmd;
+        return &noneCmd;
     }
 
     if (cmd_queue.empty()) {
-        return noneCmd;
+        return &noneCmd;
     }
 
-    for (auto lane : lanes) {
-        if (lane->isBlocking()) return noneCmd;
+    for (auto& lane : lanes) {
+        if (lane->isBlocking()) return &noneCmd;
     }
 
-    auto cmd = cmd_queue.front();
+    auto& cmd = cmd_queue.front();
     if (isLaneSelected(cmd.get(), id)) {
         // Check minimal vector length + print warning
         if (checkVectorPipelineLength && cmd->fu_sel != CLASS_OTHER && cmd->x == cmd->x_end &&
@@ -127,23 +173,22 @@ std::shared_ptr<CommandVPRO> VectorUnit::getNextCommandForLane(int id) {
             }
         }
 
-        cmd_queue.front()->id_mask &= ~(1u << uint(id));
+        cmd->id_mask &= ~(1u << uint(id));
         // unset the mask bit for this unit so this command dont get assigned to it again
-        if (cmd_queue.front()->id_mask == 0) {
+        *buffer = *cmd;
+        if (cmd->id_mask == 0) {
             // if assigned to all lanes it should be poped from queue
             cmd_queue.pop_front();
             cmdQueueFetchedCmd = true;
-            cmd->id_mask |= (1u << uint(id));
-            return cmd;
-        } else {
-            return std::make_shared<CommandVPRO>(cmd.get());
+            buffer->id_mask |= (1u << uint(id));
         }
+        return buffer;
     }
 
-    return noneCmd;
+    return &noneCmd;
 }
 
-uint32_t VectorUnit::getLocalMemoryData(const uint32_t addr, const int size) {
+uint32_t VectorUnit::getLocalMemoryDataChecked(const uint32_t addr, const int size) {
     if (addr * (LOCAL_MEMORY_DATA_WIDTH / 8) + size >
         VPRO_CFG::LM_SIZE * (LOCAL_MEMORY_DATA_WIDTH / 8)) {
         printf_error("Read from Local Memory out of Range! (addr: %d, size: %d)\n", addr, size);
@@ -155,7 +200,8 @@ uint32_t VectorUnit::getLocalMemoryData(const uint32_t addr, const int size) {
     return uint32_t(*((uint16_t*)&local_memory[addr * 2]));
 }
 
-void VectorUnit::writeLocalMemoryData(const uint32_t addr, const uint32_t data, const int size) {
+void VectorUnit::writeLocalMemoryDataChecked(
+    const uint32_t addr, const uint32_t data, const int size) {
     if (addr + (LOCAL_MEMORY_DATA_WIDTH / 8) > VPRO_CFG::LM_SIZE * (LOCAL_MEMORY_DATA_WIDTH / 8)) {
         printf_error("Write to Local Memory out of Range! (addr: %d)\n", addr);
         return;
@@ -165,6 +211,8 @@ void VectorUnit::writeLocalMemoryData(const uint32_t addr, const uint32_t data,
             "Write to Local Memory more than LM DATA WIDTH (%i)\n", (LOCAL_MEMORY_DATA_WIDTH / 8));
     }
 
+    if constexpr (lm_generate_trace) traceWrite(addr, data);
+
     for (uint i = 0; i < size; i++) {
         local_memory[addr * (LOCAL_MEMORY_DATA_WIDTH / 8) + i] = uint8_t(data >> (i * 8));
     }
@@ -182,19 +230,59 @@ void VectorUnit::writeLocalMemoryData(const uint32_t& addr, const uint8_t* data,
             "Write to Local Memory more than LM DATA WIDTH (%i)\n", (LOCAL_MEMORY_DATA_WIDTH / 8));
     }
 
+    if constexpr (lm_generate_trace) {
+        uint32_t word = 0;
+        for (int i = 0; i < size; i++) word |= uint32_t(data[i]) << (i * 8);
+        traceWrite(addr, word);
+    }
+
     for (uint i = 0; i < size; i++) {
         local_memory[addr * (LOCAL_MEMORY_DATA_WIDTH / 8) + i] = data[i];
     }
 }
 
+void VectorUnit::traceWrite(uint32_t addr, uint32_t data) {
+    Trace::Writer::get().record(
+        Trace::LM_WRITE, cluster_id, vector_unit_id, Trace::NONE, addr, 0, data & 0xffff);
+}
+
+void VectorUnit::saveState(Checkpoint::Writer& w) {
+    w.data(local_memory, VPRO_CFG::LM_SIZE * (LOCAL_MEMORY_DATA_WIDTH / 8));
+    for (auto& lane : lanes) {
+        lane->saveState(w);
+    }
+}
+
+void VectorUnit::restoreState(Checkpoint::Reader& r) {
+    r.data(local_memory, VPRO_CFG::LM_SIZE * (LOCAL_MEMORY_DATA_WIDTH / 8));
+    for (auto& lane : lanes) {
+        lane->restoreState(r);
+    }
+}
+
 bool VectorUnit::isBusy() {
     bool lanes_busy = !cmd_queue.empty();
-    for (auto lane : lanes) {
+    for (auto& lane : lanes) {
         lanes_busy = lanes_busy || lane->isBusy();
     }
     return lanes_busy;
 }
 
+bool VectorUnit::isIdle() {
+    if (!cmd_queue.empty()) return false;
+    for (auto& lane : lanes) {
+        if (!lane->isIdle()) return false;
+    }
+    return true;
+}
+
+void VectorUnit::idleTick(uint64_t cycles) {
+    cmdQueueFetchedCmd = false;
+    for (auto& lane : lanes) {
+        lane->idleTick(cycles);
+    }
+}
+
 // ***********************************************************************
 // Dump local memory to console
 // ***********************************************************************
@@ -68,21 +68,82 @@ class VectorUnit : public IVectorUnit {
         return *ls_lane;
     };
 
-    uint32_t getLocalMemoryData(uint32_t addr, int size = 2);
-    void writeLocalMemoryData(uint32_t addr, uint32_t data, int size = 2);
+    /**
+     * LM access of 16-bit words. Range checked in debug builds (see CHECKED_MEMORY_ACCESS)
+     */
+    uint32_t getLocalMemoryData(uint32_t addr, int size = 2) {
+        if constexpr (CHECKED_MEMORY_ACCESS) {
+            return getLocalMemoryDataChecked(addr, size);
+        } else {
+            return getLocalMemoryDataUnchecked(addr);
+        }
+    }
+    void writeLocalMemoryData(uint32_t addr, uint32_t data, int size = 2) {
+        if constexpr (CHECKED_MEMORY_ACCESS) {
+            writeLocalMemoryDataChecked(addr, data, size);  // traced after the range check
+        } else {
+            if constexpr (lm_generate_trace) traceWrite(addr, data);
+            writeLocalMemoryDataUnchecked(addr, data);
+        }
+    }
+
+    [[nodiscard]] uint32_t getLocalMemoryDataUnchecked(uint32_t addr) const {
+        uint16_t data;
+        memcpy(&data, &local_memory[addr * (LOCAL_MEMORY_DATA_WIDTH / 8)], sizeof(data));
+        return data;
+    }
+    void writeLocalMemoryDataUnchecked(uint32_t addr, uint32_t data) {
+        auto d = uint16_t(data);
+        memcpy(&local_memory[addr * (LOCAL_MEMORY_DATA_WIDTH / 8)], &d, sizeof(d));
+    }
+
+    uint32_t getLocalMemoryDataChecked(uint32_t addr, int size = 2);
+    void writeLocalMemoryDataChecked(uint32_t addr, uint32_t data, int size = 2);
     void writeLocalMemoryData(const uint32_t& addr, const uint8_t* data, int size = 2);
 
     bool trySendCMD(const std::shared_ptr<CommandVPRO>& cmd);
 
+    /**
+     * functional mode: the (decoded) command is appended to the queues of the selected lanes
+     */
+    void issueFunctional(const CommandVPRO& cmd);
+
+    /**
+     * functional mode: executes elements of the lanes queued commands until all lanes are done or
+     * wait for chaining data. The lanes of a command run in lock step (as in the pipelines)
+     * @return whether any element got executed
+     */
+    bool runFunctional();
+
     void clearCommands();
 
+    void saveState(Checkpoint::Writer& w);
+    void restoreState(Checkpoint::Reader& r);
+
     void dumpLocalMemory(const std::string& prefix = "");
     void dumpRegisterFile(uint32_t lane);
     void dumpQueue();
 
     bool isBusy();
 
-    std::shared_ptr<CommandVPRO> getNextCommandForLane(int id);
+    /**
+     * no cmd in queue and all lanes idle (see VectorLane::isIdle)
+     */
+    bool isIdle();
+
+    /**
+     * replaces tick() + update() of an idle unit
+     * @param cycles number of skipped vpro clock cycles
+     */
+    void idleTick(uint64_t cycles = 1);
+
+    /**
+     * next command for the lane (front of the cmd queue, if selected) is copied into the lanes buffer
+     * @param id lane id
+     * @param buffer lanes command storage
+     * @return buffer or the units none cmd
+     */
+    CommandVPRO* getNextCommandForLane(int id, CommandVPRO* buffer);
 
     std::vector<std::shared_ptr<VectorLane>>& getLanes() {
         return lanes;
@@ -91,6 +152,14 @@ class VectorUnit : public IVectorUnit {
     bool isLaneSelected(CommandVPRO const* cmd, long lane_id) const;
 
     bool isCmdQueueFull();
+    /**
+     * storage of the register file of a regular lane (nullptr for the L/S lane)
+     */
+    uint32_t* getRegisterFileStorage(int lane_id) {
+        if (lane_id < 0 || lane_id >= VPRO_CFG::LANES) return nullptr;
+        return &register_files[lane_id * VPRO_CFG::RF_SIZE];
+    }
+
     uint8_t* getLocalMemoryPtr() {
         return local_memory;
     }
@@ -115,12 +184,20 @@ class VectorUnit : public IVectorUnit {
     double& time;
 
     uint8_t* local_memory;  // each unit has a local_memory, the lanes can access
+    uint32_t* register_files;  // register files of the regular lanes (LANES x RF_SIZE)
 
     // returned if cmd queue is empty (or similar...)
-    std::shared_ptr<CommandVPRO> noneCmd;
+    CommandVPRO noneCmd;
 
     //flag to indicate a command was pulled from cmd queue. in hw only once per cycle a cmd is received from queue...
     bool cmdQueueFetchedCmd;
+
+    // issue number of the functional mode commands (identifies the lanes of a command)
+    uint64_t functional_seq{0};
+
+    static constexpr bool lm_generate_trace = GENERATE_LM_TRACE;
+
+    void traceWrite(uint32_t addr, uint32_t data);
 };
 
 }  // namespace Unit
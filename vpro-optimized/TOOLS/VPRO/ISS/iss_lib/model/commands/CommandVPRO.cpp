@@ -8,6 +8,7 @@
 
 #include "CommandVPRO.h"
 #include "../../simulator/helper/debugHelper.h"
+#include "../architecture/unit/VectorLane.h"
 
 #include <iomanip>
 #include <sstream>
@@ -58,8 +59,9 @@ CommandVPRO::CommandVPRO(CommandVPRO* ref) : CommandBase(ref->class_type) {
     z = ref->z;
     done = ref->done;
     pipelineALUDepth = ref->pipelineALUDepth;
+    decoded = ref->decoded;
 }
-CommandVPRO::CommandVPRO(CommandVPRO& ref) : CommandBase(ref.class_type) {
+CommandVPRO::CommandVPRO(const CommandVPRO& ref) : CommandBase(ref.class_type) {
     type = ref.type;
     id_mask = ref.id_mask;
     cluster = ref.cluster;
@@ -81,6 +83,7 @@ CommandVPRO::CommandVPRO(CommandVPRO& ref) : CommandBase(ref.class_type) {
     z = ref.z;
     done = ref.done;
     pipelineALUDepth = ref.pipelineALUDepth;
+    decoded = ref.decoded;
 }
 CommandVPRO::CommandVPRO(std::shared_ptr<CommandVPRO> ref) : CommandBase(ref->class_type) {
     type = ref->type;
@@ -104,6 +107,7 @@ CommandVPRO::CommandVPRO(std::shared_ptr<CommandVPRO> ref) : CommandBase(ref->cl
     z = ref->z;
     done = ref->done;
     pipelineALUDepth = ref->pipelineALUDepth;
+    decoded = ref->decoded;
 }
 
 void CommandVPRO::printType(CommandVPRO::TYPE t, FILE* out) {
@@ -132,6 +136,73 @@ bool CommandVPRO::isWriteRF() {
             type == MULH_NEG || type == MULH_POS || type == MIN || type == MAX || type == ABS ||
             type == MIN_VECTOR || type == MAX_VECTOR || type == BIT_REVERSAL);
 }
+void CommandVPRO::decode() {
+    decoded = Decoded();
+    decoded.write_rf = isWriteRF();
+    switch (type) {
+        case MACL:
+        case MACH:
+            decoded.mac = true;
+            decoded.mul_operand = true;
+            break;
+        case MACL_PRE:
+        case MACH_PRE:
+            decoded.mac_pre = true;
+            decoded.mul_operand = true;
+            break;
+        case MULL:
+        case MULH:
+            decoded.mul_operand = true;
+            break;
+        case MULL_NEG:
+        case MULH_NEG:
+            decoded.mul_operand = true;
+            decoded.conditional = true;
+            decoded.move = MOVE_NEGATIVE;
+            break;
+        case MULL_POS:
+        case MULH_POS:
+            decoded.mul_operand = true;
+            decoded.conditional = true;
+            decoded.move = MOVE_NON_NEGATIVE;
+            break;
+        case SHIFT_AR_NEG:
+            decoded.conditional = true;
+            decoded.move = MOVE_NEGATIVE;
+            break;
+        case SHIFT_AR_POS:
+            decoded.conditional = true;
+            decoded.move = MOVE_NON_NEGATIVE;
+            break;
+        case MV_ZE:
+            decoded.move = MOVE_ZERO;
+            break;
+        case MV_NZ:
+            decoded.move = MOVE_NON_ZERO;
+            break;
+        case MV_MI:
+            decoded.move = MOVE_NEGATIVE;
+            break;
+        case MV_PL:
+            decoded.move = MOVE_NON_NEGATIVE;
+            break;
+        case MIN_VECTOR:
+        case MAX_VECTOR:
+            decoded.minmax_vector = true;
+            break;
+        default:
+            break;
+    }
+    auto is_indirect = [](uint32_t sel) {
+        return sel == SRC_SEL_INDIRECT_LS || sel == SRC_SEL_INDIRECT_NEIGHBOR ||
+               sel == SRC_SEL_INDIRECT_LS_LANE0 || sel == SRC_SEL_INDIRECT_LS_LANE1;
+    };
+    decoded.indirect = is_indirect(src1.sel) || is_indirect(src2.sel) || is_indirect(dst.sel);
+    decoded.alu = Unit::PipeObject::aluKernel(type);
+    decoded.src1 = Unit::VectorLane::operandFetch(src1.sel);
+    decoded.src2 = Unit::VectorLane::operandFetch(src2.sel);
+}
+
 bool CommandVPRO::isWriteLM() const {
     return (type == STORE || type == STORE_SHIFT_LEFT || type == STORE_SHIFT_RIGHT ||
             type == STORE_REVERSE);
@@ -12,11 +12,25 @@
 
 #include <QString>
 #include <memory>
+#include <tuple>
 
 #include "../../simulator/helper/structTypes.h"
 #include "CommandBase.h"
 #include "vpro/vpro_cmd_defs.h"
 
+namespace Unit {
+class PipeObject;
+class VectorLane;
+struct PipelineDate;
+
+// ALU operation of a command type (see PipeObject::aluKernel())
+using AluKernel = void (*)(PipeObject& pipeline, VectorLane& vl, PipelineDate& pipe);
+
+// operand read (data, zero flag, negative flag) of a source selection (see VectorLane::operandFetch())
+using OperandFetch = std::tuple<uint32_t, bool, bool> (*)(
+    VectorLane& vl, const addr_field_t& src, uint32_t x, uint32_t y, uint32_t z);
+}  // namespace Unit
+
 class CommandVPRO : public CommandBase {
    public:
     static const int MAX_ALU_DEPTH = 16;
@@ -103,9 +117,35 @@ class CommandVPRO : public CommandBase {
 
     bool done;
 
+    // condition on the flags of src1 for the result to be written (MV_*, *_NEG, *_POS)
+    enum MOVE_CONDITION : uint8_t {
+        MOVE_ALWAYS,
+        MOVE_ZERO,
+        MOVE_NON_ZERO,
+        MOVE_NEGATIVE,
+        MOVE_NON_NEGATIVE
+    };
+
+    /**
+     * type dependent properties for the lane pipeline.
+     * resolved once per command by decode() instead of comparing the type for each vector element
+     */
+    struct Decoded {
+        bool write_rf{false};       // isWriteRF()
+        bool mul_operand{false};    // MUL* / MAC*: OPB is cut to 18-bit
+        bool mac{false};            // MACL / MACH: accu reset + init by aux registers
+        bool mac_pre{false};        // MACL_PRE / MACH_PRE: accu reset on first element
+        bool conditional{false};    // *_NEG / *_POS: result is OPA if the condition fails
+        bool minmax_vector{false};  // MIN_VECTOR / MAX_VECTOR
+        bool indirect{false};       // an operand selects SRC_SEL_INDIRECT_* (chained offsets)
+        MOVE_CONDITION move{MOVE_ALWAYS};
+        Unit::AluKernel alu{nullptr};  // by type
+        Unit::OperandFetch src1{nullptr}, src2{nullptr};  // by src1.sel / src2.sel (processing lane)
+    } decoded;
+
     CommandVPRO();
     CommandVPRO(CommandVPRO* ref);
-    CommandVPRO(CommandVPRO& ref);
+    CommandVPRO(const CommandVPRO& ref);
     CommandVPRO(std::shared_ptr<CommandVPRO> ref);
 
     /**
@@ -113,6 +153,11 @@ class CommandVPRO : public CommandBase {
      */
     void updateType();
 
+    /**
+     * update 'decoded' based on 'type' (when the command is pushed to a units queue)
+     */
+    void decode();
+
     void print(FILE* out = stdout) override;
     void print_type(FILE* out = stdout) const;
     void print_cmd_issue_string(FILE* out = stdout, const char *prefix = "") const;
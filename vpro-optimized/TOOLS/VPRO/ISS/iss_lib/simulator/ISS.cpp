@@ -13,6 +13,7 @@
 
 #include <math.h>
 #include <bitset>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <vector>
@@ -23,7 +24,9 @@
 #include "../model/architecture/DMALooper.h"
 #include "../model/architecture/stats/Statistics.h"
 #include "ISS.h"
+#include "helper/checkpoint.h"
 #include "helper/debugHelper.h"
+#include "helper/trace.h"
 
 struct Dmacmd {
     uint32_t data[11];
@@ -122,7 +125,9 @@ void ISS::run_vpro_instruction(const std::shared_ptr<CommandVPRO>& command) {
 
     for (auto cluster : clusters) {
         if (((1u << cluster->cluster_id) & architecture_state->cluster_mask_global) > 0) {
-            if (!cluster->sendCMD(std::dynamic_pointer_cast<CommandBase>(command))) {
+            if (functional_mode) {
+                cluster->executeFunctional(command);
+            } else if (!cluster->sendCMD(std::dynamic_pointer_cast<CommandBase>(command))) {
                 printf_warning("Cluster did not receive this command... Queue full?");
                 command->print();
             }
@@ -136,6 +141,21 @@ void ISS::run_vpro_instruction(const std::shared_ptr<CommandVPRO>& command) {
         }
     }
 
+    if (GENERATE_CMD_TRACE) {
+        // encoding as gen_vpro_struct, see Trace::VPRO_CMD
+        Trace::Writer::get().record(Trace::VPRO_CMD,
+            Trace::NONE,
+            Trace::NONE,
+            Trace::NONE,
+            (command->get_func_type() & 0xffff) | (command->id_mask & 0xff) << 16 |
+                uint32_t(command->blocking) << 24 | uint32_t(command->is_chain) << 25 |
+                uint32_t(command->flag_update) << 26,
+            command->dst.create_IMM() | uint64_t(command->src1.create_IMM()) << 32,
+            command->src2.create_IMM(command->get_src2_off()) |
+                uint64_t(command->x_end & 0x3ff) << 32 | uint64_t(command->y_end & 0x3ff) << 42 |
+                uint64_t(command->z_end & 0x3ff) << 52);
+    }
+
     if (CREATE_CMD_HISTORY_FILE) {
         QString cmd_description =
             "VPRO " + command->get_type().leftJustified(17, ' ') + ", id " +
@@ -166,7 +186,10 @@ void ISS::run_dma_instruction(const std::shared_ptr<CommandDMA>& command, bool s
         if (((command->cluster_mask >> cluster->cluster_id) & 0b1) == 1) {
             // create a copy for each cluster (dma)
             auto cmd = std::make_shared<CommandDMA>(command.get());
-            cluster->sendCMD(std::dynamic_pointer_cast<CommandBase>(cmd));
+            if (functional_mode)
+                cluster->executeFunctional(cmd);
+            else
+                cluster->sendCMD(std::dynamic_pointer_cast<CommandBase>(cmd));
         }
     }
 
@@ -207,6 +230,238 @@ void ISS::gen_direct_dma_instruction(const uint8_t dcache_data_struct[32]) {
     dmalooper->new_dcache_input(dcache_data_struct);
 }
 
+void ISS::setFunctionalMode(bool functional) {
+    if (functional == functional_mode) return;
+#ifndef ISS_STANDALONE
+    printf_error("[Functional] Only available in the standalone ISS (direct main memory access)!\n");
+#else
+    if (functional) {
+        // finish timed commands. functional dma accesses the main memory directly -> no (dirty) lines in the DCMA
+        while (!isIdle()) {
+            runUntilRiscReadyForCmd();
+        }
+        dcma->flush();
+        while (dcma->isBusy()) {
+            runUntilRiscReadyForCmd();
+        }
+        dcma->reset();
+    } else {
+        checkFunctionalDeadlock();
+    }
+    functional_mode = functional;
+    printf_info("[Functional] %s mode\n", functional ? "Functional (untimed)" : "Timed");
+#endif
+}
+
+void ISS::checkFunctionalDeadlock(uint32_t cluster_mask) {
+    for (auto cluster : clusters) {
+        if (((cluster_mask >> cluster->cluster_id) & 0x1) == 0) continue;
+        for (auto unit : cluster->getUnits()) {
+            if (unit->isBusy()) {
+                printf_error(
+                    "[Functional] Sync, but lanes of Cluster %i Unit %i wait for chaining data of a "
+                    "command not issued (deadlock)!\n",
+                    cluster->cluster_id,
+                    unit->id());
+                sim_stop(false, 1);
+                exit(1);
+            }
+        }
+    }
+}
+
+bool ISS::checkpointSave(const char* file_name) {
+#ifdef ISS_STANDALONE
+    while (!isIdle()) {
+        runUntilRiscReadyForCmd();
+    }
+#else
+    if (!isIdle()) {
+        printf_error("[Checkpoint] Save requires an idle ISS (no command / transfer in flight)!\n");
+        return false;
+    }
+#endif
+    if (functional_mode) checkFunctionalDeadlock();
+
+    Checkpoint::Writer w;
+    if (!w.open(file_name)) return false;
+
+    Checkpoint::Header header{};
+    memcpy(header.magic, Checkpoint::MAGIC, sizeof(header.magic));
+    header.version = Checkpoint::VERSION;
+    header.clusters = VPRO_CFG::CLUSTERS;
+    header.units = VPRO_CFG::UNITS;
+    header.lanes = VPRO_CFG::LANES;
+    header.lm_size = VPRO_CFG::LM_SIZE;
+    header.rf_size = VPRO_CFG::RF_SIZE;
+#ifdef ISS_STANDALONE
+    header.mm_size = reinterpret_cast<NonBlockingMainMemory*>(bus)->getMemByteSize();
+#endif
+    header.time = time;
+    w.section("HEADER");
+    w.value(header);
+
+    w.section("ISS");
+    w.value(time);
+    w.value(risc_time);
+    w.value(axi_time);
+    w.value(dcma_time);
+    w.value(aux_cnt_lane_act);
+    w.value(aux_cnt_dma_act);
+    w.value(aux_cnt_both_act);
+    w.value(aux_cnt_vpro_total);
+    w.value(aux_cnt_riscv_total);
+    w.value(aux_cnt_riscv_enabled);
+    w.value(aux_sys_time);
+    w.value(aux_cycle_counter);
+    w.value(io_vpro_cmd_register);
+    w.value(io_dma_cmd_register);
+    w.value(dma_access_counter_cluster_pointer);
+    w.data(general_purpose_register, 0xff / 4 * sizeof(uint32_t));
+    w.value(*architecture_state);
+
+    for (auto cluster : clusters) {
+        w.section("CLUSTER");
+        cluster->saveState(w);
+    }
+    w.section("DCMA");
+    dcma->saveState(w);
+#ifdef ISS_STANDALONE
+    w.section("MAINMEM");
+    reinterpret_cast<NonBlockingMainMemory*>(bus)->saveState(w);
+#endif
+    w.section("STATS");
+    Statistics::get().saveState(w);
+    w.section("APP");
+    w.value(checkpoint_layers_done);
+    w.value(checkpoint_app_data);
+    w.section("END");
+
+    bool ok = w.close();
+    if (ok)
+        printf_info("[Checkpoint] Saved to %s (Time: %.2lf ns, Layers done: %u)\n",
+            file_name,
+            time,
+            checkpoint_layers_done);
+    return ok;
+}
+
+bool ISS::checkpointRestore(const char* file_name) {
+    // at the end of sim_init nothing was ticked yet (the lanes did not settle to isIdle())
+    if (isCompletelyInitialized && !isIdle()) {
+        printf_error("[Checkpoint] Restore requires an idle ISS (no command / transfer in flight)!\n");
+        return false;
+    }
+
+    Checkpoint::Reader r;
+    if (!r.open(file_name)) return false;
+
+    Checkpoint::Header header{};
+    if (r.section("HEADER")) r.value(header);
+    uint64_t mm_size = 0;
+#ifdef ISS_STANDALONE
+    mm_size = reinterpret_cast<NonBlockingMainMemory*>(bus)->getMemByteSize();
+#endif
+    if (memcmp(header.magic, Checkpoint::MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != Checkpoint::VERSION) {
+        r.fail("no checkpoint file or version differs");
+    } else if (header.clusters != VPRO_CFG::CLUSTERS || header.units != VPRO_CFG::UNITS ||
+               header.lanes != VPRO_CFG::LANES || header.lm_size != VPRO_CFG::LM_SIZE ||
+               header.rf_size != VPRO_CFG::RF_SIZE || header.mm_size != mm_size) {
+        printf_error("[Checkpoint] File: %uC%uU%uL (LM: %u, RF: %u, MM: %" PRIu64
+                     "), ISS: %uC%uU%uL (LM: %u, RF: %u, MM: %" PRIu64 ")\n",
+            header.clusters,
+            header.units,
+            header.lanes,
+            header.lm_size,
+            header.rf_size,
+            header.mm_size,
+            VPRO_CFG::CLUSTERS,
+            VPRO_CFG::UNITS,
+            VPRO_CFG::LANES,
+            VPRO_CFG::LM_SIZE,
+            VPRO_CFG::RF_SIZE,
+            mm_size);
+        r.fail("architecture configuration differs");
+    }
+    if (!r.ok()) return false;
+
+    r.section("ISS");
+    r.value(time);
+    r.value(risc_time);
+    r.value(axi_time);
+    r.value(dcma_time);
+    r.value(aux_cnt_lane_act);
+    r.value(aux_cnt_dma_act);
+    r.value(aux_cnt_both_act);
+    r.value(aux_cnt_vpro_total);
+    r.value(aux_cnt_riscv_total);
+    r.value(aux_cnt_riscv_enabled);
+    r.value(aux_sys_time);
+    r.value(aux_cycle_counter);
+    r.value(io_vpro_cmd_register);
+    r.value(io_dma_cmd_register);
+    r.value(dma_access_counter_cluster_pointer);
+    r.data(general_purpose_register, 0xff / 4 * sizeof(uint32_t));
+    r.value(*architecture_state);
+
+    for (auto cluster : clusters) {
+        if (!r.section("CLUSTER")) break;
+        cluster->restoreState(r);
+    }
+    if (r.section("DCMA")) dcma->restoreState(r);
+#ifdef ISS_STANDALONE
+    if (r.section("MAINMEM")) reinterpret_cast<NonBlockingMainMemory*>(bus)->restoreState(r);
+#endif
+    if (r.section("STATS")) Statistics::get().restoreState(r);
+    if (r.section("APP")) {
+        r.value(checkpoint_layers_done);
+        r.value(checkpoint_app_data);
+    }
+    r.section("END");
+
+    if (!r.ok()) {
+        printf_error(
+            "[Checkpoint] Restore of %s failed, the architecture state is undefined!\n", file_name);
+        return false;
+    }
+    printf_info("[Checkpoint] Restored from %s (Time: %.2lf ns, Layers done: %u)\n",
+        file_name,
+        time,
+        checkpoint_layers_done);
+    checkpoint_resume = true;
+    return true;
+}
+
+void ISS::checkpointLayer(uint32_t layers_done, uint64_t app_data) {
+    checkpoint_layers_done = layers_done;
+    checkpoint_app_data = app_data;
+    if (checkpoint_layer < 0 || uint32_t(checkpoint_layer) != layers_done ||
+        checkpoint_save_file.isEmpty())
+        return;
+    auto file = checkpoint_save_file.toStdString();
+    checkpoint_save_file.clear();  // not again at sim_stop
+    checkpointSave(file.c_str());
+}
+
+uint32_t ISS::checkpointResume(uint64_t* app_data) {
+    if (!checkpoint_resume) return 0;
+    // the host program repeated its setup since sim_init (io accesses, time): restore again to
+    // continue with the exact state of the layer boundary
+#ifdef ISS_STANDALONE
+    while (!isIdle()) {
+        runUntilRiscReadyForCmd();
+    }
+#endif
+    if (!checkpointRestore(checkpoint_restore_file.toStdString().c_str())) {
+        QCoreApplication::quit();  // the GUI thread waits in exec() (see sim_stop)
+        std::exit(EXIT_FAILURE);   // (exit() is the signal of the ISS)
+    }
+    checkpoint_resume = false;
+    if (app_data != nullptr) *app_data = checkpoint_app_data;
+    return checkpoint_layers_done;
+}
+
 uint32_t ISS::io_read(uint32_t addr) {
 #ifdef ISS_STANDALONE
     runUntilRiscReadyForCmd();
@@ -298,6 +553,7 @@ uint32_t ISS::io_read(uint32_t addr) {
                 dma_access_counter_cluster_pointer = 0;
             break;
         case VPRO_BUSY_MASKED_VPRO_ADDR:
+            if (functional_mode) checkFunctionalDeadlock(architecture_state->sync_cluster_mask_global);
             // masked cluster any busy?
             value = 0;
             for (auto cluster : clusters) {
@@ -312,6 +568,7 @@ uint32_t ISS::io_read(uint32_t addr) {
             }
             break;
         case VPRO_LANE_SYNC_ADDR:
+            if (functional_mode) checkFunctionalDeadlock();
             value = 0;
             for (auto cl : clusters) {
                 for (auto u : cl->getUnits()) {
@@ -327,6 +584,7 @@ uint32_t ISS::io_read(uint32_t addr) {
             }
             break;
         case VPRO_SYNC_ADDR:
+            if (functional_mode) checkFunctionalDeadlock();
             value = (dmalooper->isBusy() | dmablock->isBusy()) << 31;
             for (auto cl : clusters) {
                 value |= cl->dma->isBusy() << cl->cluster_id;
@@ -994,7 +1252,7 @@ void ISS::sim_wait_step(bool finish, char const* msg) {
 
 // copies data in simulated main memory
 int ISS::bin_file_send(uint32_t addr, int num_bytes, char const* file_name) {
-    if (debug & DEBUG_MODE) {
+    if (if_debug(DEBUG_MODE)) {
         printf("\n#SIM: bin_file_send\nBase: 0x%08x\nSize: %d bytes\nSrc:  %s\n\n",
             addr,
             num_bytes,
@@ -1033,7 +1291,7 @@ int ISS::bin_file_send(uint32_t addr, int num_bytes, char const* file_name) {
 
 // returns data from simulated main memory
 uint8_t* ISS::bin_file_return(uint32_t addr, int num_bytes) {
-    if (debug & DEBUG_MODE) {
+    if (if_debug(DEBUG_MODE)) {
         printf("\n#SIM: bin_file_return\n");
         printf("Base: 0x%08x\n", addr);
         printf("Size: %d bytes\n", num_bytes);
@@ -1095,16 +1353,20 @@ uint8_t* ISS::bin_rf_return(uint32_t cluster, uint32_t unit, uint32_t lane) {
     auto u = this->clusters[cluster]->getUnits().at(unit);
     auto l = u->getLanes().at(lane);
 
+    // 24-bit entries, 3 bytes each (LSB first)
     auto rfdata = new uint8_t[VPRO_CFG::RF_SIZE * 3]();
-    for (int lm = 0; lm < VPRO_CFG::RF_SIZE * 3; lm++) {
-        rfdata[lm] = l->getregister()[lm];
+    auto rf = l->getregister();
+    for (int r = 0; r < VPRO_CFG::RF_SIZE; r++) {
+        rfdata[r * 3] = uint8_t(rf[r]);
+        rfdata[r * 3 + 1] = uint8_t(rf[r] >> 8);
+        rfdata[r * 3 + 2] = uint8_t(rf[r] >> 16);
     }
     return rfdata;
 }
 
 // writes data from simulated main memory to file
 int ISS::bin_file_dump(uint32_t addr, int num_bytes, char const* file_name) {
-    if (debug & DEBUG_MODE) {
+    if (if_debug(DEBUG_MODE)) {
         printf("\n#SIM: bin_file_dump\n");
         printf("Base: 0x%08x\n", addr);
         printf("Size: %d bytes\n", num_bytes);
@@ -1146,7 +1408,7 @@ void ISS::aux_memset(uint32_t base_addr, uint8_t value, uint32_t num_bytes) {
     cmd->value = value;
     cmd->addr = base_addr;
 
-    if (debug & DEBUG_MODE) {
+    if (if_debug(DEBUG_MODE)) {
         printf("\n#SIM: aux_memset\n");
         printf("Base: 0x%08x\n", cmd->addr);
         printf("Data: 0x%02x\n", cmd->value);
@@ -34,6 +34,7 @@ using call_systemc_stop_cb = std::function<void(void)>;
 
 #include <QCoreApplication>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QMutex>
 #include <QThread>
 #include <QTime>
@@ -59,6 +60,7 @@ using call_systemc_stop_cb = std::function<void(void)>;
 static bool default_flags[4] = {false, false, false, false};
 
 class DMALooper;
+class ClusterWorkerPool;
 
 class ISS : public QThread {
     // to be able to receive signals from the windows (qt based widgets) & to send signals to them (update of visualized data)
@@ -89,9 +91,7 @@ class ISS : public QThread {
     NonBlockingBusSlaveInterface* bus = NULL;
     DCMA* dcma;
 
-    bool DMA_gen_trace{false};
-
-    std::ofstream dma_sync_trace;
+    static constexpr bool DMA_gen_trace = GENERATE_DMA_TRACE;
 
     ISS();
 
@@ -113,6 +113,11 @@ class ISS : public QThread {
 
     void risc_counter_tick();
 
+    /**
+     * risc clock edges of an idle system (no lane/dma active): counters in bulk, see risc_counter_tick()
+     */
+    void risc_counter_skip(uint64_t ticks);
+
     void setWaitingToFinish(bool waiting) {
         riscv_sync_waiting = waiting;
     }
@@ -131,6 +136,34 @@ class ISS : public QThread {
 
     void aux_memset(uint32_t base_addr, uint8_t value, uint32_t num_bytes);
 
+    /**
+     * loads the files of an input config into the main memory
+     * line format: filename address [size [skip_pos, skip_len]*]
+     * @param path_prefix if set, only files starting with this prefix are loaded...
+     * @param path_replace ...with the prefix replaced by this (e.g. next input of a batch)
+     */
+    void loadMemoryConfig(const QString& cfg_file,
+        const QString& path_prefix = QString(),
+        const QString& path_replace = QString());
+
+    /**
+     * dumps the main memory regions of an output config into files
+     * line format: filename address size [skip_pos, skip_len]*
+     * @param path_prefix if set, only files starting with this prefix are written...
+     * @param path_replace ...with the prefix replaced by this
+     */
+    void dumpMemoryConfig(const QString& cfg_file,
+        const QString& path_prefix = QString(),
+        const QString& path_replace = QString());
+
+    [[nodiscard]] const QString& getInputConfig() const {
+        return inputcfg;
+    }
+
+    [[nodiscard]] const QString& getOutputConfig() const {
+        return outputcfg;
+    }
+
     // *** Simulator debugging funtions ***
     void sim_dump_local_memory(uint32_t cluster, uint32_t unit);
 
@@ -177,9 +210,80 @@ class ISS : public QThread {
     void run_vpro_instruction(const std::shared_ptr<CommandVPRO>& command);
     void run_dma_instruction(const std::shared_ptr<CommandDMA>& command, bool skip_tick = false);
 
+    /**
+     * switch between timed and functional (untimed) execution of vpro / dma commands (see FUNCTIONAL_MODE).
+     * before the functional mode, running commands are finished and the DCMA is flushed and invalidated
+     */
+    void setFunctionalMode(bool functional);
+
+    [[nodiscard]] bool isFunctionalMode() const {
+        return functional_mode;
+    }
+
+    /**
+     * Checkpoint of the architecture state into a binary file (see helper/checkpoint.h):
+     * clock domain times, aux counters, io registers, ArchitectureState, LMs, RFs, accus,
+     * DCMA content, main memory (standalone), the statistics counters and the layer boundary of
+     * the application (see checkpointLayer).
+     * Running commands are finished before (standalone), so no command / transfer is in flight.
+     * @return whether the file was written
+     */
+    bool checkpointSave(const char* file_name);
+
+    /**
+     * restores a checkpoint of checkpointSave(). The architecture config (VPRO_CFG, main memory size,
+     * DCMA) has to match. The ISS has to be idle
+     * @return whether the state got restored (on a failure after the header check, the state is undefined)
+     */
+    bool checkpointRestore(const char* file_name);
+
+    /**
+     * layer boundary of the application (commands of the layers before are synchronized):
+     * writes the checkpoint of --checkpoint-save=<file> if layers_done is --checkpoint-layer=<n>
+     * (instead of at sim_stop). layers_done and app_data (e.g. accumulated cycles) are stored in
+     * each checkpoint
+     */
+    void checkpointLayer(uint32_t layers_done, uint64_t app_data);
+
+    /**
+     * restores the checkpoint of sim_init again, the setup of the host program up to this call is
+     * discarded (the state is the one of the layer boundary)
+     * @return layers done in the checkpoint restored by sim_init, returned once (0: no checkpoint)
+     * @param app_data app_data of checkpointLayer in the checkpoint
+     */
+    uint32_t checkpointResume(uint64_t* app_data);
+
     void clk_tick();  // Must be public for Wrapper
 
-    void openTraceFile(const char* tracefilename);
+    /**
+     * whether ticks of idle components can be skipped (idle_skip and no per cycle debug)
+     */
+    [[nodiscard]] bool isIdleSkipAllowed() const;
+
+    /**
+     * clock edges of a domain in the skipped ticks after from until (including) until, advances the
+     * domain time. As in clk_tick(), a domain has at most one edge per tick
+     */
+    static uint64_t skipClockEdges(double& domain_time, double period, double from, double until);
+
+    /**
+     * main memory timing model (AXI cycles, see MainMemoryTiming), set by the command line
+     * (--mm-model=fixed|dram, --mm-read-latency=, --mm-bank-count=, ...) or --hw-config file
+     */
+    MainMemoryTiming::Config mm_timing;
+
+    /**
+     * parallelism of the DCMA cache model (see Cache::Concurrency), set by the command line
+     * (--dcma-mshrs=, --dcma-bram-ports=, --dcma-hit-under-miss=) or --hw-config file
+     */
+    Cache::Concurrency dcma_concurrency;
+
+    /**
+     * replacement policy and prefetcher of the DCMA (see Cache::Policy), set by the command line
+     * (--dcma-replacement=fifo|lru|lfu|random, --dcma-prefetch=off|next-line|stride,
+     * --dcma-prefetch-degree=) or --hw-config file
+     */
+    Cache::Policy dcma_policy;
 
    private:
     bool windowThread;
@@ -293,12 +397,53 @@ class ISS : public QThread {
     // architecture. top level are clusters
     std::vector<Cluster*> clusters;
 
+    // vpro / dma commands are executed at issue (see FUNCTIONAL_MODE)
+    bool functional_mode = FUNCTIONAL_MODE;
+
+    // ticks of idle components are skipped (see SKIP_IDLE_CYCLES), off by the command line argument --no-idle-skip
+    bool idle_skip = SKIP_IDLE_CYCLES;
+
+    /**
+     * functional mode: lanes still busy at a sync wait for chaining data of a command never issued
+     * -> exit (the hardware would wait forever)
+     */
+    void checkFunctionalDeadlock(uint32_t cluster_mask = 0xffffffff);
+
+    /**
+     * hardware configuration of the command line: --clusters=<n>, --units=<n>, --dcma-nr-rams=<n>,
+     * --dcma-line-size=<bytes>, --dcma-associativity=<n>, --dcma-ram-size=<bytes>
+     * or --hw-config=<file> (lines: <name>=<value>, same names without "--", # comments).
+     * Set in VPRO_CFG if built with run-time configuration (CONF_RUNTIME), otherwise a different
+     * value than the compiled configuration is an error.
+     * @return whether arg is a hardware configuration argument
+     */
+    bool parseHardwareConfig(const char* arg);
+    bool loadHardwareConfig(const QString& file);
+    bool setHardwareParameter(const QString& name, const QString& value);
+    bool checkHardwareConfig() const;
+
+    // checkpoint files of the command line (--checkpoint-save=<file>: at sim_stop or after layer
+    // --checkpoint-layer=<n>, --checkpoint-restore=<file>: at the end of sim_init)
+    QString checkpoint_save_file, checkpoint_restore_file;
+    int checkpoint_layer = -1;
+
+    // last layer boundary of the application (see checkpointLayer), part of the checkpoint
+    uint32_t checkpoint_layers_done = 0;
+    uint64_t checkpoint_app_data = 0;
+    bool checkpoint_resume = false;  // restored, checkpointResume not called yet
+
+    // threads to tick the clusters vpro domain (see CLUSTER_THREADS)
+    int cluster_threads = CLUSTER_THREADS;
+    ClusterWorkerPool* cluster_pool = nullptr;
+
     std::shared_ptr<ArchitectureState> architecture_state;
 
     DMABlockExtractor* dmablock;
     DMALooper* dmalooper;
 
     QTime performanceMeasurementStart;
+    // wall clock of the simulation (init done until exit) for the speed report in printExitStats
+    QElapsedTimer sim_wall_timer;
     QTimer* performanceMeasurement;
     uint64_t performance_clock_last_second;
 
@@ -363,7 +508,7 @@ class ISS : public QThread {
     // give pointer to qt
     void sendmainmemory(uint8_t*);
 
-    void sendRegister(uint8_t*, QVector<bool>);
+    void sendRegister(uint32_t*);  // packed rf entries (see RegisterFile::Register)
 
     void sendLocalmemory(uint8_t*);
 
@@ -416,6 +561,22 @@ class ISS : public QThread {
      */
     void runUntilRiscReadyForCmd();
 
+    /**
+     * no command in any cluster/dma, no open request in dcma/main memory, no dma loop
+     */
+    bool isIdle();
+
+    /**
+     * next event scheduling: each component reports the ticks until its next state change (main
+     * memory: earliest completion, dcma: end of a line fill burst, dma: stalled on the dcma / idle,
+     * units: idle). Advances all clock domains to the tick before the earliest of these events or
+     * the risc clock edge at which runUntil*ReadyForCmd() returns to the application (new command /
+     * io access). Clock edges, stall cycles and statistics in between are accounted in bulk.
+     * @param risc_edges risc clock edges until the application continues (>= 1)
+     * @return number of skipped risc clock edges
+     */
+    uint32_t skipToNextEvent(uint32_t risc_edges);
+
     /**
      * creates a copy of all cmds in list and emits the update to visualization.
      */
@@ -0,0 +1,139 @@
+// ########################################################
+// # VPRO instruction & system simulation library         #
+// ########################################################
+// # binary checkpoint file of the architecture state     #
+// ########################################################
+
+#include "checkpoint.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+#include "debugHelper.h"
+
+namespace Checkpoint {
+
+constexpr int TAG_LENGTH = 8;
+
+// ***********************************************************************
+// Writer
+// ***********************************************************************
+Writer::~Writer() {
+    if (file != nullptr) fclose(file);
+}
+
+bool Writer::open(const char* path) {
+    file = fopen(path, "wb");
+    offset = 0;
+    failed = (file == nullptr);
+    if (failed) printf_error("[Checkpoint] File could not be opened for writing! [FILE: %s]\n", path);
+    return !failed;
+}
+
+void Writer::pad(uint32_t align) {
+    static const uint8_t zeros[PAGE_ALIGN]{};
+    auto padding = (align - offset % align) % align;
+    data(zeros, padding);
+}
+
+void Writer::section(const char* tag, uint32_t align) {
+    char t[TAG_LENGTH]{};
+    strncpy(t, tag, TAG_LENGTH);
+    data(t, TAG_LENGTH);
+    pad(align);
+}
+
+void Writer::data(const void* ptr, size_t size) {
+    if (failed || size == 0) return;
+    if (fwrite(ptr, 1, size, file) != size) {
+        printf_error("[Checkpoint] Write failed!\n");
+        failed = true;
+    }
+    offset += size;
+}
+
+bool Writer::close() {
+    if (file != nullptr) {
+        failed |= (fclose(file) != 0);
+        file = nullptr;
+    }
+    return !failed;
+}
+
+// ***********************************************************************
+// Reader
+// ***********************************************************************
+Reader::~Reader() {
+    close();
+}
+
+bool Reader::open(const char* p) {
+    path = p;
+    offset = 0;
+    failed = true;
+    int fd = ::open(p, O_RDONLY);
+    if (fd < 0) {
+        printf_error("[Checkpoint] File could not be opened! [FILE: %s]\n", p);
+        return false;
+    }
+    struct stat st {};
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        void* m = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (m != MAP_FAILED) {
+            mapped = (const uint8_t*)m;
+            mapped_size = size_t(st.st_size);
+            failed = false;
+        }
+    }
+    ::close(fd);
+    if (failed) printf_error("[Checkpoint] File could not be mapped! [FILE: %s]\n", p);
+    return !failed;
+}
+
+void Reader::skipPad(uint32_t align) {
+    offset += (align - offset % align) % align;
+}
+
+bool Reader::section(const char* tag, uint32_t align) {
+    if (failed) return false;
+    char t[TAG_LENGTH]{};
+    strncpy(t, tag, TAG_LENGTH);
+    if (offset + TAG_LENGTH > mapped_size || memcmp(mapped + offset, t, TAG_LENGTH) != 0) {
+        printf_error("[Checkpoint] Section %.8s expected at offset %" PRIu64 " [FILE: %s]\n",
+            t,
+            offset,
+            path.c_str());
+        failed = true;
+        return false;
+    }
+    offset += TAG_LENGTH;
+    skipPad(align);
+    return true;
+}
+
+void Reader::data(void* ptr, size_t size) {
+    if (failed || size == 0) return;
+    if (offset + size > mapped_size) {
+        fail("unexpected end of file");
+        return;
+    }
+    memcpy(ptr, mapped + offset, size);
+    offset += size;
+}
+
+void Reader::fail(const char* msg) {
+    if (!failed) printf_error("[Checkpoint] Not restorable: %s [FILE: %s]\n", msg, path.c_str());
+    failed = true;
+}
+
+void Reader::close() {
+    if (mapped != nullptr) {
+        munmap((void*)mapped, mapped_size);
+        mapped = nullptr;
+        mapped_size = 0;
+    }
+}
+
+}  // namespace Checkpoint
@@ -0,0 +1,149 @@
+// ########################################################
+// # VPRO instruction & system simulation library         #
+// ########################################################
+// # binary checkpoint file of the architecture state     #
+// # (see ISS::checkpointSave / ISS::checkpointRestore)   #
+// ########################################################
+
+#ifndef VPRO_CPP_CHECKPOINT_H
+#define VPRO_CPP_CHECKPOINT_H
+
+// C std libraries
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * File layout (native byte order, the file is only valid for the same ISS build):
+ *   Header                        magic, version, architecture config
+ *   [Section tag + data]*         tag: 8 chars, data aligned to the section alignment
+ *
+ * Large blocks (main memory) are page aligned, so the file can be mapped and copied
+ * (or mapped directly) without parsing.
+ */
+namespace Checkpoint {
+
+constexpr char MAGIC[8] = {'V', 'P', 'R', 'O', 'C', 'K', 'P', 'T'};
+constexpr uint32_t VERSION = 3;
+constexpr uint32_t PAGE_ALIGN = 4096;
+constexpr uint32_t DEFAULT_ALIGN = 8;
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t clusters, units, lanes;
+    uint32_t lm_size, rf_size;
+    uint64_t mm_size;  // 0: no main memory included (not standalone)
+    double time;       // simulation time (ns) of the checkpoint
+};
+
+class Writer {
+   public:
+    ~Writer();
+
+    bool open(const char* path);
+
+    /**
+     * start a new section. the following data starts at a multiple of align (file offset)
+     */
+    void section(const char* tag, uint32_t align = DEFAULT_ALIGN);
+
+    void data(const void* ptr, size_t size);
+
+    template <class T>
+    void value(const T& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "only raw copyable types");
+        data(&v, sizeof(T));
+    }
+
+    /**
+     * size + elements
+     */
+    template <class T>
+    void vector(const std::vector<T>& v) {
+        value(uint64_t(v.size()));
+        data(v.data(), v.size() * sizeof(T));
+    }
+
+    /**
+     * @return whether all data was written
+     */
+    bool close();
+
+    [[nodiscard]] bool ok() const {
+        return !failed;
+    }
+
+   private:
+    FILE* file{nullptr};
+    uint64_t offset{0};
+    bool failed{false};
+
+    void pad(uint32_t align);
+};
+
+class Reader {
+   public:
+    ~Reader();
+
+    /**
+     * maps the file (read only)
+     */
+    bool open(const char* path);
+
+    /**
+     * checks the tag of the next section (the sections are read in the order they were written)
+     */
+    bool section(const char* tag, uint32_t align = DEFAULT_ALIGN);
+
+    void data(void* ptr, size_t size);
+
+    template <class T>
+    void value(T& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "only raw copyable types");
+        data(&v, sizeof(T));
+    }
+
+    /**
+     * size + elements (see Writer::vector), the vector is resized
+     */
+    template <class T>
+    void vector(std::vector<T>& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "only raw copyable types");
+        uint64_t size = 0;
+        value(size);
+        if (failed || offset > mapped_size || size > (mapped_size - offset) / sizeof(T)) {
+            fail("vector exceeds the file");
+            return;
+        }
+        v.resize(size);
+        data(v.data(), size * sizeof(T));
+    }
+
+    void close();
+
+    [[nodiscard]] bool ok() const {
+        return !failed;
+    }
+
+    /**
+     * marks the checkpoint as not restorable (e.g. config mismatch)
+     */
+    void fail(const char* msg);
+
+   private:
+    const uint8_t* mapped{nullptr};
+    size_t mapped_size{0};
+    uint64_t offset{0};
+    bool failed{false};
+    std::string path;
+
+    void skipPad(uint32_t align);
+};
+
+}  // namespace Checkpoint
+
+#endif  //VPRO_CPP_CHECKPOINT_H
@@ -202,13 +202,3 @@ void print_cmd(CommandBase* cmd) {
     printf("BASE-Command: ");
     cmd->print_class_type();
 }
-
-bool if_debug(DebugOptions op) {
-    return (debug & op);
-}
-
-void ifm_debug(DebugOptions op, const char* msg) {
-    if (if_debug(op)) {
-        printf("%s", msg);
-    }
-}
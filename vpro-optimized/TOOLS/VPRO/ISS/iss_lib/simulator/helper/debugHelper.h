@@ -12,6 +12,7 @@
 "USE common_lib/vpro.h !";
 #endif
 
+#include <cstdio>
 #include <string>
 #include "../../model/commands/CommandDMA.h"
 #include "../../model/commands/CommandVPRO.h"
@@ -82,14 +83,35 @@ QString debugToText(DebugOptions op);
 
 extern uint64_t debug;
 
+/**
+ * debug options checked in the tick path (each cycle / transfer / instruction).
+ * only available in instrumented builds (see INSTRUMENTED_BUILD), compiled out otherwise
+ */
+constexpr uint64_t DEBUG_PER_CYCLE = DEBUG_INSTRUCTIONS | DEBUG_DMA | DEBUG_FIFO_MSG | DEBUG_MODE |
+                                     DEBUG_TICK | DEBUG_GLOBAL_TICK | DEBUG_INSTRUCTION_SCHEDULING |
+                                     DEBUG_INSTRUCTION_DATA | DEBUG_PIPELINE | DEBUG_PIPELINE_9 |
+                                     DEBUG_DMA_DETAIL | DEBUG_CHAINING |
+                                     DEBUG_INSTRUCTION_SCHEDULING_BASIC | DEBUG_LOOPER |
+                                     DEBUG_LOOPER_DETAILED | DEBUG_PIPELINELENGTH_CHANGES |
+                                     DEBUG_LANE_STALLS | DEBUG_DMA_DCACHE_ISSUE | DEBUG_EXT_MEM |
+                                     DEBUG_LANE_ACCU_RESET;
+
+/**
+ * debug options compiled into this build. The runtime mask (debug) can only enable these
+ */
+constexpr uint64_t DEBUG_COMPILED = INSTRUMENTED_BUILD ? ~uint64_t(0) : ~DEBUG_PER_CYCLE;
+
 /**
  * @brief Checks whether debug and the specified option is set
+ * Options not in DEBUG_COMPILED are a constant false (the guarded code is removed)
  *
- * @param op DEBUG_MASK which will be checked
+ * @param op DEBUG_MASK which will be checked (or multiple, any set)
  * @return true
  * @return false
  */
-bool if_debug(DebugOptions op);
+inline bool if_debug(uint64_t op) {
+    return (debug & op & DEBUG_COMPILED) != 0;
+}
 
 /**
  * @brief Printf the msg if debug case is enabled.
@@ -97,7 +119,11 @@ bool if_debug(DebugOptions op);
  * @param op debug case
  * @param msg message to be printed
  */
-void ifm_debug(DebugOptions op, const char* msg);
+inline void ifm_debug(uint64_t op, const char* msg) {
+    if (if_debug(op)) {
+        printf("%s", msg);
+    }
+}
 
 /**
  * @brief Debug Helper. Executes Lambda if debug case is enabled
@@ -107,7 +133,7 @@ void ifm_debug(DebugOptions op, const char* msg);
  * @param lambda to be executed if debug case is active.
  */
 template <class T>
-void ifx_debug(DebugOptions op, T lambda) {
+void ifx_debug(uint64_t op, T lambda) {
     if (if_debug(op)) {
         lambda();
     }
@@ -0,0 +1,238 @@
+// ########################################################
+// # VPRO instruction & system simulation library         #
+// ########################################################
+// # binary trace file of RF / DMA / main memory / cmd    #
+// ########################################################
+
+#include "trace.h"
+
+#include <QByteArray>
+#include <algorithm>
+#include <cstring>
+
+// no debugHelper here: also part of the trace_dump tool (without the simulator)
+
+namespace Trace {
+
+const char* typeName(uint8_t type) {
+    switch (type) {
+        case RF_WRITE:
+            return "RF_WRITE";
+        case DMA_CMD_READ:
+            return "DMA_CMD_READ";
+        case DMA_CMD_WRITE:
+            return "DMA_CMD_WRITE";
+        case DMA_BURST_READ:
+            return "DMA_BURST_READ";
+        case DMA_BURST_WRITE:
+            return "DMA_BURST_WRITE";
+        case DMA_SYNC:
+            return "DMA_SYNC";
+        case MM_READ:
+            return "MM_READ";
+        case MM_WRITE:
+            return "MM_WRITE";
+        case VPRO_CMD:
+            return "VPRO_CMD";
+        case LM_WRITE:
+            return "LM_WRITE";
+        default:
+            return "UNKNOWN";
+    }
+}
+
+// ***********************************************************************
+// Writer
+// ***********************************************************************
+Writer& Writer::get() {
+    static Writer writer;
+    return writer;
+}
+
+Writer::~Writer() {
+    close();
+}
+
+bool Writer::open(const char* path, const double* t) {
+    close();
+    file = fopen(path, "wb");
+    if (file == nullptr) {
+        fprintf(stderr, "[Trace] File could not be opened for writing! [FILE: %s]\n", path);
+        return false;
+    }
+    time = t;
+    offset = 0;
+    failed = false;
+    stop = false;
+    index.clear();
+    generation++;
+
+    Header header{};
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.record_size = sizeof(Record);
+    write(&header, sizeof(header));
+
+    compressor = std::thread(&Writer::compressLoop, this);
+    return true;
+}
+
+Writer::Buffer& Writer::buffer() {
+    thread_local Buffer* local = nullptr;
+    thread_local uint64_t local_generation = 0;
+    if (local == nullptr || local_generation != generation) {
+        std::lock_guard<std::mutex> lock(mutex);
+        buffers.push_back(std::make_unique<Buffer>());
+        local = buffers.back().get();
+        local->stream = uint32_t(buffers.size() - 1);
+        local->records.reserve(CHUNK_RECORDS);
+        local_generation = generation;
+    }
+    return *local;
+}
+
+void Writer::submit(Buffer& b) {
+    if (b.records.empty()) return;
+    std::unique_lock<std::mutex> lock(mutex);
+    pending_cv.wait(lock, [this] { return pending.size() < MAX_PENDING_CHUNKS; });
+    pending.push_back({b.stream, std::move(b.records)});
+    b.records = std::vector<Record>();
+    b.records.reserve(CHUNK_RECORDS);
+    pending_cv.notify_all();
+}
+
+void Writer::compressLoop() {
+    while (true) {
+        Pending chunk;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            pending_cv.wait(lock, [this] { return stop || !pending.empty(); });
+            if (pending.empty()) return;  // stop
+            chunk = std::move(pending.front());
+            pending.pop_front();
+            pending_cv.notify_all();
+        }
+
+        QByteArray compressed = qCompress(reinterpret_cast<const uchar*>(chunk.records.data()),
+            int(chunk.records.size() * sizeof(Record)));
+
+        IndexEntry entry{};
+        entry.offset = offset;
+        entry.chunk.stream = chunk.stream;
+        entry.chunk.records = uint32_t(chunk.records.size());
+        entry.chunk.compressed_size = uint32_t(compressed.size());
+        entry.chunk.first_time = chunk.records.front().time;
+        entry.chunk.last_time = chunk.records.back().time;
+        write(&entry.chunk, sizeof(entry.chunk));
+        write(compressed.constData(), compressed.size());
+        index.push_back(entry);
+    }
+}
+
+void Writer::write(const void* ptr, size_t size) {
+    if (failed || size == 0) return;
+    if (fwrite(ptr, 1, size, file) != size) {
+        fprintf(stderr, "[Trace] Write failed!\n");
+        failed = true;
+    }
+    offset += size;
+}
+
+void Writer::close() {
+    if (file == nullptr) return;
+
+    std::vector<Buffer*> open_buffers;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& b : buffers) open_buffers.push_back(b.get());
+    }
+    for (auto b : open_buffers) submit(*b);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+        pending_cv.notify_all();
+    }
+    compressor.join();
+
+    Footer footer{};
+    footer.index_offset = offset;
+    footer.chunks = index.size();
+    memcpy(footer.magic, MAGIC, sizeof(MAGIC));
+    write(index.data(), index.size() * sizeof(IndexEntry));
+    write(&footer, sizeof(footer));
+
+    failed |= (fclose(file) != 0);
+    if (failed) fprintf(stderr, "[Trace] Trace file incomplete!\n");
+    file = nullptr;
+    buffers.clear();
+    generation++;
+}
+
+// ***********************************************************************
+// Reader
+// ***********************************************************************
+Reader::~Reader() {
+    close();
+}
+
+bool Reader::open(const char* path) {
+    close();
+    file = fopen(path, "rb");
+    if (file == nullptr) {
+        fprintf(stderr, "[Trace] File could not be opened! [FILE: %s]\n", path);
+        return false;
+    }
+
+    Header header{};
+    Footer footer{};
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 &&
+              memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == VERSION &&
+              header.record_size == sizeof(Record);
+    ok = ok && fseek(file, -long(sizeof(footer)), SEEK_END) == 0 &&
+         fread(&footer, sizeof(footer), 1, file) == 1 &&
+         memcmp(footer.magic, MAGIC, sizeof(MAGIC)) == 0;
+    if (ok) {
+        index.resize(footer.chunks);
+        ok = fseek(file, long(footer.index_offset), SEEK_SET) == 0 &&
+             fread(index.data(), sizeof(IndexEntry), index.size(), file) == index.size();
+    }
+    if (!ok) {
+        fprintf(stderr, "[Trace] Not a (complete) trace file of this version! [FILE: %s]\n", path);
+        close();
+    }
+    return ok;
+}
+
+void Reader::close() {
+    if (file != nullptr) fclose(file);
+    file = nullptr;
+    index.clear();
+}
+
+bool Reader::readChunk(size_t i, std::vector<Record>& records) {
+    if (file == nullptr || i >= index.size()) return false;
+    const auto& entry = index[i];
+    QByteArray compressed(int(entry.chunk.compressed_size), Qt::Uninitialized);
+    if (fseek(file, long(entry.offset + sizeof(ChunkHeader)), SEEK_SET) != 0 ||
+        fread(compressed.data(), 1, compressed.size(), file) != size_t(compressed.size())) {
+        fprintf(stderr, "[Trace] Chunk %zu could not be read!\n", i);
+        return false;
+    }
+    QByteArray data = qUncompress(compressed);
+    if (size_t(data.size()) != entry.chunk.records * sizeof(Record)) {
+        fprintf(stderr, "[Trace] Chunk %zu corrupt!\n", i);
+        return false;
+    }
+    records.resize(entry.chunk.records);
+    memcpy(records.data(), data.constData(), data.size());
+    return true;
+}
+
+size_t Reader::findChunk(double time) const {
+    for (size_t i = 0; i < index.size(); i++) {
+        if (index[i].chunk.last_time >= time) return i;
+    }
+    return index.size();
+}
+
+}  // namespace Trace
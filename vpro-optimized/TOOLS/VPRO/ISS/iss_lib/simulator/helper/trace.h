@@ -0,0 +1,199 @@
+// ########################################################
+// # VPRO instruction & system simulation library         #
+// ########################################################
+// # binary trace file of RF / DMA / main memory / cmd    #
+// # events (dump: tools/trace_dump.cpp)                  #
+// ########################################################
+
+#ifndef VPRO_CPP_TRACE_H
+#define VPRO_CPP_TRACE_H
+
+// C std libraries
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * File layout (native byte order):
+ *   Header
+ *   [ChunkHeader + compressed records (qCompress)]*
+ *   IndexEntry[chunks]            chunk index, to seek by simulation time
+ *   Footer                        offset of the index
+ *
+ * Each thread writing records fills its own buffer of CHUNK_RECORDS fixed size records. Full
+ * buffers are compressed and written by a background thread, so a record costs a store in the
+ * tick path. The records of a chunk are in time order, chunks of different streams (threads) may
+ * overlap in time.
+ */
+namespace Trace {
+
+constexpr char MAGIC[8] = {'V', 'P', 'R', 'O', 'T', 'R', 'C', 'E'};
+constexpr uint32_t VERSION = 1;
+
+constexpr uint32_t CHUNK_RECORDS = 1u << 16;  // 2 MB uncompressed
+constexpr uint32_t MAX_PENDING_CHUNKS = 8;     // writer blocks if compression falls behind
+
+/**
+ * record types. meaning of the record fields id / addr / value:
+ */
+enum Type : uint8_t {
+    RF_WRITE = 1,     // rf address, previous data (UNINITIALIZED: not written before), data
+    DMA_CMD_READ,     // dma command id, ext base, loc base
+    DMA_CMD_WRITE,    // dma command id, ext base, loc base
+    DMA_BURST_READ,   // dma command id, ext address, bytes
+    DMA_BURST_WRITE,  // dma command id, ext address, bytes
+    DMA_SYNC,         // -, -, cluster mask
+    MM_READ,          // initiator id, byte address, burst length
+    MM_WRITE,         // initiator id, byte address, burst length
+    VPRO_CMD,         // func | id_mask << 16 | blocking << 24 | chain << 25 | flag_update << 26,
+                      // dst | src1 << 32 (IMM encoding), src2 | x_end << 32 | y_end << 42 | z_end << 52
+    LM_WRITE,         // lm address (16-bit words), -, data
+    end
+};
+
+constexpr uint8_t NONE = 0xff;  // cluster / unit / lane not applicable
+constexpr uint64_t UNINITIALIZED = ~uint64_t(0);
+
+struct Record {
+    double time;  // simulation time (ns)
+    uint8_t type;
+    uint8_t cluster, unit, lane;
+    uint32_t id;
+    uint64_t addr;
+    uint64_t value;
+};
+static_assert(sizeof(Record) == 32, "fixed record size");
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+};
+
+struct ChunkHeader {
+    uint32_t stream;  // writing thread
+    uint32_t records;
+    uint32_t compressed_size;
+    uint32_t reserved;
+    double first_time, last_time;
+};
+
+struct IndexEntry {
+    uint64_t offset;  // file offset of the ChunkHeader
+    ChunkHeader chunk;
+};
+
+struct Footer {
+    uint64_t index_offset;
+    uint64_t chunks;
+    char magic[8];
+};
+
+const char* typeName(uint8_t type);
+
+class Writer {
+   public:
+    /**
+     * one trace file per simulation
+     */
+    static Writer& get();
+
+    ~Writer();
+
+    /**
+     * @param time simulation time, stamped into each record
+     */
+    bool open(const char* path, const double* time);
+
+    /**
+     * flushes the buffers of all threads, waits for the compression and writes the index
+     */
+    void close();
+
+    [[nodiscard]] bool isOpen() const {
+        return file != nullptr;
+    }
+
+    void record(uint8_t type,
+        uint8_t cluster,
+        uint8_t unit,
+        uint8_t lane,
+        uint32_t id,
+        uint64_t addr,
+        uint64_t value) {
+        if (file == nullptr) return;
+        Buffer& b = buffer();
+        b.records.push_back({*time, type, cluster, unit, lane, id, addr, value});
+        if (b.records.size() >= CHUNK_RECORDS) submit(b);
+    }
+
+   private:
+    struct Buffer {
+        uint32_t stream;
+        std::vector<Record> records;
+    };
+    struct Pending {
+        uint32_t stream;
+        std::vector<Record> records;
+    };
+
+    FILE* file{nullptr};
+    const double* time{nullptr};
+    uint64_t offset{0};
+    bool failed{false};
+
+    std::mutex mutex;  // buffers + pending
+    std::condition_variable pending_cv;
+    std::vector<std::unique_ptr<Buffer>> buffers;
+    std::deque<Pending> pending;
+    std::vector<IndexEntry> index;
+    std::thread compressor;
+    bool stop{false};
+    std::atomic<uint64_t> generation{0};  // open count, invalidates the buffers of the threads
+
+    Buffer& buffer();
+    void submit(Buffer& b);
+    void compressLoop();
+    void write(const void* ptr, size_t size);
+};
+
+class Reader {
+   public:
+    ~Reader();
+
+    /**
+     * reads header + chunk index
+     */
+    bool open(const char* path);
+    void close();
+
+    [[nodiscard]] const std::vector<IndexEntry>& chunks() const {
+        return index;
+    }
+
+    /**
+     * decompresses chunk i
+     */
+    bool readChunk(size_t i, std::vector<Record>& records);
+
+    /**
+     * @return first chunk that may contain records at or after time (chunks().size() if none)
+     */
+    [[nodiscard]] size_t findChunk(double time) const;
+
+   private:
+    FILE* file{nullptr};
+    std::vector<IndexEntry> index;
+};
+
+}  // namespace Trace
+
+#endif  //VPRO_CPP_TRACE_H
@@ -51,6 +51,61 @@ extern bool CHECK_MUL_OPERAND_WIDTH_OVERFLOW_WARNING_WAS_PRINTED;    // just pri
 constexpr bool CHECK_RF_UNINITIALIZED_ACCESS = false;
 constexpr bool EXIT_ON_RF_UNINITIALIZED_ACCESS = true;
 
+/**
+ * Range checks of the register file and local memory accesses of the lanes (and RF disabled check).
+ * Only compiled into debug builds, release builds (NDEBUG) use the unchecked accessors.
+ */
+#ifdef NDEBUG
+constexpr bool CHECKED_MEMORY_ACCESS = false;
+#else
+constexpr bool CHECKED_MEMORY_ACCESS = true;
+#endif
+
+/**
+ * Per-cycle instrumentation: tick/pipeline/scheduling/DMA/MM debug prints (see DEBUG_PER_CYCLE).
+ * Compiled out of release builds (NDEBUG), the runtime debug mask has no effect on these options then.
+ * Instrumented release build (e.g. for speed comparison): cmake -DISS_INSTRUMENTED=ON
+ */
+#if defined(ISS_INSTRUMENTED) || !defined(NDEBUG)
+constexpr bool INSTRUMENTED_BUILD = true;
+#else
+constexpr bool INSTRUMENTED_BUILD = false;
+#endif
+
+/**
+ * events in the binary trace file (see helper/trace.h; print: trace_dump), build option:
+ * cmake -DISS_TRACE=DMA,RF (make sim_% TRACE=DMA,RF) defines ISS_TRACE_DMA / ISS_TRACE_RF
+ *  DMA: dma commands, bursts + syncs
+ *  MM: main memory bursts of the NonBlockingMainMemory
+ *  RF: register file writes
+ *  LM: local memory writes (lanes + DMA)
+ *  CMD: issued vpro commands
+ */
+#ifndef ISS_TRACE_DMA
+#define ISS_TRACE_DMA 0
+#endif
+#ifndef ISS_TRACE_MM
+#define ISS_TRACE_MM 0
+#endif
+#ifndef ISS_TRACE_RF
+#define ISS_TRACE_RF 0
+#endif
+#ifndef ISS_TRACE_LM
+#define ISS_TRACE_LM 0
+#endif
+#ifndef ISS_TRACE_CMD
+#define ISS_TRACE_CMD 0
+#endif
+constexpr bool GENERATE_DMA_TRACE = ISS_TRACE_DMA;
+constexpr bool GENERATE_MM_TRACE = ISS_TRACE_MM;
+constexpr bool GENERATE_RF_TRACE = ISS_TRACE_RF;
+constexpr bool GENERATE_LM_TRACE = ISS_TRACE_LM;
+constexpr bool GENERATE_CMD_TRACE = ISS_TRACE_CMD;
+constexpr bool GENERATE_TRACE =
+    GENERATE_DMA_TRACE || GENERATE_MM_TRACE || GENERATE_RF_TRACE || GENERATE_LM_TRACE ||
+    GENERATE_CMD_TRACE;
+constexpr char TRACE_FILE_NAME[] = "sim.trace";
+
 /**
  * enables resuming of execution trough gui via button
  */
@@ -75,14 +130,39 @@ constexpr int UNITS_COMMAND_QUEUE_MAX_SIZE = 32;
 constexpr bool simulationSpeedMeasurement = true;
 
 /**
- * Whether to seperate Cluster, Units or Lanes into threads...
- * more sense on high content tick functions (cluster...)
+ * Number of threads to tick the clusters in parallel (ClusterWorkerPool): vpro domain (units + lanes)
+ * and the dma requests to the per-cluster DCMA ports. The threads are synchronized by a spin barrier
+ * once per vpro and dma clock cycle. The dma transfers through the shared DCMA, the DCMA and the
+ * main memory are ticked by the simulator thread (cluster order, results do not depend on threads).
+ * Only useful for multiple clusters (threads are limited to #clusters) and free host cores, the two
+ * barriers per cycle slow the simulation down if threads share a core (default: 1)
+ *
+ * 1: no threads, 0: one thread per host core
+ * overwritten by the command line argument --threads=<n>
+ */
+constexpr int CLUSTER_THREADS = 1;
+
+/**
+ * Skip the clock ticks of idle components (drained lanes, idle DMA / DCMA / main memory).
+ * Clusters with drained lanes only account the idle cycle in the statistics, and if the lanes are
+ * idle and the DMAs idle or stalled on a DCMA line fill, the simulation time jumps directly to the
+ * next event (completion in the main memory, end of a line fill burst, or the risc clock edge at
+ * which the application issues its next command / io access).
+ * Statistics and counters are updated in bulk, so the simulated cycles do not change.
  *
- * constexpr bool THREAD_CLUSTER = true;   // if #cluster  >= 2 && units   >= 4    (more means more tick time)
+ * overwritten by the command line argument --no-idle-skip (e.g. to compare against the per tick run)
+ */
+constexpr bool SKIP_IDLE_CYCLES = true;
+
+/**
+ * Functional (untimed) mode: VPRO commands are executed element-wise at issue (lanes, chaining,
+ * MAC accumulation), DMA transfers are copied directly between main memory and the local memories.
+ * The lane pipelines, DMA, DCMA and bus timing is bypassed, only LM/RF/MM results are valid.
+ * Cycles are estimated per command (see printExitStats).
  *
- * no big influence on simulated cycles / s !??? => maybe some bug somewhere? should speed it up...
+ * overwritten by the command line argument --functional, switched at runtime by ISS::setFunctionalMode()
  */
-//#define THREAD_CLUSTER
+constexpr bool FUNCTIONAL_MODE = false;
 
 /**
  * Log files for CMD history (
@@ -107,12 +187,17 @@ extern QFile* PRE_GEN_FILE;
 extern QTextStream* CMD_HISTORY_FILE_STREAM;
 extern QDataStream* PRE_GEN_FILE_STREAM;
 
-// sim_exit()
-const QString dumpFileSuffix = QString::number(VPRO_CFG::CLUSTERS) + "C" +
-                               QString::number(VPRO_CFG::UNITS) + "U" +
-                               QString::number(VPRO_CFG::LANES) + "L";
-const QString dumpFileName = "../statistics/statistic_detail_" + dumpFileSuffix + ".log";
-const QString dumpJSONFileName = "../statistics/statistics_detail_" + dumpFileSuffix + ".json";
+// sim_exit() (functions: the configuration may be set at run-time, see VPRO_CFG)
+inline QString dumpFileSuffix() {
+    return QString::number(VPRO_CFG::CLUSTERS) + "C" + QString::number(VPRO_CFG::UNITS) + "U" +
+           QString::number(VPRO_CFG::LANES) + "L";
+}
+inline QString dumpFileName() {
+    return "../statistics/statistic_detail_" + dumpFileSuffix() + ".log";
+}
+inline QString dumpJSONFileName() {
+    return "../statistics/statistics_detail_" + dumpFileSuffix() + ".json";
+}
 
 /**
  * Log files for PRE_GEN history
@@ -18,6 +18,8 @@
 #include <QThread>
 #include <QtConcurrent/QtConcurrent>
 #include <QtCore/QFuture>
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <fstream>
 #include <iostream>
@@ -28,11 +30,13 @@
 #include <thread>
 #endif
 
+#include "../model/architecture/ClusterWorkerPool.h"
 #include "../model/architecture/DMALooper.h"
 #include "../model/architecture/stats/Statistics.h"
 #include "ISS.h"
 #include "VectorMain.h"
 #include "helper/debugHelper.h"
+#include "helper/trace.h"
 
 QFile* CMD_HISTORY_FILE;
 FILE* CMD_ISSUE_FILE;
@@ -58,6 +62,32 @@ struct Sync {
     byte intValue;
 };
 
+/**
+ * input.cfg / output.cfg transfers: skip_len bytes of the MM are skipped after every skip_pos bytes of data.
+ * calls transfer(data_offset, mm_addr, length) for each gap-free run between the skip points
+ */
+template <class F>
+static void forEachSkipRun(uint64_t mm_addr,
+    uint64_t size,
+    const QVector<int64_t>& skip_pos,
+    const QVector<int64_t>& skip_len,
+    F transfer) {
+    uint64_t i = 0;
+    while (i < size) {
+        uint64_t next = size;
+        for (int si = 0; si < skip_pos.size(); si++) {
+            if (skip_pos[si] <= 0) continue;
+            next = std::min(next, (i / skip_pos[si] + 1) * skip_pos[si]);
+        }
+        transfer(i, mm_addr, next - i);
+        mm_addr += next - i;
+        i = next;
+        for (int si = 0; si < skip_pos.size(); si++) {
+            if (skip_pos[si] > 0 && i % skip_pos[si] == 0) mm_addr += skip_len[si];
+        }
+    }
+}
+
 ISS::ISS()
     : architecture_state(std::make_shared<ArchitectureState>()) {
     sim_finished = false;
@@ -79,23 +109,229 @@ ISS::ISS()
 
     general_purpose_register = new uint32_t[0xff / 4]();
 
-    if (DMA_gen_trace) {
-        std::stringstream ss;
-        ss << "DMA_SYNC.trace";
-        openTraceFile(ss.str().c_str());
+    if (GENERATE_TRACE) {
+        Trace::Writer::get().open(TRACE_FILE_NAME, &time);
     }
 
     simPause();
 }
 
-void ISS::openTraceFile(const char* tracefilename) {
-    dma_sync_trace = std::ofstream(tracefilename);
-}
-
 // ###############################################################################################################################
 // Simulator Environment
 // ###############################################################################################################################
 
+// ---------------------------------------------------------------------------------
+// Hardware configuration (VPRO_CFG)
+// ---------------------------------------------------------------------------------
+namespace {
+#ifdef CONF_RUNTIME
+using hardware_parameter_t = unsigned int*;
+#else
+using hardware_parameter_t = const unsigned int*;
+#endif
+
+struct HardwareParameter {
+    const char* name;
+    hardware_parameter_t value;
+};
+
+const HardwareParameter hardware_parameters[] = {
+    {"clusters", &VPRO_CFG::CLUSTERS},
+    {"units", &VPRO_CFG::UNITS},
+    {"dcma-nr-rams", &VPRO_CFG::DCMA_NR_BRAMS},
+    {"dcma-line-size", &VPRO_CFG::DCMA_LINE_SIZE},
+    {"dcma-associativity", &VPRO_CFG::DCMA_ASSOCIATIVITY},
+    {"dcma-ram-size", &VPRO_CFG::DCMA_BRAM_SIZE},
+};
+
+// simulation model parameters (independent of the compiled configuration, 0 allowed)
+template <typename Config>
+struct ModelParameter {
+    const char* name;
+    uint32_t Config::*value;
+};
+
+const ModelParameter<MainMemoryTiming::Config> mm_parameters[] = {
+    {"mm-read-latency", &MainMemoryTiming::Config::read_latency},
+    {"mm-write-latency", &MainMemoryTiming::Config::write_latency},
+    {"mm-bytes-per-cycle", &MainMemoryTiming::Config::bytes_per_cycle},
+    {"mm-bank-count", &MainMemoryTiming::Config::banks},
+    {"mm-row-size", &MainMemoryTiming::Config::row_size},
+    {"mm-row-hit-latency", &MainMemoryTiming::Config::row_hit_latency},
+    {"mm-row-miss-latency", &MainMemoryTiming::Config::row_miss_latency},
+    {"mm-turnaround", &MainMemoryTiming::Config::turnaround},
+    {"mm-max-outstanding", &MainMemoryTiming::Config::max_outstanding},
+};
+
+const ModelParameter<Cache::Concurrency> dcma_parameters[] = {
+    {"dcma-mshrs", &Cache::Concurrency::mshrs},
+    {"dcma-bram-ports", &Cache::Concurrency::bram_ports},
+    {"dcma-hit-under-miss", &Cache::Concurrency::hit_under_miss},
+};
+
+const ModelParameter<Cache::Policy> dcma_policy_parameters[] = {
+    {"dcma-prefetch-degree", &Cache::Policy::prefetch_degree},
+};
+
+// simulation model options selected by name
+struct ModelOption {
+    const char* name;
+    uint32_t value;
+};
+
+const ModelOption mm_model_options[] = {
+    {"fixed", MainMemoryTiming::FIXED},
+    {"dram", MainMemoryTiming::DRAM},
+};
+
+const ModelOption dcma_replacement_options[] = {
+    {"fifo", Cache::FIFO},
+    {"lru", Cache::LRU},
+    {"lfu", Cache::LFU},
+    {"random", Cache::Random},
+};
+
+const ModelOption dcma_prefetch_options[] = {
+    {"off", DCMAPrefetcher::OFF},
+    {"next-line", DCMAPrefetcher::NEXT_LINE},
+    {"stride", DCMAPrefetcher::STRIDE},
+};
+
+/**
+ * @return whether name is one of the table's parameters (invalid values exit)
+ */
+template <typename Config, size_t N>
+bool setModelParameter(const ModelParameter<Config> (&parameters)[N],
+    Config& config,
+    const QString& name,
+    const QString& value) {
+    for (const auto& p : parameters) {
+        if (name != p.name) continue;
+        bool ok;
+        config.*p.value = value.toUInt(&ok, 0);
+        if (!ok) {
+            printf_error("[HW Config] Invalid value for %s: %s\n", p.name, value.toStdString().c_str());
+            std::exit(EXIT_FAILURE);
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @return whether name is the parameter (invalid values exit)
+ */
+template <size_t N>
+bool setModelOption(const char* parameter,
+    const ModelOption (&options)[N],
+    uint32_t& target,
+    const QString& name,
+    const QString& value) {
+    if (name != parameter) return false;
+    for (const auto& o : options) {
+        if (value != o.name) continue;
+        target = o.value;
+        return true;
+    }
+    QString names;
+    for (const auto& o : options)
+        names += QString(names.isEmpty() ? "" : "|") + o.name;
+    printf_error("[HW Config] Invalid value for %s: %s (%s)\n",
+        parameter,
+        value.toStdString().c_str(),
+        names.toStdString().c_str());
+    std::exit(EXIT_FAILURE);
+}
+}  // namespace
+
+bool ISS::setHardwareParameter(const QString& name, const QString& value) {
+    if (setModelOption("mm-model", mm_model_options, mm_timing.model, name, value)) return true;
+    if (setModelOption("dcma-replacement",
+            dcma_replacement_options,
+            dcma_policy.replacement,
+            name,
+            value))
+        return true;
+    if (setModelOption("dcma-prefetch", dcma_prefetch_options, dcma_policy.prefetch, name, value))
+        return true;
+    if (setModelParameter(mm_parameters, mm_timing, name, value)) return true;
+    if (setModelParameter(dcma_parameters, dcma_concurrency, name, value)) return true;
+    if (setModelParameter(dcma_policy_parameters, dcma_policy, name, value)) return true;
+    for (const auto& p : hardware_parameters) {
+        if (name != p.name) continue;
+        bool ok;
+        auto v = value.toUInt(&ok, 0);
+        if (!ok || v == 0) {
+            printf_error("[HW Config] Invalid value for %s: %s\n", p.name, value.toStdString().c_str());
+            std::exit(EXIT_FAILURE);
+        }
+#ifdef CONF_RUNTIME
+        *p.value = v;
+        VPRO_CFG::updateDerived();
+#else
+        if (*p.value != v) {
+            printf_error(
+                "[HW Config] %s=%u differs from the compiled configuration (%u). Rebuild with "
+                "RUNTIME_CONFIG=1 to set it at run-time!\n",
+                p.name, v, *p.value);
+            std::exit(EXIT_FAILURE);
+        }
+#endif
+        return true;
+    }
+    return false;
+}
+
+bool ISS::loadHardwareConfig(const QString& file) {
+    QFile f(file);
+    if (!f.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        printf_error("[HW Config] File could not be opened! [FILE: %s]\n", file.toStdString().c_str());
+        return false;
+    }
+    while (!f.atEnd()) {
+        auto line = QString(f.readLine()).section('#', 0, 0).trimmed();
+        if (line.isEmpty()) continue;
+        if (!setHardwareParameter(line.section('=', 0, 0).trimmed(), line.section('=', 1).trimmed())) {
+            printf_error("[HW Config] Unknown parameter: %s [FILE: %s]\n",
+                line.toStdString().c_str(),
+                file.toStdString().c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ISS::parseHardwareConfig(const char* arg) {
+    if (qstrncmp(arg, "--", 2) != 0) return false;
+    auto option = QString(arg + 2);
+    if (option.startsWith("hw-config=")) {
+        if (!loadHardwareConfig(option.section('=', 1))) std::exit(EXIT_FAILURE);
+        return true;
+    }
+    if (!option.contains('=')) return false;
+    return setHardwareParameter(option.section('=', 0, 0), option.section('=', 1));
+}
+
+bool ISS::checkHardwareConfig() const {
+    auto isPow2 = [](unsigned int v) { return v != 0 && (v & (v - 1)) == 0; };
+    bool ok = true;
+    if (VPRO_CFG::CLUSTERS > 32 || VPRO_CFG::UNITS > 32) {
+        printf_error("[HW Config] Max. 32 clusters / units (cluster / unit masks)!\n");
+        ok = false;
+    }
+    if (!isPow2(VPRO_CFG::DCMA_LINE_SIZE) || !isPow2(VPRO_CFG::DCMA_ASSOCIATIVITY) ||
+        !isPow2(VPRO_CFG::DCMA_NR_BRAMS) || !isPow2(VPRO_CFG::DCMA_BRAM_SIZE)) {
+        printf_error("[HW Config] DCMA parameters need to be a power of 2!\n");
+        ok = false;
+    }
+    if (VPRO_CFG::DCMA_LINE_SIZE * VPRO_CFG::DCMA_ASSOCIATIVITY >
+        VPRO_CFG::DCMA_NR_BRAMS * VPRO_CFG::DCMA_BRAM_SIZE) {
+        printf_error("[HW Config] DCMA: one set (line size x associativity) exceeds the cache size!\n");
+        ok = false;
+    }
+    return ok;
+}
+
 // ---------------------------------------------------------------------------------
 // Initialize simulation environment
 // ---------------------------------------------------------------------------------
@@ -106,8 +342,23 @@ int ISS::sim_init(int (*main_fkt)(int, char**), int& argc, char* argv[]) {
                 printf_warning("Gonna run silent, without windows [--windowless]\n");
                 windowless = true;
                 simResume();
+            } else if (!qstrncmp(argv[i], "--threads=", 10)) {
+                cluster_threads = atoi(argv[i] + 10);
+            } else if (!qstrcmp(argv[i], "--functional")) {
+                functional_mode = true;
+            } else if (!qstrcmp(argv[i], "--no-idle-skip")) {
+                idle_skip = false;
+            } else if (!qstrncmp(argv[i], "--checkpoint-save=", 18)) {
+                checkpoint_save_file = QString(argv[i] + 18);
+            } else if (!qstrncmp(argv[i], "--checkpoint-restore=", 21)) {
+                checkpoint_restore_file = QString(argv[i] + 21);
+            } else if (!qstrncmp(argv[i], "--checkpoint-layer=", 19)) {
+                checkpoint_layer = atoi(argv[i] + 19);
+            } else {
+                parseHardwareConfig(argv[i]);
             }
         }
+        if (!checkHardwareConfig()) std::exit(EXIT_FAILURE);
     }
 
     if (!windowThread) {
@@ -137,6 +388,14 @@ int ISS::sim_init(int (*main_fkt)(int, char**), int& argc, char* argv[]) {
         printf("#                       VPRO_CFG::DCMA_ASSOCIATIVITY: %3d, Ram Size in Bytes:    %3d \n",
             VPRO_CFG::DCMA_ASSOCIATIVITY,
             VPRO_CFG::DCMA_BRAM_SIZE);
+        printf("#  MSHRs:  %3d, Ports per Ram: %3d, Hit under Miss: %s\n",
+            std::max(dcma_concurrency.mshrs, 1u),
+            std::max(dcma_concurrency.bram_ports, 1u),
+            dcma_concurrency.hit_under_miss ? "yes" : "no");
+        printf("#  Replacement: %s, Prefetch: %s (degree %d)\n",
+            dcma_replacement_options[std::min(dcma_policy.replacement, 3u)].name,
+            dcma_prefetch_options[std::min(dcma_policy.prefetch, 2u)].name,
+            std::max(dcma_policy.prefetch_degree, 1u));
         printf("#\n");
         printf("# ISS Memories:\n");
 #ifdef ISS_STANDALONE
@@ -196,10 +455,15 @@ int ISS::sim_init(int (*main_fkt)(int, char**), int& argc, char* argv[]) {
             "---------------------------------------------------------------------------------\n");
 
 #ifdef ISS_STANDALONE
-        bus = new NonBlockingMainMemory(VPRO_CFG::MM_SIZE);
+        {
+            auto mm = new NonBlockingMainMemory(VPRO_CFG::MM_SIZE, VPRO_CFG::CLUSTERS);
+            mm->setTiming(mm_timing);
+            bus = mm;
+            printf("# Main Memory: %s\n", mm->timingDescription().c_str());
+        }
 #endif
 
-        dcma = new DCMA(this, bus, VPRO_CFG::CLUSTERS, VPRO_CFG::DCMA_LINE_SIZE, VPRO_CFG::DCMA_ASSOCIATIVITY, VPRO_CFG::DCMA_NR_BRAMS, VPRO_CFG::DCMA_BRAM_SIZE);
+        dcma = new DCMA(this, bus, VPRO_CFG::CLUSTERS, VPRO_CFG::DCMA_LINE_SIZE, VPRO_CFG::DCMA_ASSOCIATIVITY, VPRO_CFG::DCMA_NR_BRAMS, VPRO_CFG::DCMA_BRAM_SIZE, dcma_concurrency, dcma_policy);
 
         printf_info("# Calling initialization Script %s ... ", initscript.toStdString().c_str());
         std::ifstream init_script(initscript.toStdString().c_str());
@@ -213,74 +477,16 @@ int ISS::sim_init(int (*main_fkt)(int, char**), int& argc, char* argv[]) {
         // ########################################################################
         // Read input to MM (.cfg)
         // ########################################################################
-        if (argc > 2 && windowless) {
-            inputcfg = QString(argv[2]);
-        } else if (argc >= 2 && !windowless) {
-            inputcfg = QString(argv[1]);
-        }
-        if (argc >= 4 && windowless) {
-            outputcfg = QString(argv[3]);
-        } else if (argc >= 3) {
-            outputcfg = QString(argv[2]);
+        // positional arguments (options start with "--"): [input.cfg [output.cfg]]
+        QStringList positional;
+        for (int i = 1; i < argc; ++i) {
+            if (!QString(argv[i]).startsWith("--")) positional.append(QString(argv[i]));
         }
+        if (positional.size() >= 1) inputcfg = positional[0];
+        if (positional.size() >= 2) outputcfg = positional[1];
 
         printf_info("# Input settings from %s\n", inputcfg.toStdString().c_str());
-        QFile configfile(inputcfg);
-        configfile.open(QIODevice::ReadOnly);
-        while (!configfile.atEnd()) {
-            // line format: filename address [size [skip_pos, skip_len]*]
-            QString line = configfile.readLine();
-            line = line.simplified();
-            if (line.startsWith(";") or line.startsWith("#") or line.isEmpty()) continue;
-            auto input_items = line.split(" ");
-            if (input_items.size() < 2) {
-                printf_warning(
-                    "Input file not containing enough items [Required: File, Address]\n");
-                continue;
-            }
-            QString input_file = input_items[0];
-            uint64_t address = input_items[1].toULong(nullptr, 0);
-            int64_t size = -1;
-            if (input_items.size() > 2) {
-                size = input_items[2].toLong(nullptr, 0);
-            }
-            // insert gaps during load to MM: skip_len bytes every skip_pos bytes
-            QVector<int64_t> skip_pos;
-            QVector<int64_t> skip_len;
-            for (int si = 3; si + 1 < input_items.size(); si += 2) {
-                skip_pos.append(input_items[si].toLong(nullptr, 0));
-                skip_len.append(input_items[si + 1].toLong(nullptr, 0));
-            }
-            QFile input(input_file);
-            if (!input.open(QIODevice::ReadOnly)) {
-                printf_warning(
-                    "Input could not be opened! [File: %s]\n", input_file.toStdString().c_str());
-                continue;
-            }
-            QByteArray input_data;
-            if (size <= 0) {
-                input_data = input.readAll();
-            } else {
-                input_data = input.read(size);
-            }
-            uint64_t mm_addr = address;
-            for (int i = 0; i < input_data.size(); i++) {
-                auto writedata = uint8_t(input_data.at(i));
-                bus->dbgWrite(mm_addr, &writedata);
-                mm_addr++;
-                for (int si = 0; si < skip_pos.size(); si++) {
-                    if ((i + 1) % skip_pos[si] == 0) {
-                        mm_addr += skip_len[si];
-                    }
-                }
-            }
-            if (if_debug(DEBUG_DUMP_FLAGS))
-                printf_info("\tFile %s was read to MM [%u (Dez) / 0x%x (Hex)]\t Size: %i\n",
-                    input_file.toStdString().c_str(),
-                    address,
-                    address,
-                    input_data.size());
-        }
+        loadMemoryConfig(inputcfg);
 
         // ########################################################################
         // check global variables . their addresses have to be outside MM
@@ -307,7 +513,7 @@ int ISS::sim_init(int (*main_fkt)(int, char**), int& argc, char* argv[]) {
                     (int)length);  // (__attribute__ ((section ("glob"))))
             }
         }
-        if (debug & DEBUG_GLOBAL_VARIABLE_CHECK) {
+        if (if_debug(DEBUG_GLOBAL_VARIABLE_CHECK)) {
             printf(
                 "#SIM: For Simulation the global Variables are accessed by their address. "
                 "Checking...:\n");
@@ -346,7 +552,7 @@ int ISS::sim_init(int (*main_fkt)(int, char**), int& argc, char* argv[]) {
                         name,
                         address,
                         size);
-                } else if (address >= VPRO_CFG::MM_SIZE && (debug & DEBUG_GLOBAL_VARIABLE_CHECK)) {
+                } else if (address >= VPRO_CFG::MM_SIZE && if_debug(DEBUG_GLOBAL_VARIABLE_CHECK)) {
                     QMap<int, QString> object;
                     object[size] = name;
                     // TODO
@@ -407,16 +613,17 @@ int ISS::sim_init(int (*main_fkt)(int, char**), int& argc, char* argv[]) {
             w->setVproSpecialRegisters(v);
         }
 
-#ifdef THREAD_CLUSTER
-        //        busythreads.release(VPRO_CFG::CLUSTERS);
-        if (VPRO_CFG::CLUSTERS >= 2 && VPRO_CFG::UNITS >= 2) {
-            for (Cluster* cluster : clusters) {
-                cluster->tick_en.lock();
-                cluster->tick_done.lock();
-                cluster->start();
-            }
+        int threads = cluster_threads;
+        if (threads <= 0) threads = int(std::thread::hardware_concurrency());
+        threads = std::min(threads, int(VPRO_CFG::CLUSTERS));
+        if (threads > 1) {
+            cluster_pool = new ClusterWorkerPool(clusters, threads, dcma->hasClusterPorts());
+            printf("# Clusters are simulated by %i threads\n", threads);
         }
-#endif
+        if (functional_mode) {
+            printf("# Functional mode: vpro / dma commands are executed untimed at issue\n");
+        }
+
         if (CREATE_CMD_HISTORY_FILE) {
             QFileInfo fi(CMD_HISTORY_FILE_NAME);
             CMD_HISTORY_FILE = new QFile(CMD_HISTORY_FILE_NAME);
@@ -479,7 +686,16 @@ int ISS::sim_init(int (*main_fkt)(int, char**), int& argc, char* argv[]) {
             "# "
             "---------------------------------------------------------------------------------\n");
         Statistics::get().initialize(this);
+
+        // the statistics are part of the checkpoint
+        if (!checkpoint_restore_file.isEmpty()) {
+            if (!checkpointRestore(checkpoint_restore_file.toStdString().c_str())) {
+                QCoreApplication::quit();  // the GUI thread waits in exec() (see sim_stop)
+                std::exit(EXIT_FAILURE);   // (exit() is the signal of the ISS)
+            }
+        }
         isCompletelyInitialized = true;
+        sim_wall_timer.start();
         // return to main and simulate program in this thread
         return 0;
     }
@@ -615,6 +831,11 @@ void ISS::sim_stop(bool silent, int exit_code) {
             cluster_busy |= cluster->isBusy();
         }
         if (cluster_busy) {
+            if (functional_mode) {
+                // no clock driven progress, lanes wait for chaining data (see checkFunctionalDeadlock)
+                printf_error("[Functional] Lanes still wait for chaining data!\n");
+                break;
+            }
             run();
             continue;
         }
@@ -623,7 +844,18 @@ void ISS::sim_stop(bool silent, int exit_code) {
     sendSimUpdate();
     simPause();
 
+    if (!checkpoint_save_file.isEmpty()) {
+        auto file = checkpoint_save_file.toStdString();
+        checkpoint_save_file.clear();  // once (sim_stop is called again on an error)
+        checkpointSave(file.c_str());
+    }
+
     printExitStats(silent);   // stat to file/console
+    delete cluster_pool;   // joins the worker threads
+    cluster_pool = nullptr;
+    if (GENERATE_TRACE) {
+        Trace::Writer::get().close();
+    }
     if (CREATE_CMD_HISTORY_FILE) {
         CMD_HISTORY_FILE_STREAM->flush();
         CMD_HISTORY_FILE->close();
@@ -742,6 +974,8 @@ void ISS::runUntilReadyForCmd() {
 #endif
     bool clusterClocking = false;
     while (true) {
+        // while no cluster is ready (same state until the next event), the risc edges only count
+        skipToNextEvent(clusterClocking ? UINT32_MAX : 1);
         run();
 
         // check if any cluster is rdy for a cmd (queue not full, no dma|vpro wait_busy, loop not blocking)
@@ -755,7 +989,7 @@ void ISS::runUntilReadyForCmd() {
         if (risc_time > time)
             continue;
         else {
-            if (debug & DEBUG_TICK)
+            if (if_debug(DEBUG_TICK))
                 printf("RISC Clock Cycle %.2lf (RISC Time: %.2lf ns)\n",
                     risc_time / risc_clock_period,
                     risc_time);
@@ -780,11 +1014,12 @@ void ISS::runUntilRiscReadyForCmd() {
 #endif
     uint32_t io_cycle_counter = 0;
     while (true) {
+        io_cycle_counter += skipToNextEvent(risc_io_access_cycles - io_cycle_counter);
         run();
         if (risc_time > time) {
             continue;
         } else {
-            if (debug & DEBUG_TICK)
+            if (if_debug(DEBUG_TICK))
                 printf("RISC Clock Cycle %.2lf (RISC Time: %.2lf ns)\n",
                     risc_time / risc_clock_period,
                     risc_time);
@@ -824,6 +1059,115 @@ void ISS::risc_counter_tick() {
     if (!riscv_sync_waiting) aux_cnt_riscv_enabled++;
 }
 
+void ISS::risc_counter_skip(uint64_t ticks) {
+    // the busy state of units / dmas is the same in each skipped cycle
+    bool any_lane_busy = false, any_dma_busy = false;
+    for (auto c : clusters) {
+        for (auto unit : c->getUnits()) {
+            if (unit->isBusy()) any_lane_busy = true;
+        }
+        if (c->dma->isBusy()) any_dma_busy = true;
+    }
+    if (any_lane_busy) aux_cnt_lane_act += ticks;
+    if (any_dma_busy) aux_cnt_dma_act += ticks;
+    if (any_lane_busy && any_dma_busy) aux_cnt_both_act += ticks;
+    aux_cnt_vpro_total += ticks;
+    aux_cnt_riscv_total += ticks;
+    aux_sys_time += ticks;
+    aux_cycle_counter += ticks;
+    if (!riscv_sync_waiting) aux_cnt_riscv_enabled += ticks;
+}
+
+bool ISS::isIdleSkipAllowed() const {
+    return idle_skip &&
+           !if_debug(DEBUG_TICK | DEBUG_GLOBAL_TICK | DEBUG_INSTRUCTION_SCHEDULING |
+                     DEBUG_PIPELINE | DEBUG_PIPELINE_9 | DEBUG_FIFO_MSG);
+}
+
+bool ISS::isIdle() {
+    if (dmalooper->isBusy() || dmalooper->hasInput() || dmablock->isBusy()) return false;
+    for (auto cluster : clusters) {
+        if (!cluster->isIdle()) return false;
+    }
+    if (!dcma->isIdle()) return false;
+#ifdef ISS_STANDALONE
+    if (!reinterpret_cast<NonBlockingMainMemory*>(bus)->isIdle()) return false;
+#endif
+    return true;
+}
+
+uint64_t ISS::skipClockEdges(double& domain_time, double period, double from, double until) {
+    // tick k (1..n) after from has an edge if domain_time <= from + k * tick period, the edge
+    // advances domain_time by m ticks. A lagging domain (e.g. vpro: domain_time <= from) has an
+    // edge in each tick until it caught up, then one every m ticks
+    const int64_t n = std::llround((until - from) / iss_clock_tick_period);
+    if (n <= 0) return 0;
+    const int64_t m = std::llround(period / iss_clock_tick_period);
+    int64_t next = int64_t(std::ceil((domain_time - from) / iss_clock_tick_period));
+    int64_t edges = 0;
+    if (next < 1) {
+        int64_t catch_up = m == 1 ? n : (1 - next) / (m - 1) + 1;
+        if (catch_up >= n) {
+            domain_time += double(n) * period;
+            return uint64_t(n);
+        }
+        edges = catch_up;
+        next += catch_up * m;
+    }
+    if (next <= n) edges += (n - next) / m + 1;
+    domain_time += double(edges) * period;
+    return uint64_t(edges);
+}
+
+uint32_t ISS::skipToNextEvent(uint32_t risc_edges) {
+    if (!isCompletelyInitialized || sim_finished || !windowless || !isIdleSkipAllowed()) return 0;
+    // the last risc clock edge is processed by runUntil*(), tick until right before it
+    double until = risc_time + (risc_edges - 1) * risc_clock_period - iss_clock_tick_period;
+    if (until <= time) return 0;
+    if (dmalooper->isBusy() || dmalooper->hasInput() || dmablock->isBusy()) return 0;
+
+    // the next event of the components: tick until right before it. The units are idle, the dmas
+    // idle or stalled on a line fill of the dcma (it counts their stall cycles: same clock)
+    static_assert(dma_clock_period == dcma_clock_period, "dcma counts the stalls per dma tick");
+    for (auto cluster : clusters) {
+        if (cluster->ticksToNextEvent() == 0) return 0;
+    }
+    auto limit = [&](uint64_t ticks, double domain_time, double period) {
+        // a lagging domain (edge due in the next tick) changes the state / counts immediately
+        if (ticks == 0 || domain_time <= time) return false;
+        if (ticks != UINT64_MAX)
+            until = std::min(until, domain_time + double(ticks) * period - iss_clock_tick_period);
+        return true;
+    };
+    if (!limit(dcma->ticksToNextEvent(), dcma_time, dcma_clock_period)) return 0;
+#ifdef ISS_STANDALONE
+    auto mem = reinterpret_cast<NonBlockingMainMemory*>(bus);
+    if (!limit(mem->ticksToNextEvent(), axi_time, axi_clock_period)) return 0;
+#endif
+    if (until <= time) return 0;
+
+    // the edges before only tick the (idle) dma looper / block extractor and count cycles
+    uint64_t risc_ticks = skipClockEdges(risc_time, risc_clock_period, time, until);
+    Statistics::get().skipTicks(Statistics::clock_domains::RISC, risc_ticks);
+    risc_counter_skip(risc_ticks);
+
+    for (auto cluster : clusters) {
+        cluster->skipTicks(until);
+    }
+    uint64_t dcma_ticks = skipClockEdges(dcma_time, dcma_clock_period, time, until);
+    Statistics::get().skipTicks(Statistics::clock_domains::DCMA, dcma_ticks);
+    dcma->skipTicks(dcma_ticks);
+
+#ifdef ISS_STANDALONE
+    uint64_t axi_ticks = skipClockEdges(axi_time, axi_clock_period, time, until);
+    mem->skipTicks(axi_ticks);
+    Statistics::get().skipTicks(Statistics::clock_domains::AXI, axi_ticks);
+#endif
+
+    time = until;
+    return uint32_t(risc_ticks);
+}
+
 // ---------------------------------------------------------------------------------
 // Run simulation environment (one clock tick)
 // ---------------------------------------------------------------------------------
@@ -834,7 +1178,7 @@ void ISS::clk_tick() {
 
 #ifndef ISS_STANDALONE  // done in run_until_rdy_for_cmd -> if Standalone
     while (risc_time < time) {
-        if (debug & DEBUG_TICK)
+        if (if_debug(DEBUG_TICK))
             printf("RISC Clock Cycle %.2lf (RISC Time: %.2lf ns)\n",
                 risc_time / risc_clock_period,
                 risc_time);
@@ -846,22 +1190,7 @@ void ISS::clk_tick() {
     }
 #endif
 
-    if (debug & DEBUG_GLOBAL_TICK) printf("Time: %.2lf\n", time);
-
-#ifdef THREAD_CLUSTER
-    if (VPRO_CFG::CLUSTERS >= 2 && VPRO_CFG::UNITS >= 2) {
-        for (auto cluster : clusters) {
-            cluster->tick_en.unlock();
-        }
-        for (auto cluster : clusters) {
-            cluster->tick_done.lock();
-        }
-    } else {
-        for (auto cluster : clusters) {
-            cluster->tick();
-        }
-    }
-#else
+    if (if_debug(DEBUG_GLOBAL_TICK)) printf("Time: %.2lf\n", time);
 
 #ifndef ISS_STANDALONE
     while (1) {
@@ -874,13 +1203,27 @@ void ISS::clk_tick() {
     }
 #endif
     // cascade to Lanes and DMAs
-    for (auto cluster : clusters) {
-        cluster->tick();
+    if (cluster_pool) {
+        // dma requests to the cluster ports + vpro domain are cluster local -> parallel
+        // transfers through the shared dcma -> sequential (in the pool)
+        if (clusters.front()->isDMAClockEdge()) {
+            cluster_pool->tickDMA();
+            Statistics::get().tick(Statistics::clock_domains::DMA);
+        }
+        if (clusters.front()->isVPROClockEdge()) {
+            cluster_pool->tickVPRO();
+            Statistics::get().tick(Statistics::clock_domains::VPRO);
+        }
+    } else {
+        for (auto cluster : clusters) {
+            cluster->tick();
+        }
     }
-#endif
+    // prefetcher observes the burst requests of this cycle in cluster order
+    dcma->commitRequests();
     // check if time for clock tick is up
     if (dcma_time <= time) {
-        if (debug & DEBUG_TICK)
+        if (if_debug(DEBUG_TICK))
             printf("DCMA Clock Cycle %.2lf (DCMA Time: %.2lf ns)\n",
                 dcma_time / dcma_clock_period,
                 dcma_time);
@@ -890,7 +1233,7 @@ void ISS::clk_tick() {
     }
 #ifdef ISS_STANDALONE
     if (axi_time <= time) {
-        if (debug & DEBUG_TICK)
+        if (if_debug(DEBUG_TICK))
             printf("AXI Clock Cycle %.2lf (AXI Time: %.2lf ns)\n",
                 axi_time / axi_clock_period,
                 axi_time);
@@ -944,7 +1287,6 @@ void ISS::dumpQ(int c, int u) {
 
 void ISS::dumpRF(int c, int u, int l) {
     this->clusters[c]->dumpRegisterFile(u, l);
-    QVector<bool> flag(2);
     int cc = 0, cu = 0, cl = 0;
     for (auto cluster : clusters) {
         cu = 0;
@@ -952,12 +1294,7 @@ void ISS::dumpRF(int c, int u, int l) {
             cl = 0;
             for (auto lane : unit->getLanes()) {
                 if (cl == l && cc == c && cu == u) {
-                    uint8_t* regist = lane->getregister();
-
-                    flag[0] = lane->getzeroflag();
-                    flag[1] = lane->getnegativeflag();
-
-                    emit sendRegister(regist, flag);
+                    emit sendRegister(lane->getregister());
                     break;
                 }
                 cl++;
@@ -983,7 +1320,7 @@ void ISS::visualizeDataUpdate() {
     for (auto cluster : clusters) {
         for (auto unit : cluster->getUnits()) {
             for (auto lane : unit->getLanes()) {
-                data.commands.push_back(std::make_shared<CommandVPRO>(lane->getCmd().get()));
+                data.commands.push_back(std::make_shared<CommandVPRO>(lane->getCmd()));
             }
         }
     }
@@ -1017,25 +1354,124 @@ void ISS::printExitStats(bool silent) {
             "    -> dcma_flush();\n\n");
         printf_info("Generating Statistic Report...\n");
         Statistics::get().print();
+
+        if (sim_wall_timer.isValid() && sim_wall_timer.elapsed() > 0) {
+            double seconds = double(sim_wall_timer.elapsed()) / 1000.;
+            printf_info("Simulation speed: %.0lf VPRO cycles/s (%.2lf s, %s build)\n",
+                time / getVPROClockPeriod() / seconds,
+                seconds,
+                INSTRUMENTED_BUILD ? "instrumented" : "release");
+        }
+
+        uint64_t functional_vpro_cycles = 0, functional_dma_cycles = 0;
+        for (auto cluster : clusters) {
+            functional_vpro_cycles = std::max(functional_vpro_cycles, cluster->functional_vpro_cycles);
+            functional_dma_cycles = std::max(functional_dma_cycles, cluster->functional_dma_cycles);
+        }
+        if (functional_vpro_cycles > 0 || functional_dma_cycles > 0) {
+            printf_info("Functional mode estimate (max. of clusters, not overlapped):\n");
+            printf_info("  VPRO: %lu cycles (one element per cycle)\n", functional_vpro_cycles);
+            printf_info("  DMA:  %lu cycles (ideal DCMA, every access a hit)\n", functional_dma_cycles);
+        }
     }
 
     // dump to file
-    QFileInfo stat_file(QDir::currentPath() + "/" + dumpFileName);
+    QFileInfo stat_file(QDir::currentPath() + "/" + dumpFileName());
     if (!QDir(stat_file.absoluteDir().path()).exists()) {
         QDir(stat_file.absoluteDir().path()).mkpath(".");
         printf("Created new dir for stats: %s\n",
             stat_file.absoluteDir().path().toStdString().c_str());
     }
-    Statistics::get().dumpToFile(dumpFileName);
-    Statistics::get().dumpToJSONFile(dumpJSONFileName);
+    Statistics::get().dumpToFile(dumpFileName());
+    Statistics::get().dumpToJSONFile(dumpJSONFileName());
 
-    // output cfg
-    QFile file(outputcfg);
+    dumpMemoryConfig(outputcfg);
+
+    printf_info("# Calling exit Script '%s' ... ", exitscript.toStdString().c_str());
+    std::ifstream exit_script(exitscript.toStdString().c_str());
+    if (!exit_script) {
+        printf_warning("[File '%s' not found!]\n", exitscript.toStdString().c_str());
+    } else {
+        int status = system(QString("bash ").append(exitscript).toStdString().c_str());
+        if (status != 0) printf("[executed, returned %i]\n", status);
+    }
+    exit_script.close();
+}
+
+void ISS::loadMemoryConfig(
+    const QString& cfg_file, const QString& path_prefix, const QString& path_replace) {
+    QFile configfile(cfg_file);
+    configfile.open(QIODevice::ReadOnly);
+    while (!configfile.atEnd()) {
+        // line format: filename address [size [skip_pos, skip_len]*]
+        QString line = configfile.readLine();
+        line = line.simplified();
+        if (line.startsWith(";") or line.startsWith("#") or line.isEmpty()) continue;
+        auto input_items = line.split(" ");
+        if (input_items.size() < 2) {
+            printf_warning("Input file not containing enough items [Required: File, Address]\n");
+            continue;
+        }
+        QString input_file = input_items[0];
+        if (!path_prefix.isEmpty()) {
+            if (!input_file.startsWith(path_prefix)) continue;
+            input_file.replace(0, path_prefix.size(), path_replace);
+        }
+        uint64_t address = input_items[1].toULong(nullptr, 0);
+        int64_t size = -1;
+        if (input_items.size() > 2) {
+            size = input_items[2].toLong(nullptr, 0);
+        }
+        // insert gaps during load to MM: skip_len bytes every skip_pos bytes
+        QVector<int64_t> skip_pos;
+        QVector<int64_t> skip_len;
+        for (int si = 3; si + 1 < input_items.size(); si += 2) {
+            skip_pos.append(input_items[si].toLong(nullptr, 0));
+            skip_len.append(input_items[si + 1].toLong(nullptr, 0));
+        }
+        QFile input(input_file);
+        if (!input.open(QIODevice::ReadOnly)) {
+            printf_warning(
+                "Input could not be opened! [File: %s]\n", input_file.toStdString().c_str());
+            continue;
+        }
+        // mapped file content is copied in gap-free runs into the MM
+        uint64_t input_size = input.size();
+        if (size > 0) input_size = std::min(input_size, uint64_t(size));
+        const uchar* input_data =
+            (!input.isSequential() && input_size > 0) ? input.map(0, qint64(input_size)) : nullptr;
+        QByteArray input_buffer;
+        if (input_data == nullptr) {
+            // not mappable: pipes / sequential devices, or files reporting size 0 (e.g. /proc) -> read up to EOF
+            input_buffer = (input.isSequential() || input.size() == 0) ? input.readAll()
+                                                                         : input.read(qint64(input_size));
+            input_size = input_buffer.size();
+            if (size > 0) input_size = std::min(input_size, uint64_t(size));
+            input_data = reinterpret_cast<const uchar*>(input_buffer.constData());
+        }
+        forEachSkipRun(address,
+            input_size,
+            skip_pos,
+            skip_len,
+            [&](uint64_t offset, uint64_t mm_addr, uint64_t length) {
+                bus->dbgWriteBlock(intptr_t(mm_addr), input_data + offset, length);
+            });
+        if (if_debug(DEBUG_DUMP_FLAGS))
+            printf_info("\tFile %s was read to MM [%u (Dez) / 0x%x (Hex)]\t Size: %i\n",
+                input_file.toStdString().c_str(),
+                address,
+                address,
+                int(input_size));
+    }
+}
+
+void ISS::dumpMemoryConfig(
+    const QString& cfg_file, const QString& path_prefix, const QString& path_replace) {
+    QFile file(cfg_file);
     if (!file.open(QIODevice::ReadOnly)) {
         printf_warning("Could not open %s: %s\n",
-            outputcfg.toStdString().c_str(),
+            cfg_file.toStdString().c_str(),
             file.errorString().toStdString().c_str());
-    } else {
     }
     QTextStream in(&file);
 
@@ -1052,6 +1488,10 @@ void ISS::printExitStats(bool silent) {
             continue;
         }
         output = fields[0].replace("<EXE>", ExeName);
+        if (!path_prefix.isEmpty()) {
+            if (!output.startsWith(path_prefix)) continue;
+            output.replace(0, path_prefix.size(), path_replace);
+        }
         offset = fields[1].toULong(nullptr, 0);
         size = fields[2].toULong(nullptr, 0);
         // skip MM during dump: skip_len bytes every skip_pos bytes
@@ -1068,19 +1508,23 @@ void ISS::printExitStats(bool silent) {
                 size);
 
         QFile outputfile(output);
-        uint64_t mm_addr = offset;
         if (outputfile.open(QFile::WriteOnly | QFile::Truncate)) {
-            for (int i = 0; i < size; i++) {
-                uint8_t buffer;
-                bus->dbgRead(mm_addr, &buffer);
-                outputfile.write((char*)&buffer, sizeof(buffer));
-                mm_addr++;
-                for (int si = 0; si < skip_pos.size(); si++) {
-                    if ((i + 1) % skip_pos[si] == 0) {
-                        mm_addr += skip_len[si];
+            // runs between the skip points are read in large chunks
+            constexpr uint64_t chunk_size = 4 * 1024 * 1024;
+            std::vector<uint8_t> buffer(std::min(size, chunk_size));
+            forEachSkipRun(offset,
+                size,
+                skip_pos,
+                skip_len,
+                [&](uint64_t, uint64_t mm_addr, uint64_t length) {
+                    while (length > 0) {
+                        auto chunk = std::min(length, chunk_size);
+                        bus->dbgReadBlock(intptr_t(mm_addr), buffer.data(), chunk);
+                        outputfile.write((char*)buffer.data(), qint64(chunk));
+                        mm_addr += chunk;
+                        length -= chunk;
                     }
-                }
-            }
+                });
             outputfile.close();
         } else {
             printf_error("Error opening output file!");
@@ -1089,27 +1533,13 @@ void ISS::printExitStats(bool silent) {
     }
 
     file.close();
-
-    printf_info("# Calling exit Script '%s' ... ", exitscript.toStdString().c_str());
-    std::ifstream exit_script(exitscript.toStdString().c_str());
-    if (!exit_script) {
-        printf_warning("[File '%s' not found!]\n", exitscript.toStdString().c_str());
-    } else {
-        int status = system(QString("bash ").append(exitscript).toStdString().c_str());
-        if (status != 0) printf("[executed, returned %i]\n", status);
-    }
-    exit_script.close();
 }
 
 void ISS::dbgMemWrite(intptr_t mm_dst_addr, uint8_t* data_ptr, size_t size) {
-    for (int i = 0; i < size; ++i) {
-        // uses little endianess -> lsb -> 'low address, msb -> 'high address
-        bus->dbgWrite(mm_dst_addr+i, data_ptr+i);
-    }
+    // uses little endianess -> lsb -> 'low address, msb -> 'high address
+    bus->dbgWriteBlock(mm_dst_addr, data_ptr, size);
 }
 
 void ISS::dbgMemRead(intptr_t mm_src_addr, uint8_t* data_ptr, size_t size) const {
-    for (int i = 0; i < size; ++i) {
-        bus->dbgRead(mm_src_addr+i, data_ptr+i);
-    }
+    bus->dbgReadBlock(mm_src_addr, data_ptr, size);
 }
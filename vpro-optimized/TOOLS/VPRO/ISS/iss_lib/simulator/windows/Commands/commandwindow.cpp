@@ -86,6 +86,10 @@ CommandWindow::CommandWindow(int clusters, int units, int lanes, QWidget* parent
         if (option_text != "end") {
             QCheckBox* optionbox = new QCheckBox;
             optionbox->setText(option_text);
+            if (!(DEBUG_COMPILED & option)) {  // per cycle option of a not instrumented build
+                optionbox->setEnabled(false);
+                optionbox->setToolTip("not compiled in (see INSTRUMENTED_BUILD)");
+            }
             connect(optionbox,
                 QOverload<bool>::of(&QCheckBox::clicked),
                 [optionbox, option](bool checked) {
@@ -353,7 +357,7 @@ void CommandWindow::setLocalMemory(int unit, uint8_t* ref, int c) {
     lmviews[cluster_cnt - c - 1]->selectLocalMemory(0);
 }
 
-void CommandWindow::setRegisterMemory(int lane, uint8_t* ref, int c, int u) {
+void CommandWindow::setRegisterMemory(int lane, uint32_t* ref, int c, int u) {
     rfviews[c][u]->setRegisterFile(lane, ref);
     rfviews[c][u]->selectRegisterFile(0);
 }
@@ -99,7 +99,7 @@ class CommandWindow : public QMainWindow {
     void getmainmemory(uint8_t*);
     void on_pauseButton_clicked();
     void setLocalMemory(int unit, uint8_t*, int c);
-    void setRegisterMemory(int lane, uint8_t* ref, int c, int u);
+    void setRegisterMemory(int lane, uint32_t* ref, int c, int u);
     void recieveguiwaitpress(bool*);
     void simIsFinished();
     void setVproSpecialRegisters(VproSpecialRegister regs);
@@ -11,7 +11,7 @@ RfTableView::RfTableView(QWidget* parent) : QTableView(parent), COLW(75) {
 
 RfTableView::~RfTableView() {}
 
-void RfTableView::setRegisterFile(int lane, uint8_t* ref) {
+void RfTableView::setRegisterFile(int lane, uint32_t* ref) {
     while (rf_ref.size() <= lane) {
         //        qWarning() << "[GUI.TableView] got new units reference... unit " << lane << ". Adding elements to ref vector...";
         rf_ref.append(nullptr);
@@ -49,7 +49,7 @@ Qt::ItemFlags RfTableModel::flags(const QModelIndex& index) const {
     return Qt::ItemIsEditable | QAbstractTableModel::flags(index);
 }
 
-void RfTableModel::setRegisterFile(uint8_t* ref) {
+void RfTableModel::setRegisterFile(uint32_t* ref) {
     this->rf = ref;
     this->gotRfRef = true;
     emit dataChanged(QModelIndex(), QModelIndex());
@@ -75,9 +75,7 @@ QVariant RfTableModel::data(const QModelIndex& index, int role) const {
         case Qt::DisplayRole:  // show data text
             if (!gotRfRef) return QString("No Ref");
 
-            data2 = ((uint32_t)(rf[3 * (row * COLS + col)]) +
-                     (uint32_t)(rf[3 * (row * COLS + col) + 1] << 8) +
-                     (uint32_t)(rf[3 * (row * COLS + col) + 2] << 16));
+            data2 = rf[row * COLS + col] & 0x00ffffffu;  // without flags
             if ((uint32_t(data2 >> 23u) & 1) == 1) data2 |= 0xFF000000;
             if (basevalue == 2 and data2 != 0) {
                 return QString::number(int(data2), basevalue).rightJustified(24, '0').right(24);
@@ -117,9 +115,8 @@ bool RfTableModel::setData(const QModelIndex& index, const QVariant& value, int
 
         int val = value.toInt();
 
-        rf[3 * (row * COLS + col) + 2] = uint8_t((val >> 16) & 0xff);
-        rf[3 * (row * COLS + col) + 1] = uint8_t((val >> 8) & 0xff);
-        rf[3 * (row * COLS + col)] = uint8_t(val & 0xff);
+        // keeps the flags, entry becomes initialized
+        rf[row * COLS + col] = (rf[row * COLS + col] & 0x03000000u) | (uint32_t(val) & 0x00ffffffu);
 
         emit editCompleted(value.toString());
         emit dataChanged(index, index);
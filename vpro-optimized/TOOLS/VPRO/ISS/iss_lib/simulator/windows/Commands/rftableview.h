@@ -25,13 +25,13 @@ class RfTableModel : public QAbstractTableModel {
         int role = Qt::EditRole) override;  // for editing
     int basevalue = 10;
     int* base = &basevalue;
-    void setRegisterFile(uint8_t* ref);
+    void setRegisterFile(uint32_t* ref);  // packed rf entries (see RegisterFile::Register)
 
     static const int COLS = 4;
     static const int ROWS = 1024 / COLS;
 
    private:
-    uint8_t* rf;
+    uint32_t* rf;
     bool gotRfRef;
     //    QString m_gridData[ROWS][COLS];  //holds text entered into QTableView
 
@@ -52,11 +52,11 @@ class RfTableView : public QTableView {
     int COLW;
 
    public slots:
-    void setRegisterFile(int lane, uint8_t* ref);
+    void setRegisterFile(int lane, uint32_t* ref);
     void selectRegisterFile(int lane);
 
    private:
-    QVector<uint8_t*> rf_ref;
+    QVector<uint32_t*> rf_ref;
     int lane;
 };
 
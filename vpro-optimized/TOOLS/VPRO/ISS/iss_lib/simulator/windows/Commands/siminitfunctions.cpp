@@ -193,6 +193,10 @@ void createdebugoptions(QWidget* parent) {
         if (option_text != "end") {
             QCheckBox* optionbox = new QCheckBox;
             optionbox->setText(option_text);
+            if (!(DEBUG_COMPILED & option)) {  // per cycle option of a not instrumented build
+                optionbox->setEnabled(false);
+                optionbox->setToolTip("not compiled in (see INSTRUMENTED_BUILD)");
+            }
             QObject::connect(optionbox,
                 QOverload<bool>::of(&QCheckBox::clicked),
                 [optionbox, option](bool checked) {
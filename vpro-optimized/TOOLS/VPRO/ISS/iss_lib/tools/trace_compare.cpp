@@ -0,0 +1,386 @@
+// ########################################################
+// # VPRO instruction & system simulation library         #
+// ########################################################
+// # trace_compare: first divergence of the RF / LM       #
+// # writes of ISS (sim.trace) and RTL simulation         #
+// ########################################################
+
+#include <dirent.h>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "../simulator/helper/trace.h"
+
+/**
+ * RTL traces (CORES/VPRO, one text file per RF / LM in the simulation dir):
+ *   C<c>U<u>L<l>.trace   "RF[<addr>] <previous data> > <data> @ <time>"     (rf_generate_write_traces_c)
+ *   C<c>U<u>LM.trace     "LM[<addr>] > <data> @ <time>"                     (lm_generate_write_traces_c)
+ * ISS: RF_WRITE / LM_WRITE records of the binary trace (GENERATE_RF_TRACE / GENERATE_LM_TRACE, build
+ *   option ISS_TRACE=RF,LM).
+ *
+ * Both sides are streamed: the ISS trace chunk by chunk (merged by time over the writer threads),
+ * the RTL files line by line on demand. Per RF / LM, the writes of both sides are matched in order
+ * (address + data). Writes may be reordered up to --window writes (e.g. DMA vs. lane writes to the
+ * LM); a write without a match within this window is a divergence.
+ */
+
+struct Write {
+    double time;  // ns, < 0: unknown (RTL trace without time)
+    uint32_t addr;
+    uint64_t data;  // NO_DATA: not parsable (X / U in RTL)
+    uint64_t previous;
+    uint64_t n;  // number of the write in this RF / LM
+};
+
+constexpr uint64_t NO_DATA = ~uint64_t(0);
+
+/**
+ * RF or LM of one unit. Writes without a match yet of ISS and RTL
+ */
+struct Memory {
+    std::string name;
+    std::string rtl_file_name;
+    FILE* rtl_file{nullptr};
+    bool rtl_opened{false}, rtl_eof{false};
+    uint64_t rtl_lines{0}, iss_writes{0}, matched{0};
+    std::deque<Write> iss, rtl;
+};
+
+struct Options {
+    std::string rtl_dir = ".";
+    size_t window = 0;
+    double vpro_clock = 0;  // ns, 0: print time only
+    int max_errors = 1;
+    bool rf = true, lm = false;
+};
+
+static void usage(const char* name) {
+    printf(
+        "Usage: %s <ISS trace file> [options]\n"
+        "  --rtl=<dir>          dir of the RTL traces (C0U0L0.trace, C0U0LM.trace, ...) [.]\n"
+        "  --window=<n>         tolerated reordering of writes per RF / LM [0]\n"
+        "  --vpro-clock=<ns>    clock period, to print cycles\n"
+        "  --lm                 compare local memory writes as well\n"
+        "  --lm-only            compare local memory writes only\n"
+        "  --max-errors=<n>     stop after n divergences [1]\n"
+        "Exit code: 0 equal, 1 divergence, 2 error\n",
+        name);
+}
+
+static bool parseHex(const char* s, uint64_t& value) {
+    char* end;
+    uint64_t v = strtoull(s, &end, 16);
+    if (end == s || (*end != '\0' && *end != ' ' && *end != '\n')) return false;
+    value = v;
+    return true;
+}
+
+/**
+ * "RF[12] 00000A > 00000B @ 1250 ns" / "LM[12] > 000B @ 1250 ns"
+ */
+static bool parseLine(const char* line, Write& w) {
+    const char* p = strchr(line, '[');
+    if (p == nullptr) return false;
+    w.addr = uint32_t(strtoul(p + 1, nullptr, 10));
+    p = strchr(p, ']');
+    const char* gt = p ? strchr(p, '>') : nullptr;
+    if (gt == nullptr) return false;
+
+    w.previous = NO_DATA;
+    while (*++p == ' ') {}
+    if (p != gt) parseHex(p, w.previous);
+    if (!parseHex(gt + 2, w.data)) w.data = NO_DATA;
+
+    w.time = -1;
+    const char* at = strchr(gt, '@');
+    if (at != nullptr) {
+        char unit[8] = "";
+        double t;
+        if (sscanf(at + 1, "%lf %7s", &t, unit) >= 1) {
+            static const std::map<std::string, double> scale = {
+                {"fs", 1e-6}, {"ps", 1e-3}, {"ns", 1}, {"us", 1e3}, {"ms", 1e6}, {"sec", 1e9}};
+            auto s = scale.find(unit);
+            w.time = t * (s == scale.end() ? 1 : s->second);
+        }
+    }
+    return true;
+}
+
+/**
+ * next write of the RTL side into m.rtl. false if none left
+ */
+static bool readRtl(Memory& m, const Options& o) {
+    if (!m.rtl_opened) {
+        m.rtl_opened = true;
+        m.rtl_file = fopen((o.rtl_dir + "/" + m.rtl_file_name).c_str(), "r");
+        if (m.rtl_file == nullptr) {
+            printf("# %s: no RTL trace (%s/%s)\n", m.name.c_str(), o.rtl_dir.c_str(),
+                m.rtl_file_name.c_str());
+            m.rtl_eof = true;
+        }
+    }
+    char line[256];
+    while (!m.rtl_eof) {
+        if (fgets(line, sizeof(line), m.rtl_file) == nullptr) {
+            m.rtl_eof = true;
+            break;
+        }
+        Write w{};
+        if (!parseLine(line, w)) continue;
+        w.n = m.rtl_lines++;
+        m.rtl.push_back(w);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * removes the matching writes of both sides (first match in order)
+ */
+static void match(Memory& m) {
+    for (auto r = m.rtl.begin(); r != m.rtl.end();) {
+        auto i = m.iss.begin();
+        while (i != m.iss.end() && (i->addr != r->addr || i->data != r->data)) ++i;
+        if (i != m.iss.end()) {
+            m.iss.erase(i);
+            r = m.rtl.erase(r);
+            m.matched++;
+        } else {
+            ++r;
+        }
+    }
+}
+
+static void printTime(double time, const Options& o) {
+    if (time < 0) {
+        printf("time ?");
+    } else if (o.vpro_clock > 0) {
+        printf("cycle %.0lf (%.2lf ns)", std::floor(time / o.vpro_clock), time);
+    } else {
+        printf("%.2lf ns", time);
+    }
+}
+
+static void printWrite(const char* side, const Memory& m, const Write* w, const Options& o) {
+    printf("  %-4s ", side);
+    if (w == nullptr) {
+        printf("-\n");
+        return;
+    }
+    printf("write #%" PRIu64 " at ", w->n);
+    printTime(w->time, o);
+    printf(": %s[%u] = ", m.name.c_str(), w->addr);
+    if (w->data == NO_DATA)
+        printf("(invalid)");
+    else
+        printf("%06" PRIX64, w->data);
+    if (w->previous != NO_DATA && w->previous != Trace::UNINITIALIZED)
+        printf(" (was %06" PRIX64 ")", w->previous);
+    printf("\n");
+}
+
+/**
+ * the oldest unmatched write of a side is followed by more than window writes (or too many unmatched)
+ */
+static bool diverged(const Memory& m, const Options& o) {
+    return m.iss.size() > o.window || m.rtl.size() > o.window ||
+           (!m.iss.empty() && m.iss_writes - m.iss.front().n > o.window + 1) ||
+           (!m.rtl.empty() && m.rtl_lines - m.rtl.front().n > o.window + 1);
+}
+
+/**
+ * reports the oldest unmatched write of m (+ the write of the other side at its position)
+ */
+static void report(Memory& m, const Options& o) {
+    const Write* iss = m.iss.empty() ? nullptr : &m.iss.front();
+    const Write* rtl = m.rtl.empty() ? nullptr : &m.rtl.front();
+    printf("DIVERGENCE %s at", m.name.c_str());
+    if (iss != nullptr) {
+        printf(" ISS ");
+        printTime(iss->time, o);
+    }
+    if (rtl != nullptr) {
+        printf(" RTL ");
+        printTime(rtl->time, o);
+    }
+    printf(" (%" PRIu64 " writes equal)\n", m.matched);
+    printWrite("ISS", m, iss, o);
+    printWrite("RTL", m, rtl, o);
+
+    // drop the reported writes, to continue with the next divergence
+    if (iss != nullptr) m.iss.pop_front();
+    if (rtl != nullptr) m.rtl.pop_front();
+}
+
+/**
+ * writes of the ISS trace, merged by time over the streams (writer threads)
+ */
+class IssStream {
+   public:
+    explicit IssStream(Trace::Reader& reader) : reader(reader) {
+        const auto& chunks = reader.chunks();
+        for (size_t i = 0; i < chunks.size(); i++) {
+            uint32_t s = chunks[i].chunk.stream;
+            if (s >= streams.size()) streams.resize(s + 1);
+            streams[s].chunks.push_back(i);
+        }
+    }
+
+    /**
+     * @return next record or nullptr at the end (or on a read error, see failed)
+     */
+    const Trace::Record* next() {
+        Cursor* first = nullptr;
+        for (auto& s : streams) {
+            if (!fill(s)) continue;
+            if (first == nullptr || s.records[s.pos].time < first->records[first->pos].time)
+                first = &s;
+        }
+        if (first == nullptr) return nullptr;
+        return &first->records[first->pos++];
+    }
+
+    bool failed{false};
+
+   private:
+    struct Cursor {
+        std::vector<size_t> chunks;
+        size_t next_chunk{0};
+        std::vector<Trace::Record> records;
+        size_t pos{0};
+    };
+
+    bool fill(Cursor& c) {
+        while (c.pos >= c.records.size()) {
+            if (c.next_chunk >= c.chunks.size()) return false;
+            if (!reader.readChunk(c.chunks[c.next_chunk++], c.records)) {
+                failed = true;
+                c.records.clear();
+                c.next_chunk = c.chunks.size();
+                return false;
+            }
+            c.pos = 0;
+        }
+        return true;
+    }
+
+    Trace::Reader& reader;
+    std::vector<Cursor> streams;
+};
+
+typedef std::map<std::tuple<uint8_t, uint8_t, uint8_t, uint8_t>, Memory> Memories;
+
+static Memory& memory(Memories& memories, uint8_t type, uint8_t cluster, uint8_t unit, uint8_t lane) {
+    auto& m = memories[{type, cluster, unit, lane}];
+    if (m.name.empty()) {
+        char name[32];
+        if (type == Trace::RF_WRITE)
+            snprintf(name, sizeof(name), "C%uU%uL%u", cluster, unit, lane);
+        else
+            snprintf(name, sizeof(name), "C%uU%uLM", cluster, unit);
+        m.name = name;
+        m.rtl_file_name = m.name + ".trace";
+    }
+    return m;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    Options o;
+    for (int i = 2; i < argc; i++) {
+        std::string arg(argv[i]);
+        auto value = arg.substr(arg.find('=') + 1);
+        if (arg.rfind("--rtl=", 0) == 0) {
+            o.rtl_dir = value;
+        } else if (arg.rfind("--window=", 0) == 0) {
+            o.window = std::strtoul(value.c_str(), nullptr, 10);
+        } else if (arg.rfind("--vpro-clock=", 0) == 0) {
+            o.vpro_clock = std::strtod(value.c_str(), nullptr);
+        } else if (arg.rfind("--max-errors=", 0) == 0) {
+            o.max_errors = std::atoi(value.c_str());
+        } else if (arg == "--lm") {
+            o.lm = true;
+        } else if (arg == "--lm-only") {
+            o.lm = true;
+            o.rf = false;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    Trace::Reader reader;
+    if (!reader.open(argv[1])) return 2;
+    IssStream iss(reader);
+
+    Memories memories;  // key: type, cluster, unit, lane
+    int errors = 0;
+
+    const Trace::Record* r;
+    while (errors < o.max_errors && (r = iss.next()) != nullptr) {
+        if (!((r->type == Trace::RF_WRITE && o.rf) || (r->type == Trace::LM_WRITE && o.lm)))
+            continue;
+
+        auto& m = memory(memories, r->type, r->cluster, r->unit, r->lane);
+
+        m.iss.push_back({r->time, r->id, r->value, r->addr, m.iss_writes++});
+        readRtl(m, o);  // same number of writes on both sides (if equal)
+        match(m);
+        while (errors < o.max_errors && diverged(m, o)) {
+            report(m, o);
+            errors++;
+        }
+    }
+    if (iss.failed) return 2;
+
+    // RF / LM written in the RTL simulation only
+    if (DIR* dir = opendir(o.rtl_dir.c_str())) {
+        while (dirent* entry = readdir(dir)) {
+            unsigned c, u, l;
+            char end[8];
+            if (o.rf && sscanf(entry->d_name, "C%uU%uL%u%7s", &c, &u, &l, end) == 4 &&
+                strcmp(end, ".trace") == 0)
+                memory(memories, Trace::RF_WRITE, c, u, l);
+            if (o.lm && sscanf(entry->d_name, "C%uU%uLM%7s", &c, &u, end) == 3 &&
+                strcmp(end, ".trace") == 0)
+                memory(memories, Trace::LM_WRITE, c, u, Trace::NONE);
+        }
+        closedir(dir);
+    }
+
+    // remaining RTL writes + unmatched writes of the window
+    for (auto& [key, m] : memories) {
+        while (errors < o.max_errors && readRtl(m, o)) {
+            match(m);
+            while (errors < o.max_errors && diverged(m, o)) {
+                report(m, o);
+                errors++;
+            }
+        }
+        match(m);
+        while (errors < o.max_errors && (!m.iss.empty() || !m.rtl.empty())) {
+            report(m, o);
+            errors++;
+        }
+    }
+
+    uint64_t matched = 0;
+    for (auto& [key, m] : memories) {
+        matched += m.matched;
+        if (m.rtl_file != nullptr) fclose(m.rtl_file);
+    }
+    if (errors == 0) {
+        printf("EQUAL: %" PRIu64 " writes of %zu RF / LM\n", matched, memories.size());
+        return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,157 @@
+// ########################################################
+// # VPRO instruction & system simulation library         #
+// ########################################################
+// # trace_dump: prints a binary ISS trace (see trace.h)  #
+// ########################################################
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "../simulator/helper/trace.h"
+
+static void usage(const char* name) {
+    printf(
+        "Usage: %s <trace file> [options]\n"
+        "  --index          print the chunk index only\n"
+        "  --from=<ns>      first record (simulation time)\n"
+        "  --to=<ns>        last record (simulation time)\n"
+        "  --type=<TYPE>    only records of this type (e.g. RF_WRITE, DMA_BURST_READ, MM_WRITE)\n"
+        "  --cluster=<id>   only records of this cluster\n"
+        "Output: time,type,cluster,unit,lane,<type specific fields>\n",
+        name);
+}
+
+static void printSource(uint8_t v) {
+    if (v == Trace::NONE)
+        printf(",-");
+    else
+        printf(",%u", v);
+}
+
+static void printRecord(const Trace::Record& r) {
+    printf("%.2lf,%s", r.time, Trace::typeName(r.type));
+    printSource(r.cluster);
+    printSource(r.unit);
+    printSource(r.lane);
+    switch (r.type) {
+        case Trace::RF_WRITE:
+            if (r.addr == Trace::UNINITIALIZED)
+                printf(",RF[%u] uuuuuu > %06" PRIX64 "\n", r.id, r.value);
+            else
+                printf(",RF[%u] %06" PRIX64 " > %06" PRIX64 "\n", r.id, r.addr, r.value);
+            break;
+        case Trace::DMA_CMD_READ:
+        case Trace::DMA_CMD_WRITE:
+            printf(",id %u,ext 0x%08" PRIx64 ",loc %" PRIu64 "\n", r.id, r.addr, r.value);
+            break;
+        case Trace::DMA_BURST_READ:
+        case Trace::DMA_BURST_WRITE:
+            printf(",id %u,ext 0x%08" PRIx64 ",%" PRIu64 " bytes\n", r.id, r.addr, r.value);
+            break;
+        case Trace::DMA_SYNC:
+            printf(",cluster mask 0x%" PRIx64 "\n", r.value);
+            break;
+        case Trace::MM_READ:
+        case Trace::MM_WRITE:
+            printf(",initiator %u,addr 0x%08" PRIx64 ",burst %" PRIu64 "\n", r.id, r.addr, r.value);
+            break;
+        case Trace::VPRO_CMD:
+            printf(
+                ",func %u,id %u,bl %u,ch %u,flag %u,DST 0x%08x,SRC1 0x%08x,SRC2 0x%08x,"
+                "xE %u,yE %u,zE %u\n",
+                r.id & 0xffff,
+                (r.id >> 16) & 0xff,
+                (r.id >> 24) & 1,
+                (r.id >> 25) & 1,
+                (r.id >> 26) & 1,
+                uint32_t(r.addr),
+                uint32_t(r.addr >> 32),
+                uint32_t(r.value),
+                uint32_t(r.value >> 32) & 0x3ff,
+                uint32_t(r.value >> 42) & 0x3ff,
+                uint32_t(r.value >> 52) & 0x3ff);
+            break;
+        case Trace::LM_WRITE:
+            printf(",LM[%u] > %04" PRIX64 "\n", r.id, r.value);
+            break;
+        default:
+            printf(",%u,%" PRIu64 ",%" PRIu64 "\n", r.id, r.addr, r.value);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    bool index_only = false;
+    double from = 0, to = -1;
+    int type = -1, cluster = -1;
+    for (int i = 2; i < argc; i++) {
+        std::string arg(argv[i]);
+        auto value = arg.substr(arg.find('=') + 1);
+        if (arg == "--index") {
+            index_only = true;
+        } else if (arg.rfind("--from=", 0) == 0) {
+            from = std::strtod(value.c_str(), nullptr);
+        } else if (arg.rfind("--to=", 0) == 0) {
+            to = std::strtod(value.c_str(), nullptr);
+        } else if (arg.rfind("--cluster=", 0) == 0) {
+            cluster = std::atoi(value.c_str());
+        } else if (arg.rfind("--type=", 0) == 0) {
+            for (int t = 1; t < Trace::end; t++) {
+                if (value == Trace::typeName(t)) type = t;
+            }
+            if (type < 0) {
+                printf("Unknown record type: %s\n", value.c_str());
+                return 1;
+            }
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    Trace::Reader reader;
+    if (!reader.open(argv[1])) return 1;
+
+    const auto& chunks = reader.chunks();
+    if (index_only) {
+        uint64_t records = 0, compressed = 0;
+        printf("chunk,offset,stream,records,compressed bytes,first time,last time\n");
+        for (size_t i = 0; i < chunks.size(); i++) {
+            const auto& c = chunks[i].chunk;
+            printf("%zu,%" PRIu64 ",%u,%u,%u,%.2lf,%.2lf\n",
+                i,
+                chunks[i].offset,
+                c.stream,
+                c.records,
+                c.compressed_size,
+                c.first_time,
+                c.last_time);
+            records += c.records;
+            compressed += c.compressed_size;
+        }
+        printf("# %" PRIu64 " records, %" PRIu64 " bytes compressed (%.1lf%% of %" PRIu64 ")\n",
+            records,
+            compressed,
+            records ? 100. * compressed / (records * sizeof(Trace::Record)) : 0.,
+            uint64_t(records * sizeof(Trace::Record)));
+        return 0;
+    }
+
+    std::vector<Trace::Record> records;
+    for (size_t i = reader.findChunk(from); i < chunks.size(); i++) {
+        if (to >= 0 && chunks[i].chunk.first_time > to) continue;  // other streams may follow
+        if (!reader.readChunk(i, records)) return 1;
+        for (const auto& r : records) {
+            if (r.time < from || (to >= 0 && r.time > to)) continue;
+            if (type >= 0 && r.type != type) continue;
+            if (cluster >= 0 && r.cluster != cluster) continue;
+            printRecord(r);
+        }
+    }
+    return 0;
+}